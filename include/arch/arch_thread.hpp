@@ -0,0 +1,80 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_ARCH_THREAD_H__
+#define __SQUADS_ARCH_THREAD_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+/// The core of a worker without affinity
+#define SQUADS_ARCH_THREAD_ANY_CORE     (-1)
+
+SQUADS_EXTERNC_BEGINN
+
+namespace squads {
+    namespace arch {
+
+        typedef void (*arch_thread_fn)(void* arg);
+
+        typedef struct thread_handle thread_handle_t;
+
+        /**
+         * Start a worker, that call fn(arg) once and then end.
+         * FreeRTOS tasks on the ESP32, pthreads when SQUADS_CONFIG_ARCH_PTHREAD is 1.
+         * @param core The core for the worker or SQUADS_ARCH_THREAD_ANY_CORE
+         * @param stack The stack size of the worker in bytes
+         * @return The handle of the worker or NULL on failure
+         */
+        thread_handle_t* arch_thread_start(arch_thread_fn fn, void* arg, int core, unsigned int stack);
+
+        /**
+         * Wait until the worker has ended and free the handle.
+         * @return 0 on success
+         */
+        int arch_thread_join(thread_handle_t* thread);
+
+        /**
+         * Get the number of cores, that can run workers
+         */
+        unsigned int arch_thread_cores();
+
+        typedef struct thread_signal thread_signal_t;
+
+        /**
+         * Create a signal, a binary semaphore for waking a worker.
+         * @return The signal or NULL on failure
+         */
+        thread_signal_t* arch_signal_create();
+
+        /**
+         * Set the signal and wake the waiting thread.
+         */
+        void arch_signal_give(thread_signal_t* signal);
+
+        /**
+         * Wait until the signal is set and clear it.
+         */
+        void arch_signal_take(thread_signal_t* signal);
+
+        void arch_signal_destroy(thread_signal_t* signal);
+    }
+}
+
+SQUADS_EXTERNC_END
+
+#endif
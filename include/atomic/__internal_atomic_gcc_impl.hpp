@@ -89,31 +89,34 @@ namespace squads {
             value_type exchange (value_type v, memory_order order = memory_order::SeqCst)
                 { return __atomic_exchange_n (&__tValue, v, static_cast<int>(order)); }
 
-            bool compare_exchange_n (value_type& expected, value_type& desired, bool b,
+            /**
+             * @brief Compare and exchange, on failure expected is set to the current value.
+             * @param weak True for the weak version, that can fail spuriously.
+             */
+            bool compare_exchange_n (value_type& expected, value_type desired, bool weak,
                                     memory_order order = memory_order::SeqCst)
-                { return __atomic_compare_exchange_n (&__tValue, &expected, desired, b,
-                                                    order, static_cast<int>(order)); }
+                { return __atomic_compare_exchange_n (&__tValue, &expected, desired, weak,
+                                                    static_cast<int>(order), failure_order(order)); }
 
+            /**
+             * @brief Weak compare and exchange with a expected value, that is not updated.
+             */
             bool compare_exchange_t (value_type expected, value_type desired,
                                     memory_order order = memory_order::SeqCst)
-                { return compare_exchange_n (&expected, desired, true,
-                                            static_cast<int>(order)); }
+                { return compare_exchange_n (expected, desired, true, order); }
 
-            bool compare_exchange_f (value_type& expected, value_type& desired,
+            bool compare_exchange_f (value_type& expected, value_type desired,
                                     memory_order order = memory_order::SeqCst)
-                { return compare_exchange_n (&expected, desired, false,
-                                            static_cast<int>(order)); }
+                { return compare_exchange_n (expected, desired, false, order); }
 
 
-            bool compare_exchange_strong(value_type& expected, value_type& desired,
+            bool compare_exchange_strong(value_type& expected, value_type desired,
                                         memory_order order = memory_order::SeqCst)
-                { return _atomic_compare_exchange (&__tValue, &expected, &desired, 0,
-                                                order, static_cast<int>(order)); }
+                { return compare_exchange_n (expected, desired, false, order); }
 
-            bool compare_exchange_weak(value_type& expected, value_type& desired,
+            bool compare_exchange_weak(value_type& expected, value_type desired,
                                     memory_order order = memory_order::SeqCst)
-                { return _atomic_compare_exchange (&__tValue, &expected, &desired, 1,
-                                                order, static_cast<int>(order)); }
+                { return compare_exchange_n (expected, desired, true, order); }
 
             value_type fetch_add (value_type v, memory_order order = memory_order::SeqCst )
                 { return __atomic_fetch_add (&__tValue, v, static_cast<int>(order)); }
@@ -175,7 +178,28 @@ namespace squads {
             inline value_type operator  = (value_type v) volatile { store(v); return v; }
 
             volatile value_type __tValue;
+        private:
+            /// The order for a failed compare exchange, must not be a release order
+            static constexpr int failure_order(memory_order order) {
+                return (order == memory_order::Release) ? static_cast<int>(memory_order::Relaxed)
+                    : (order == memory_order::AcqRel) ? static_cast<int>(memory_order::Acquire)
+                    : static_cast<int>(order);
+            }
         };
+
+        /**
+         * @brief Memory fence between non-atomic and relaxed atomic accesses.
+         * @param order The memory order of the fence.
+         */
+        inline void atomic_thread_fence(memory_order order = memory_order::SeqCst) noexcept
+            { __atomic_thread_fence(static_cast<int>(order)); }
+
+        /**
+         * @brief Compiler only fence, between a task and a ISR on the same core.
+         * @param order The memory order of the fence.
+         */
+        inline void atomic_signal_fence(memory_order order = memory_order::SeqCst) noexcept
+            { __atomic_signal_fence(static_cast<int>(order)); }
     }
 }
 
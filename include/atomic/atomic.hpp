@@ -361,7 +361,7 @@ namespace squads {
 
             using pointer = T*;
             using base_type = basic_atomic_impl<pointer, TTASK> ;
-            using self_type = _atomic_ptr<pointer, TTASK>;
+            using self_type = _atomic_ptr<T, TTASK>;
             using difference_type = squads::ptrdiff_t;
 
             _atomic_ptr() = default;
@@ -379,7 +379,7 @@ namespace squads {
         };
 
         template<typename T>
-        using atomic_ptr            = _atomic_ptr<T*>;
+        using atomic_ptr            = _atomic_ptr<T>;
 
         // Signad basic types
         using atomic_bool           = _atomic<bool>;
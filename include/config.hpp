@@ -100,6 +100,11 @@
 	#define SQUADS_CONFIG_BASIC_HASHMUL_VAL 2149645487U
 #endif // SQUADS_CONFIG_BASIC_HASHMUL_VAL
 
+#ifndef SQUADS_CONFIG_CACHE_LINE_SIZE
+	/// The size of a cache line, used to keep producer and consumer indices apart
+	#define SQUADS_CONFIG_CACHE_LINE_SIZE 64
+#endif // SQUADS_CONFIG_CACHE_LINE_SIZE
+
 //==================================
 // end basic config
 
@@ -230,6 +235,43 @@
 // end workqueue config
 
 
+// start parallel config
+//==================================
+#ifndef SQUADS_CONFIG_ARCH_PTHREAD
+    /**
+     * When 1 the workers of the parallel algorithms are pthreads, else tasks of the arch
+     * @note default: 0
+     */
+    #define SQUADS_CONFIG_ARCH_PTHREAD                  0
+#endif
+
+#ifndef SQUADS_CONFIG_PARALLEL_MAX_WORKERS
+    /**
+     * The maximal number of workers, the caller included, of a parallel algorithm
+     * @note default: 8
+     */
+    #define SQUADS_CONFIG_PARALLEL_MAX_WORKERS          8
+#endif
+
+#ifndef SQUADS_CONFIG_PARALLEL_THRESHOLD
+    /**
+     * Below this number of elements the parallel algorithms run serial
+     * @note default: 32768
+     */
+    #define SQUADS_CONFIG_PARALLEL_THRESHOLD            32768
+#endif
+
+#ifndef SQUADS_CONFIG_PARALLEL_STACKSIZE
+    /**
+     * Stack size for the workers of the parallel algorithms
+     * @note default: SQUADS_CONFIG_MINIMAL_STACK_SIZE
+     */
+    #define SQUADS_CONFIG_PARALLEL_STACKSIZE            SQUADS_CONFIG_MINIMAL_STACK_SIZE
+#endif
+//==================================
+// end parallel config
+
+
 
 #ifndef SQUADS_CONFIG_CSEMAPHORE_MIN_COUNT
     /**
@@ -336,6 +378,37 @@
 	#define SQUADS_CONFIG_HAS_BUILTIN 	SQUADS_CONFIG_NO
 #endif // defined
 
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	/// The target supports SSE2, used for the group probing in the hash containers
+	#define SQUADS_CONFIG_HAS_SSE2 		SQUADS_CONFIG_YES
+#else
+	#define SQUADS_CONFIG_HAS_SSE2 		SQUADS_CONFIG_NO
+#endif // defined
+
+#if defined(__ARM_NEON) || defined(__ARM_NEON__)
+	/// The target supports NEON, used for the group probing in the hash containers
+	#define SQUADS_CONFIG_HAS_NEON 		SQUADS_CONFIG_YES
+#else
+	#define SQUADS_CONFIG_HAS_NEON 		SQUADS_CONFIG_NO
+#endif // defined
+
+#if defined(__AVX2__)
+	/// The target supports AVX2, used for the simd algorithms
+	#define SQUADS_CONFIG_HAS_AVX2 		SQUADS_CONFIG_YES
+#else
+	#define SQUADS_CONFIG_HAS_AVX2 		SQUADS_CONFIG_NO
+#endif // defined
+
+#ifndef SQUADS_CONFIG_SIMD_DISPATCH
+	#if (defined(__x86_64__) || defined(__i386__)) && defined(__GNUC__) && SQUADS_CONFIG_HAS_AVX2 == SQUADS_CONFIG_NO \
+		&& SQUADS_CONFIG_HAS_SSE2 == SQUADS_CONFIG_YES
+		/// Select the AVX2 simd algorithms at runtime with CPUID, for host builds without -mavx2
+		#define SQUADS_CONFIG_SIMD_DISPATCH SQUADS_CONFIG_YES
+	#else
+		#define SQUADS_CONFIG_SIMD_DISPATCH SQUADS_CONFIG_NO
+	#endif
+#endif // SQUADS_CONFIG_SIMD_DISPATCH
+
 
 
 
@@ -27,6 +27,7 @@
 #include "functional.hpp"
 
 #include "initializer_list.hpp"
+#include "span.hpp"
 
 
 namespace squads {
@@ -34,6 +35,9 @@ namespace squads {
 	inline size_t popcount (uint32_t v)	{
 		return __builtin_popcount (v);
 	}
+	inline size_t popcount (uint64_t v)	{
+		return __builtin_popcountll (v);
+	}
 
 
 
@@ -136,19 +140,12 @@ namespace squads {
 
 	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
     inline void fill_n(T* src, size_t n, const T& val) {
-        T* last = src + n;
-        while (src != last) {
-            switch (n & 0x7) {
-                case 0: *src = val; ++src;
-                case 7: *src = val; ++src;
-                case 6: *src = val; ++src;
-                case 5: *src = val; ++src;
-                case 4: *src = val; ++src;
-                case 3: *src = val; ++src;
-                case 2: *src = val; ++src;
-                case 1: *src = val; ++src;
-            }
+        // Unrolled by 8, then the rest
+        for (; n >= 8; n -= 8, src += 8) {
+            src[0] = val; src[1] = val; src[2] = val; src[3] = val;
+            src[4] = val; src[5] = val; src[6] = val; src[7] = val;
         }
+        for (; n > 0; --n, ++src) *src = val;
 	}
 
 
@@ -168,12 +165,12 @@ namespace squads {
     constexpr TIter lower_bound(TIter src, TIter last, const T& val, const TPred& pred) {
 	        internal::test_ordering(src, last, pred);
 	        int dist(0);
-	        dist = distance(src, last);
+	        dist = squads::distance(src, last);
 
 	        while (dist > 0) {
                 const int halfDist = dist >> 1;
                 TIter mid = src;
-                advance(mid, halfDist);
+                squads::advance(mid, halfDist);
                 if (internal::debug_pred(pred, *mid, val))
                         src = ++mid, dist -= halfDist + 1;
                 else
@@ -199,12 +196,12 @@ namespace squads {
     constexpr TIter upper_bound(TIter src, TIter last, const T& val, const TPred& pred) {
 	        internal::test_ordering(src, last, pred);
 	        int dist(0);
-	        dist = distance(src, last);
+	        dist = squads::distance(src, last);
 
 	        while (dist > 0) {
                 const int halfDist = dist >> 1;
                 TIter mid = src;
-                advance(mid, halfDist);
+                squads::advance(mid, halfDist);
                 if (!internal::debug_pred(pred, val, *mid))
                     src = ++mid, dist -= halfDist + 1;
                 else
@@ -248,6 +245,62 @@ namespace squads {
         }
 	}
 
+	/**
+	 * @brief Call fn for all elements of the span.
+	 */
+	template <typename T, class TFn>
+	inline TFn foreach(basic_span<T> s, TFn fn) {
+		return squads::foreach(s.begin(), s.end(), fn);
+	}
+
+	/**
+	 * @brief Set all elements of the span to val.
+	 */
+	template <typename T, typename U>
+	inline void fill(basic_span<T> s, const U& val) {
+		squads::fill(s.begin(), s.end(), static_cast<T>(val));
+	}
+
+	/**
+	 * @brief Find val in the span.
+	 * @return The pointer to the element or s.end() when not found.
+	 */
+	template <typename T, typename U>
+	inline T* find(basic_span<T> s, const U& val) {
+		return squads::find(s.begin(), s.end(), val);
+	}
+
+	template <typename T, typename U, class TPred>
+	inline T* find_if(basic_span<T> s, const U& val, const TPred& pred) {
+		return squads::find_if(s.begin(), s.end(), val, pred);
+	}
+
+	template <typename T, typename U>
+	inline void accumulate(basic_span<T> s, U& dest) {
+		squads::accumulate(s.begin(), s.end(), dest);
+	}
+
+	/**
+	 * @brief Copy the elements of src to the begin of dest.
+	 * @return The number of copied elements, the smaller of both sizes.
+	 */
+	template <typename T, typename U>
+	inline size_t copy(basic_span<T> src, basic_span<U> dest) {
+		size_t _count = src.size() < dest.size() ? src.size() : dest.size();
+		for(size_t i = 0; i < _count; i++) dest[i] = src[i];
+		return _count;
+	}
+
+	template <typename T, typename U, class TPred>
+	inline T* lower_bound(basic_span<T> s, const U& val, const TPred& pred) {
+		return squads::lower_bound(s.begin(), s.end(), val, pred);
+	}
+
+	template <typename T, typename U, class TPred>
+	inline T* upper_bound(basic_span<T> s, const U& val, const TPred& pred) {
+		return squads::upper_bound(s.begin(), s.end(), val, pred);
+	}
+
 	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
     T abs(const T& t) {
 	    return t >= T(0) ? t : -t;
@@ -26,6 +26,9 @@ namespace squads {
      * If sucessive Enqueue operations are called, that item is overwritten
      * with whatever the last item was.
      * 
+     * @note Each push is a kernel call and a copy. For a latest value mailbox
+     * between two tasks without kernel calls see basic_triple_buffer.
+     * 
      * @ingroup queue
      */
     template <typename T>
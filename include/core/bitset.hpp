@@ -0,0 +1,496 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_BITSET_H__
+#define __SQUADS_BITSET_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/// The machine word, that hold the bits of a bitset
+		using bitset_word_t = typename squads::conditional<(sizeof(void*) >= 8), uint64_t, uint32_t>::type;
+
+		constexpr size_t bitset_word_bits = sizeof(bitset_word_t) * CHAR_BIT;
+		constexpr size_t bitset_npos = size_t(-1);
+
+		constexpr size_t bitset_words(size_t bits) 		{ return (bits + bitset_word_bits - 1) / bitset_word_bits; }
+		constexpr size_t bitset_word_of(size_t pos) 	{ return pos / bitset_word_bits; }
+		constexpr bitset_word_t bitset_mask_of(size_t pos) { return bitset_word_t(1) << (pos % bitset_word_bits); }
+
+		/**
+		 * @brief The mask of the used bits in the last word.
+		 */
+		constexpr bitset_word_t bitset_last_mask(size_t bits) {
+			return (bits % bitset_word_bits == 0) ? ~bitset_word_t(0)
+												  : (bitset_word_t(1) << (bits % bitset_word_bits)) - 1;
+		}
+
+		inline size_t bitset_count(const bitset_word_t* words, size_t count) {
+			size_t _bits = 0;
+			for(size_t i = 0; i < count; i++) _bits += squads::popcount(words[i]);
+			return _bits;
+		}
+
+		/**
+		 * @brief Find the first set bit at or after pos.
+		 * @return The position of the bit or bitset_npos.
+		 */
+		inline size_t bitset_find_from(const bitset_word_t* words, size_t count, size_t pos) {
+			size_t _index = bitset_word_of(pos);
+			if(_index >= count) return bitset_npos;
+
+			// Mask out the bits below pos in the first word
+			bitset_word_t _word = words[_index] & (~bitset_word_t(0) << (pos % bitset_word_bits));
+
+			while(true) {
+				if(_word != 0) return _index * bitset_word_bits + squads::ctz(_word);
+				if(++_index >= count) return bitset_npos;
+				_word = words[_index];
+			}
+		}
+
+		/**
+		 * @brief Find the last set bit.
+		 * @return The position of the bit or bitset_npos.
+		 */
+		inline size_t bitset_find_last(const bitset_word_t* words, size_t count) {
+			for(size_t i = count; i > 0; i--) {
+				if(words[i - 1] != 0) return (i - 1) * bitset_word_bits + squads::nlz(words[i - 1]);
+			}
+			return bitset_npos;
+		}
+
+		inline bool bitset_equal(const bitset_word_t* a, const bitset_word_t* b, size_t count) {
+			for(size_t i = 0; i < count; i++) if(a[i] != b[i]) return false;
+			return true;
+		}
+	}
+
+	/**
+	 * @brief A fixed size set of bits, stored in machine words.
+	 *
+	 * All bulk operations work a word at once, count() use popcount and the
+	 * find functions use ctz and nlz, so a scan skip 32 or 64 clear bits in one step.
+	 * The unused bits of the last word are always zero.
+	 *
+	 * @tparam N The number of bits.
+	 */
+	template <size_t N>
+	class basic_bitset {
+	public:
+		using word_type = internal::bitset_word_t;
+		using size_type = squads::size_t;
+		using self_type = basic_bitset<N>;
+
+		static constexpr size_type WordBits = internal::bitset_word_bits;
+		static constexpr size_type WordCount = internal::bitset_words(N) == 0 ? 1 : internal::bitset_words(N);
+		static constexpr size_type npos = internal::bitset_npos;
+
+		basic_bitset() { reset(); }
+
+		/**
+		 * @brief Construct the bitset from the lower bits of a value.
+		 */
+		explicit basic_bitset(uint64_t value) {
+			reset();
+			for(size_type i = 0; i < WordCount && i * WordBits < 64; i++)
+				m_aWords[i] = word_type(value >> (i * WordBits));
+			trim();
+		}
+
+		constexpr size_type size() const { return N; }
+
+		bool test(size_type pos) const {
+			assert(pos < N);
+			return (m_aWords[internal::bitset_word_of(pos)] & internal::bitset_mask_of(pos)) != 0;
+		}
+		bool operator[] (size_type pos) const { return test(pos); }
+
+		self_type& set() {
+			for(size_type i = 0; i < WordCount; i++) m_aWords[i] = ~word_type(0);
+			trim(); return *this;
+		}
+		self_type& set(size_type pos, bool value = true) {
+			assert(pos < N);
+			if(value) m_aWords[internal::bitset_word_of(pos)] |= internal::bitset_mask_of(pos);
+			else m_aWords[internal::bitset_word_of(pos)] &= ~internal::bitset_mask_of(pos);
+			return *this;
+		}
+		self_type& reset() {
+			for(size_type i = 0; i < WordCount; i++) m_aWords[i] = 0;
+			return *this;
+		}
+		self_type& reset(size_type pos) { return set(pos, false); }
+
+		self_type& flip() {
+			for(size_type i = 0; i < WordCount; i++) m_aWords[i] = ~m_aWords[i];
+			trim(); return *this;
+		}
+		self_type& flip(size_type pos) {
+			assert(pos < N);
+			m_aWords[internal::bitset_word_of(pos)] ^= internal::bitset_mask_of(pos);
+			return *this;
+		}
+
+		/**
+		 * @brief Get the number of set bits.
+		 */
+		size_type count() const { return internal::bitset_count(m_aWords, WordCount); }
+
+		bool any() const {
+			for(size_type i = 0; i < WordCount; i++) if(m_aWords[i] != 0) return true;
+			return false;
+		}
+		bool none() const 	{ return !any(); }
+		bool all() const 	{ return count() == N; }
+
+		/**
+		 * @brief Get the position of the first set bit or npos.
+		 */
+		size_type find_first() const { return internal::bitset_find_from(m_aWords, WordCount, 0); }
+		/**
+		 * @brief Get the position of the first set bit after pos or npos.
+		 */
+		size_type find_next(size_type pos) const {
+			return (pos + 1 >= N) ? npos : internal::bitset_find_from(m_aWords, WordCount, pos + 1);
+		}
+		/**
+		 * @brief Get the position of the last set bit or npos.
+		 */
+		size_type find_last() const { return internal::bitset_find_last(m_aWords, WordCount); }
+
+		/**
+		 * @brief Get the position of the first clear bit or npos.
+		 */
+		size_type find_first_zero() const {
+			for(size_type i = 0; i < WordCount; i++) {
+				word_type _word = ~m_aWords[i];
+				if(_word != 0) {
+					size_type _pos = i * WordBits + squads::ctz(_word);
+					return (_pos < N) ? _pos : npos;
+				}
+			}
+			return npos;
+		}
+
+		self_type& operator &= (const self_type& other) {
+			for(size_type i = 0; i < WordCount; i++) m_aWords[i] &= other.m_aWords[i];
+			return *this;
+		}
+		self_type& operator |= (const self_type& other) {
+			for(size_type i = 0; i < WordCount; i++) m_aWords[i] |= other.m_aWords[i];
+			return *this;
+		}
+		self_type& operator ^= (const self_type& other) {
+			for(size_type i = 0; i < WordCount; i++) m_aWords[i] ^= other.m_aWords[i];
+			return *this;
+		}
+		self_type operator ~ () const { self_type _copy(*this); return _copy.flip(); }
+
+		bool operator == (const self_type& other) const {
+			return internal::bitset_equal(m_aWords, other.m_aWords, WordCount);
+		}
+		bool operator != (const self_type& other) const { return !(*this == other); }
+
+		/**
+		 * @brief Call fn(pos) for every set bit.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) const {
+			for(size_type i = 0; i < WordCount; i++) {
+				word_type _word = m_aWords[i];
+				while(_word != 0) {
+					fn(i * WordBits + squads::ctz(_word));
+					_word &= _word - 1;
+				}
+			}
+			return fn;
+		}
+
+		word_type* data() 				{ return m_aWords; }
+		const word_type* data() const 	{ return m_aWords; }
+		constexpr size_type num_words() const { return WordCount; }
+	private:
+		void trim() { m_aWords[WordCount - 1] &= internal::bitset_last_mask(N == 0 ? WordBits : N); }
+	private:
+		word_type m_aWords[WordCount];
+	};
+
+	template <size_t N>
+	inline basic_bitset<N> operator & (const basic_bitset<N>& a, const basic_bitset<N>& b) {
+		basic_bitset<N> _ret(a); return _ret &= b;
+	}
+	template <size_t N>
+	inline basic_bitset<N> operator | (const basic_bitset<N>& a, const basic_bitset<N>& b) {
+		basic_bitset<N> _ret(a); return _ret |= b;
+	}
+	template <size_t N>
+	inline basic_bitset<N> operator ^ (const basic_bitset<N>& a, const basic_bitset<N>& b) {
+		basic_bitset<N> _ret(a); return _ret ^= b;
+	}
+
+	/**
+	 * @brief A resizeable set of bits, stored in machine words from the allocator.
+	 *
+	 * Has the same word operations as basic_bitset. The bulk operators combine
+	 * the common bits of both sets, the size is not changed.
+	 *
+	 * @tparam TAllocator The allocator for the words.
+	 */
+	template <class TAllocator = squads::default_allocator<> >
+	class basic_dynamic_bitset {
+	public:
+		using word_type = internal::bitset_word_t;
+		using size_type = squads::size_t;
+		using allocator_type = TAllocator;
+		using self_type = basic_dynamic_bitset<TAllocator>;
+
+		static constexpr size_type WordBits = internal::bitset_word_bits;
+		static constexpr size_type npos = internal::bitset_npos;
+
+		basic_dynamic_bitset()
+			: m_pWords(nullptr), m_sBits(0), m_sWordCapacity(0), m_aAllocator() { }
+
+		/**
+		 * @brief Construct a bitset with the given number of bits.
+		 * @note On allocation failure the size is 0.
+		 */
+		explicit basic_dynamic_bitset(size_type bits, bool value = false)
+			: m_pWords(nullptr), m_sBits(0), m_sWordCapacity(0), m_aAllocator() { resize(bits, value); }
+
+		basic_dynamic_bitset(const self_type& other)
+			: m_pWords(nullptr), m_sBits(0), m_sWordCapacity(0), m_aAllocator() {
+			if(reserve(other.m_sBits)) {
+				memcpy(m_pWords, other.m_pWords, other.num_words() * sizeof(word_type));
+				m_sBits = other.m_sBits;
+			}
+		}
+
+		basic_dynamic_bitset(self_type&& other)
+			: m_pWords(other.m_pWords), m_sBits(other.m_sBits), m_sWordCapacity(other.m_sWordCapacity),
+			  m_aAllocator() {
+			other.m_pWords = nullptr; other.m_sBits = 0; other.m_sWordCapacity = 0;
+		}
+
+		~basic_dynamic_bitset() { release(); }
+
+		self_type& operator = (const self_type& other) {
+			if(this != &other) { self_type _copy(other); swap(_copy); }
+			return *this;
+		}
+		self_type& operator = (self_type&& other) {
+			swap(other); return *this;
+		}
+
+		size_type size() const 		{ return m_sBits; }
+		bool empty() const 			{ return m_sBits == 0; }
+		size_type capacity() const 	{ return m_sWordCapacity * WordBits; }
+		size_type num_words() const { return internal::bitset_words(m_sBits); }
+
+		/**
+		 * @brief Reserve memory for the given number of bits.
+		 * @return False on allocation failure.
+		 */
+		bool reserve(size_type bits) {
+			size_type _words = internal::bitset_words(bits);
+			if(_words <= m_sWordCapacity) return true;
+
+			word_type* _pWords = static_cast<word_type*>(
+				m_aAllocator.allocate(_words, sizeof(word_type), alignof(word_type)));
+			if(_pWords == nullptr) return false;
+
+			if(m_pWords != nullptr) memcpy(_pWords, m_pWords, num_words() * sizeof(word_type));
+			release();
+
+			m_pWords = _pWords;
+			m_sWordCapacity = _words;
+			return true;
+		}
+
+		/**
+		 * @brief Change the number of bits, the new bits get the given value.
+		 * @return False on allocation failure.
+		 */
+		bool resize(size_type bits, bool value = false) {
+			size_type _old = m_sBits;
+			if(bits > _old && !reserve(bits)) return false;
+
+			m_sBits = bits;
+			if(bits > _old) {
+				size_type _oldWords = internal::bitset_words(_old);
+				word_type _fill = value ? ~word_type(0) : 0;
+
+				// The unused bits of the old last word are zero
+				if(value && _old % WordBits != 0)
+					m_pWords[_oldWords - 1] |= ~internal::bitset_last_mask(_old);
+				for(size_type i = _oldWords; i < num_words(); i++) m_pWords[i] = _fill;
+			}
+			trim();
+			return true;
+		}
+
+		/**
+		 * @brief Append a bit.
+		 * @return False on allocation failure.
+		 */
+		bool push_back(bool value) {
+			if(m_sBits == capacity() && !reserve(squads::max<size_type>(2 * m_sBits, WordBits)))
+				return false;
+			if(m_sBits % WordBits == 0) m_pWords[internal::bitset_word_of(m_sBits)] = 0;
+			++m_sBits;
+			set(m_sBits - 1, value);
+			return true;
+		}
+
+		void clear() { m_sBits = 0; }
+
+		bool test(size_type pos) const {
+			assert(pos < m_sBits);
+			return (m_pWords[internal::bitset_word_of(pos)] & internal::bitset_mask_of(pos)) != 0;
+		}
+		bool operator[] (size_type pos) const { return test(pos); }
+
+		self_type& set() {
+			for(size_type i = 0; i < num_words(); i++) m_pWords[i] = ~word_type(0);
+			trim(); return *this;
+		}
+		self_type& set(size_type pos, bool value = true) {
+			assert(pos < m_sBits);
+			if(value) m_pWords[internal::bitset_word_of(pos)] |= internal::bitset_mask_of(pos);
+			else m_pWords[internal::bitset_word_of(pos)] &= ~internal::bitset_mask_of(pos);
+			return *this;
+		}
+		self_type& reset() {
+			for(size_type i = 0; i < num_words(); i++) m_pWords[i] = 0;
+			return *this;
+		}
+		self_type& reset(size_type pos) { return set(pos, false); }
+
+		self_type& flip() {
+			for(size_type i = 0; i < num_words(); i++) m_pWords[i] = ~m_pWords[i];
+			trim(); return *this;
+		}
+		self_type& flip(size_type pos) {
+			assert(pos < m_sBits);
+			m_pWords[internal::bitset_word_of(pos)] ^= internal::bitset_mask_of(pos);
+			return *this;
+		}
+
+		/**
+		 * @brief Get the number of set bits.
+		 */
+		size_type count() const { return internal::bitset_count(m_pWords, num_words()); }
+
+		bool any() const {
+			for(size_type i = 0; i < num_words(); i++) if(m_pWords[i] != 0) return true;
+			return false;
+		}
+		bool none() const 	{ return !any(); }
+		bool all() const 	{ return count() == m_sBits; }
+
+		/**
+		 * @brief Get the position of the first set bit or npos.
+		 */
+		size_type find_first() const { return internal::bitset_find_from(m_pWords, num_words(), 0); }
+		/**
+		 * @brief Get the position of the first set bit after pos or npos.
+		 */
+		size_type find_next(size_type pos) const {
+			return (pos + 1 >= m_sBits) ? npos : internal::bitset_find_from(m_pWords, num_words(), pos + 1);
+		}
+		/**
+		 * @brief Get the position of the last set bit or npos.
+		 */
+		size_type find_last() const { return internal::bitset_find_last(m_pWords, num_words()); }
+
+		self_type& operator &= (const self_type& other) {
+			size_type _common = squads::min(num_words(), other.num_words());
+			for(size_type i = 0; i < _common; i++) m_pWords[i] &= other.m_pWords[i];
+			for(size_type i = _common; i < num_words(); i++) m_pWords[i] = 0;
+			return *this;
+		}
+		self_type& operator |= (const self_type& other) {
+			size_type _common = squads::min(num_words(), other.num_words());
+			for(size_type i = 0; i < _common; i++) m_pWords[i] |= other.m_pWords[i];
+			trim(); return *this;
+		}
+		self_type& operator ^= (const self_type& other) {
+			size_type _common = squads::min(num_words(), other.num_words());
+			for(size_type i = 0; i < _common; i++) m_pWords[i] ^= other.m_pWords[i];
+			trim(); return *this;
+		}
+
+		bool operator == (const self_type& other) const {
+			return m_sBits == other.m_sBits && internal::bitset_equal(m_pWords, other.m_pWords, num_words());
+		}
+		bool operator != (const self_type& other) const { return !(*this == other); }
+
+		/**
+		 * @brief Call fn(pos) for every set bit.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) const {
+			for(size_type i = 0; i < num_words(); i++) {
+				word_type _word = m_pWords[i];
+				while(_word != 0) {
+					fn(i * WordBits + squads::ctz(_word));
+					_word &= _word - 1;
+				}
+			}
+			return fn;
+		}
+
+		void swap(self_type& other) {
+			squads::swap(m_pWords, other.m_pWords);
+			squads::swap(m_sBits, other.m_sBits);
+			squads::swap(m_sWordCapacity, other.m_sWordCapacity);
+		}
+
+		word_type* data() 				{ return m_pWords; }
+		const word_type* data() const 	{ return m_pWords; }
+	private:
+		void trim() {
+			if(m_sBits != 0) m_pWords[num_words() - 1] &= internal::bitset_last_mask(m_sBits);
+		}
+		void release() {
+			if(m_pWords != nullptr)
+				m_aAllocator.deallocate(m_pWords, m_sWordCapacity, sizeof(word_type), alignof(word_type));
+			m_pWords = nullptr;
+			m_sWordCapacity = 0;
+		}
+	private:
+		word_type* 		m_pWords;
+		size_type 		m_sBits;
+		size_type 		m_sWordCapacity;
+		allocator_type 	m_aAllocator;
+	};
+
+	template <size_t N>
+	using bitset = basic_bitset<N>;
+
+	template <class TAllocator = squads::default_allocator<> >
+	using dynamic_bitset = basic_dynamic_bitset<TAllocator>;
+}
+
+#endif // __SQUADS_BITSET_H__
@@ -0,0 +1,842 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_BTREE_MAP_H__
+#define __SQUADS_BTREE_MAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "iterator.hpp"
+#include "pair.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief The common header of the leaf and the inner nodes.
+		 */
+		struct btree_node_base {
+			uint16_t 	Count;
+			bool 		IsLeaf;
+		};
+
+		template <typename TKey, typename TValue, size_t NLeafSize>
+		struct btree_leaf_node : btree_node_base {
+			TKey 			 Keys[NLeafSize];
+			TValue 			 Values[NLeafSize];
+			btree_leaf_node* Prev;
+			btree_leaf_node* Next;
+
+			btree_leaf_node() : Prev(nullptr), Next(nullptr) { Count = 0; IsLeaf = true; }
+		};
+
+		template <typename TKey, size_t NInnerSize>
+		struct btree_inner_node : btree_node_base {
+			/// Children[i] holds the keys k with Keys[i - 1] <= k < Keys[i]
+			TKey 			 Keys[NInnerSize];
+			btree_node_base* Children[NInnerSize + 1];
+
+			btree_inner_node() { Count = 0; IsLeaf = false; }
+		};
+
+		/**
+		 * @brief The number of elements, that fit in a node of NBytes.
+		 */
+		constexpr size_t btree_fit(size_t bytes, size_t header, size_t entry) {
+			return (bytes > header && (bytes - header) / entry >= 4) ? (bytes - header) / entry : 4;
+		}
+
+		/**
+		 * @brief Selects the in-node search: true for the branchless linear search of the
+		 * arithmetic keys, false for the binary search of all other keys.
+		 */
+		template <typename TKey>
+		struct btree_branchless_search
+			: public squads::integral_constant<bool, squads::is_arithmetic<TKey>::value> { };
+
+		/**
+		 * @brief Search in a node: the number of keys, for which pred(key) is true.
+		 * The keys are sorted, so pred is true for a prefix.
+		 *
+		 * Arithmetic keys are compared all without branches, the compiler
+		 * can vectorize this loop. Other keys use a binary search.
+		 * @see btree_branchless_search
+		 */
+		template <typename TKey, class TPred>
+		inline size_t btree_count_prefix(const TKey* keys, size_t count, TPred pred,
+										 squads::integral_constant<bool, true>) {
+			size_t _n = 0;
+			for(size_t i = 0; i < count; i++) _n += pred(keys[i]) ? 1 : 0;
+			return _n;
+		}
+
+		template <typename TKey, class TPred>
+		inline size_t btree_count_prefix(const TKey* keys, size_t count, TPred pred,
+										 squads::integral_constant<bool, false>) {
+			size_t _lo = 0, _hi = count;
+			while(_lo < _hi) {
+				size_t _mid = (_lo + _hi) / 2;
+				if(pred(keys[_mid])) _lo = _mid + 1;
+				else _hi = _mid;
+			}
+			return _lo;
+		}
+	}
+
+	/**
+	 * @brief The reference to a element of a basic_btree_map.
+	 */
+	template <typename TKey, typename TValue>
+	struct basic_btree_map_reference {
+		const TKey& key;
+		TValue& 	value;
+
+		const basic_btree_map_reference* operator->() const { return this; }
+	};
+
+	/**
+	 * @brief Bidirectional iterator of the basic_btree_map, walks the linked leaves.
+	 */
+	template <typename TKey, typename TValue, typename TLeaf>
+	class basic_btree_map_iterator {
+		template <typename UKey, typename UValue, typename ULeaf> friend class basic_btree_map_iterator;
+	public:
+		using iterator_category = squads::bidirectional_iterator_tag;
+		using value_type = basic_btree_map_reference<TKey, TValue>;
+		using reference = value_type;
+		using pointer = value_type;
+		using difference_type = squads::ptrdiff_t;
+		using size_type = squads::size_t;
+		using self_type = basic_btree_map_iterator<TKey, TValue, TLeaf>;
+
+		basic_btree_map_iterator() : m_pLeaf(nullptr), m_sIndex(0), m_ppLast(nullptr) { }
+		basic_btree_map_iterator(TLeaf* leaf, size_type index, TLeaf* const* last)
+			: m_pLeaf(leaf), m_sIndex(index), m_ppLast(last) { }
+
+		template <typename UValue>
+		basic_btree_map_iterator(const basic_btree_map_iterator<TKey, UValue, TLeaf>& other)
+			: m_pLeaf(other.m_pLeaf), m_sIndex(other.m_sIndex), m_ppLast(other.m_ppLast) { }
+
+		const TKey& key() const 	{ return m_pLeaf->Keys[m_sIndex]; }
+		TValue& value() const 		{ return m_pLeaf->Values[m_sIndex]; }
+
+		reference operator*() const 	{ return reference{key(), value()}; }
+		pointer operator->() const 		{ return pointer{key(), value()}; }
+
+		self_type& operator++() {
+			if(++m_sIndex >= m_pLeaf->Count) {
+				m_pLeaf = m_pLeaf->Next;
+				m_sIndex = 0;
+			}
+			return *this;
+		}
+		self_type& operator--() {
+			if(m_pLeaf == nullptr) {
+				m_pLeaf = *m_ppLast;
+				m_sIndex = m_pLeaf->Count - 1;
+			} else if(m_sIndex == 0) {
+				m_pLeaf = m_pLeaf->Prev;
+				m_sIndex = m_pLeaf->Count - 1;
+			} else {
+				--m_sIndex;
+			}
+			return *this;
+		}
+		self_type operator++(int) 	{ self_type _copy(*this); ++(*this); return _copy; }
+		self_type operator--(int) 	{ self_type _copy(*this); --(*this); return _copy; }
+
+		template <typename UValue>
+		bool operator == (const basic_btree_map_iterator<TKey, UValue, TLeaf>& rhs) const {
+			return m_pLeaf == rhs.m_pLeaf && m_sIndex == rhs.m_sIndex;
+		}
+		template <typename UValue>
+		bool operator != (const basic_btree_map_iterator<TKey, UValue, TLeaf>& rhs) const {
+			return !(*this == rhs);
+		}
+
+		TLeaf* get_leaf() const 		{ return m_pLeaf; }
+		size_type get_index() const 	{ return m_sIndex; }
+	private:
+		TLeaf* 			m_pLeaf;
+		size_type 		m_sIndex;
+		TLeaf* const* 	m_ppLast;
+	};
+
+	/**
+	 * @brief A ordered map as B+ tree, with nodes sized for cache lines or pages.
+	 *
+	 * All elements are in the leaves, the leaves are linked for range iteration.
+	 * The keys of a node are stored in one array, so a in-node search touches only a few
+	 * cache lines; arithmetic keys are searched with a branchless, vectorizable scan.
+	 * The nodes are allocated one by one through the allocator, so a pool allocator can be used.
+	 *
+	 * @tparam TKey The type of the keys, must be default constructible and assignable.
+	 * @tparam TValue The type of the values, must be default constructible and assignable.
+	 * @tparam TCompare The order of the keys, default squads::less<TKey>.
+	 * @tparam TAllocator The allocator for the nodes.
+	 * @tparam NNodeBytes The target size of a node in bytes, 256 (4 cache lines) or a page.
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename TKey, typename TValue, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<>, size_t NNodeBytes = 256>
+	class basic_btree_map {
+	public:
+		static constexpr size_t LeafSize = internal::btree_fit(NNodeBytes,
+			sizeof(internal::btree_node_base) + 2 * sizeof(void*), sizeof(TKey) + sizeof(TValue));
+		static constexpr size_t InnerSize = internal::btree_fit(NNodeBytes,
+			sizeof(internal::btree_node_base) + sizeof(void*), sizeof(TKey) + sizeof(void*));
+
+		static_assert(LeafSize < 65536 && InnerSize < 65536, "basic_btree_map: the node size is too big");
+
+		using key_type = TKey;
+		using mapped_type = TValue;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using key_compare = TCompare;
+		using allocator_type = TAllocator;
+		using node_type = internal::btree_node_base;
+		using leaf_type = internal::btree_leaf_node<TKey, TValue, LeafSize>;
+		using inner_type = internal::btree_inner_node<TKey, InnerSize>;
+		using iterator = basic_btree_map_iterator<TKey, TValue, leaf_type>;
+		using const_iterator = basic_btree_map_iterator<TKey, const TValue, leaf_type>;
+		using self_type = basic_btree_map<TKey, TValue, TCompare, TAllocator, NNodeBytes>;
+		using insert_result = squads::pair<iterator, bool>;
+
+		/// The minimal number of elements in a leaf, that is not the root
+		static constexpr size_type MinLeaf = LeafSize / 2;
+		/// The minimal number of keys in a inner node, that is not the root
+		static constexpr size_type MinInner = (InnerSize - 1) / 2;
+		/// The maximal height of the tree
+		static constexpr size_type MaxDepth = 64;
+		/// True, when the keys in a node are searched without branches
+		static constexpr bool BranchlessSearch = internal::btree_branchless_search<TKey>::value;
+
+		basic_btree_map()
+			: m_pRoot(nullptr), m_pFirst(nullptr), m_pLast(nullptr), m_sSize(0), m_sHeight(0),
+			  m_cCompare(), m_aAllocator() { }
+
+		basic_btree_map(const self_type& other) : basic_btree_map() {
+			for(const_iterator it = other.begin(); it != other.end(); ++it)
+				if(!insert(it.key(), it.value()).second()) break;
+		}
+
+		basic_btree_map(self_type&& other) : basic_btree_map() { swap(other); }
+
+		~basic_btree_map() { clear(); }
+
+		self_type& operator = (const self_type& other) {
+			if(this != &other) { self_type _copy(other); swap(_copy); }
+			return *this;
+		}
+		self_type& operator = (self_type&& other) { swap(other); return *this; }
+
+		iterator begin() 				{ return iterator(m_pFirst, 0, &m_pLast); }
+		const_iterator begin() const 	{ return const_iterator(m_pFirst, 0, &m_pLast); }
+		iterator end() 					{ return iterator(nullptr, 0, &m_pLast); }
+		const_iterator end() const 		{ return const_iterator(nullptr, 0, &m_pLast); }
+
+		size_type size() const 		{ return m_sSize; }
+		bool empty() const 			{ return m_sSize == 0; }
+		size_type height() const 	{ return m_sHeight; }
+
+		/**
+		 * @brief Find the element with the given key.
+		 * @return The iterator to the element or end() when not found.
+		 */
+		iterator find(const key_type& key) {
+			iterator _it = lower_bound(key);
+			return (_it != end() && !m_cCompare(key, _it.key())) ? _it : end();
+		}
+		const_iterator find(const key_type& key) const { return const_cast<self_type*>(this)->find(key); }
+
+		bool contains(const key_type& key) const 	{ return find(key) != end(); }
+		size_type count(const key_type& key) const 	{ return contains(key) ? 1 : 0; }
+
+		/**
+		 * @brief Get the first element with a key not less than key.
+		 */
+		iterator lower_bound(const key_type& key) {
+			if(m_pRoot == nullptr) return end();
+			leaf_type* _pLeaf = find_leaf(key);
+			return make_iterator(_pLeaf, lower_in(_pLeaf->Keys, _pLeaf->Count, key));
+		}
+		const_iterator lower_bound(const key_type& key) const { return const_cast<self_type*>(this)->lower_bound(key); }
+
+		/**
+		 * @brief Get the first element with a key greater than key.
+		 */
+		iterator upper_bound(const key_type& key) {
+			if(m_pRoot == nullptr) return end();
+			leaf_type* _pLeaf = find_leaf(key);
+			return make_iterator(_pLeaf, upper_in(_pLeaf->Keys, _pLeaf->Count, key));
+		}
+		const_iterator upper_bound(const key_type& key) const { return const_cast<self_type*>(this)->upper_bound(key); }
+
+		/**
+		 * @brief Call fn(key, value) for all elements with first <= key < last, in order.
+		 * @return The number of visited elements.
+		 */
+		template <class TFn>
+		size_type for_range(const key_type& first, const key_type& last, TFn fn) const {
+			size_type _count = 0;
+			for(const_iterator it = lower_bound(first); it != end() && m_cCompare(it.key(), last); ++it, ++_count)
+				fn(it.key(), it.value());
+			return _count;
+		}
+
+		/**
+		 * @brief Insert a key/value, when the key is not in the map.
+		 * @return The iterator to the element and true when inserted.
+		 * On allocation failure the iterator is end().
+		 */
+		insert_result insert(const key_type& key, const mapped_type& value) {
+			if(m_pRoot == nullptr) {
+				leaf_type* _pLeaf = new_leaf();
+				if(_pLeaf == nullptr) return insert_result(end(), false);
+				m_pRoot = m_pFirst = m_pLast = _pLeaf;
+				m_sHeight = 1;
+			}
+
+			inner_type* _path[MaxDepth];
+			size_type _index[MaxDepth];
+			size_type _depth = 0;
+
+			node_type* _pNode = m_pRoot;
+			while(!_pNode->IsLeaf) {
+				inner_type* _pInner = static_cast<inner_type*>(_pNode);
+				_path[_depth] = _pInner;
+				_index[_depth] = upper_in(_pInner->Keys, _pInner->Count, key);
+				_pNode = _pInner->Children[_index[_depth]];
+				++_depth;
+			}
+
+			leaf_type* _pLeaf = static_cast<leaf_type*>(_pNode);
+			size_type _pos = lower_in(_pLeaf->Keys, _pLeaf->Count, key);
+			if(_pos < _pLeaf->Count && !m_cCompare(key, _pLeaf->Keys[_pos]))
+				return insert_result(make_iterator(_pLeaf, _pos), false);
+
+			if(_pLeaf->Count < LeafSize) {
+				leaf_insert(_pLeaf, _pos, key, value);
+				++m_sSize;
+				return insert_result(make_iterator(_pLeaf, _pos), true);
+			}
+
+			// Allocate all nodes for the splits first, so a failure leaves the tree unchanged.
+			size_type _splits = 0;
+			while(_splits < _depth && _path[_depth - 1 - _splits]->Count == InnerSize) ++_splits;
+			bool _bNewRoot = (_splits == _depth);
+
+			inner_type* _pool[MaxDepth + 1];
+			size_type _poolSize = _splits + (_bNewRoot ? 1 : 0);
+			leaf_type* _pRight = new_leaf();
+			bool _bFailed = (_pRight == nullptr);
+
+			for(size_type i = 0; i < _poolSize; i++) {
+				_pool[i] = _bFailed ? nullptr : new_inner();
+				_bFailed = _bFailed || (_pool[i] == nullptr);
+			}
+			if(_bFailed) {
+				if(_pRight != nullptr) delete_node(_pRight);
+				for(size_type i = 0; i < _poolSize; i++) if(_pool[i] != nullptr) delete_node(_pool[i]);
+				return insert_result(end(), false);
+			}
+
+			iterator _result = split_leaf(_pLeaf, _pRight, _pos, key, value);
+			key_type _upKey = _pRight->Keys[0];
+			node_type* _pUpNode = _pRight;
+			size_type _poolNext = 0;
+
+			for(size_type _level = _depth; _level > 0; _level--) {
+				inner_type* _pParent = _path[_level - 1];
+				size_type _ci = _index[_level - 1];
+
+				if(_pParent->Count < InnerSize) {
+					inner_insert(_pParent, _ci, _upKey, _pUpNode);
+					_pUpNode = nullptr;
+					break;
+				}
+				inner_type* _pSplit = _pool[_poolNext++];
+				_upKey = split_inner(_pParent, _pSplit, _ci, _upKey, _pUpNode);
+				_pUpNode = _pSplit;
+			}
+
+			if(_pUpNode != nullptr) {
+				inner_type* _pRoot = _pool[_poolNext++];
+				_pRoot->Keys[0] = _upKey;
+				_pRoot->Children[0] = m_pRoot;
+				_pRoot->Children[1] = _pUpNode;
+				_pRoot->Count = 1;
+				m_pRoot = _pRoot;
+				++m_sHeight;
+			}
+			++m_sSize;
+			return insert_result(_result, true);
+		}
+
+		/**
+		 * @brief Insert a key/value or overwrite the value of an existing key.
+		 * @return False on allocation failure.
+		 */
+		bool insert_or_assign(const key_type& key, const mapped_type& value) {
+			insert_result _ret = insert(key, value);
+			if(_ret.first() == end()) return false;
+			if(!_ret.second()) _ret.first().value() = value;
+			return true;
+		}
+
+		/**
+		 * @brief Get the value of the key, the key is inserted with a default value when not found.
+		 */
+		mapped_type& operator[] (const key_type& key) {
+			insert_result _ret = insert(key, mapped_type());
+			assert(_ret.first() != end());
+			return _ret.first().value();
+		}
+
+		/**
+		 * @brief Erase the element with the given key.
+		 * @return The number of erased elements.
+		 */
+		size_type erase(const key_type& key) {
+			if(m_pRoot == nullptr) return 0;
+
+			inner_type* _path[MaxDepth];
+			size_type _index[MaxDepth];
+			size_type _depth = 0;
+
+			node_type* _pNode = m_pRoot;
+			while(!_pNode->IsLeaf) {
+				inner_type* _pInner = static_cast<inner_type*>(_pNode);
+				_path[_depth] = _pInner;
+				_index[_depth] = upper_in(_pInner->Keys, _pInner->Count, key);
+				_pNode = _pInner->Children[_index[_depth]];
+				++_depth;
+			}
+
+			leaf_type* _pLeaf = static_cast<leaf_type*>(_pNode);
+			size_type _pos = lower_in(_pLeaf->Keys, _pLeaf->Count, key);
+			if(_pos >= _pLeaf->Count || m_cCompare(key, _pLeaf->Keys[_pos])) return 0;
+
+			for(size_type i = _pos + 1; i < _pLeaf->Count; i++) {
+				_pLeaf->Keys[i - 1] = _pLeaf->Keys[i];
+				_pLeaf->Values[i - 1] = _pLeaf->Values[i];
+			}
+			--_pLeaf->Count;
+			--m_sSize;
+
+			if(_depth == 0) {
+				if(_pLeaf->Count == 0) {
+					delete_node(_pLeaf);
+					m_pRoot = m_pFirst = m_pLast = nullptr;
+					m_sHeight = 0;
+				}
+				return 1;
+			}
+
+			// Rebalance from the leaf up, while a node has too few entries
+			node_type* _pUnder = (_pLeaf->Count < MinLeaf) ? _pLeaf : nullptr;
+			for(size_type _level = _depth; _level > 0 && _pUnder != nullptr; _level--) {
+				inner_type* _pParent = _path[_level - 1];
+				size_type _ci = _index[_level - 1];
+
+				if(_pUnder->IsLeaf) fix_leaf(_pParent, _ci);
+				else fix_inner(_pParent, _ci);
+
+				_pUnder = (_level > 1 && _pParent->Count < MinInner) ? _pParent : nullptr;
+			}
+
+			if(!m_pRoot->IsLeaf && m_pRoot->Count == 0) {
+				node_type* _pOld = m_pRoot;
+				m_pRoot = static_cast<inner_type*>(_pOld)->Children[0];
+				delete_node(static_cast<inner_type*>(_pOld));
+				--m_sHeight;
+			}
+			return 1;
+		}
+
+		/**
+		 * @brief Remove all elements and free all nodes.
+		 */
+		void clear() {
+			if(m_pRoot != nullptr) free_subtree(m_pRoot);
+			m_pRoot = nullptr;
+			m_pFirst = m_pLast = nullptr;
+			m_sSize = 0;
+			m_sHeight = 0;
+		}
+
+		/**
+		 * @brief Replace the content with count sorted and unique keys and values.
+		 *
+		 * The tree is built bottom up in O(n), the leaves and inner nodes are filled
+		 * evenly and nearly full.
+		 * @param values The values or nullptr for default values.
+		 * @return False on allocation failure, the map is empty then.
+		 */
+		bool bulk_load(const key_type* keys, const mapped_type* values, size_type count) {
+			clear();
+			if(count == 0) return true;
+
+			const size_type _leaves = (count + LeafSize - 1) / LeafSize;
+			node_type** _ppLevel = static_cast<node_type**>(
+				m_aAllocator.allocate(_leaves, sizeof(node_type*), alignof(node_type*)));
+			if(_ppLevel == nullptr) return false;
+
+			size_type _pos = 0;
+			leaf_type* _pPrev = nullptr;
+
+			for(size_type i = 0; i < _leaves; i++) {
+				size_type _take = count / _leaves + ((i < count % _leaves) ? 1 : 0);
+				leaf_type* _pLeaf = new_leaf();
+				if(_pLeaf == nullptr) {
+					for(size_type j = 0; j < i; j++) free_subtree(_ppLevel[j]);
+					return failed_load(_ppLevel, _leaves);
+				}
+
+				for(size_type j = 0; j < _take; j++, _pos++) {
+					assert(_pos == 0 || m_cCompare(keys[_pos - 1], keys[_pos]));
+					_pLeaf->Keys[j] = keys[_pos];
+					if(values != nullptr) _pLeaf->Values[j] = values[_pos];
+				}
+				_pLeaf->Count = uint16_t(_take);
+				_pLeaf->Prev = _pPrev;
+				if(_pPrev != nullptr) _pPrev->Next = _pLeaf;
+
+				_pPrev = _pLeaf;
+				_ppLevel[i] = _pLeaf;
+			}
+
+			// Build the inner levels bottom up, the parents are written in front of the level array.
+			size_type _nodes = _leaves;
+			size_type _height = 1;
+
+			while(_nodes > 1) {
+				size_type _parents = (_nodes + InnerSize) / (InnerSize + 1);
+				size_type _child = 0;
+
+				for(size_type i = 0; i < _parents; i++) {
+					size_type _take = _nodes / _parents + ((i < _nodes % _parents) ? 1 : 0);
+					inner_type* _pInner = new_inner();
+					if(_pInner == nullptr) {
+						for(size_type j = 0; j < i; j++) free_subtree(_ppLevel[j]);
+						for(size_type j = _child; j < _nodes; j++) free_subtree(_ppLevel[j]);
+						return failed_load(_ppLevel, _leaves);
+					}
+
+					for(size_type j = 0; j < _take; j++, _child++) {
+						_pInner->Children[j] = _ppLevel[_child];
+						if(j > 0) _pInner->Keys[j - 1] = first_key(_ppLevel[_child]);
+					}
+					_pInner->Count = uint16_t(_take - 1);
+					_ppLevel[i] = _pInner;
+				}
+				_nodes = _parents;
+				++_height;
+			}
+
+			m_pRoot = _ppLevel[0];
+			m_pFirst = static_cast<leaf_type*>(first_leaf(m_pRoot));
+			m_pLast = _pPrev;
+			m_sSize = count;
+			m_sHeight = _height;
+
+			m_aAllocator.deallocate(_ppLevel, _leaves, sizeof(node_type*), alignof(node_type*));
+			return true;
+		}
+
+		void swap(self_type& other) {
+			squads::swap(m_pRoot, other.m_pRoot);
+			squads::swap(m_pFirst, other.m_pFirst);
+			squads::swap(m_pLast, other.m_pLast);
+			squads::swap(m_sSize, other.m_sSize);
+			squads::swap(m_sHeight, other.m_sHeight);
+			squads::swap(m_cCompare, other.m_cCompare);
+		}
+	private:
+		iterator make_iterator(leaf_type* leaf, size_type index) {
+			if(index < leaf->Count) return iterator(leaf, index, &m_pLast);
+			return iterator(leaf->Next, 0, &m_pLast);
+		}
+
+		/// The number of keys less than key
+		size_type lower_in(const key_type* keys, size_type count, const key_type& key) const {
+			const key_compare& _comp = m_cCompare;
+			return internal::btree_count_prefix(keys, count,
+				[&](const key_type& k) { return _comp(k, key); },
+				internal::btree_branchless_search<key_type>());
+		}
+
+		/// The number of keys less or equal than key
+		size_type upper_in(const key_type* keys, size_type count, const key_type& key) const {
+			const key_compare& _comp = m_cCompare;
+			return internal::btree_count_prefix(keys, count,
+				[&](const key_type& k) { return !_comp(key, k); },
+				internal::btree_branchless_search<key_type>());
+		}
+
+		leaf_type* find_leaf(const key_type& key) const {
+			node_type* _pNode = m_pRoot;
+			while(!_pNode->IsLeaf) {
+				inner_type* _pInner = static_cast<inner_type*>(_pNode);
+				_pNode = _pInner->Children[upper_in(_pInner->Keys, _pInner->Count, key)];
+			}
+			return static_cast<leaf_type*>(_pNode);
+		}
+
+		node_type* first_leaf(node_type* node) const {
+			while(!node->IsLeaf) node = static_cast<inner_type*>(node)->Children[0];
+			return node;
+		}
+
+		bool failed_load(node_type** level, size_type count) {
+			m_aAllocator.deallocate(level, count, sizeof(node_type*), alignof(node_type*));
+			return false;
+		}
+
+		const key_type& first_key(node_type* node) const {
+			return static_cast<leaf_type*>(first_leaf(node))->Keys[0];
+		}
+
+		void leaf_insert(leaf_type* leaf, size_type pos, const key_type& key, const mapped_type& value) {
+			for(size_type i = leaf->Count; i > pos; i--) {
+				leaf->Keys[i] = leaf->Keys[i - 1];
+				leaf->Values[i] = leaf->Values[i - 1];
+			}
+			leaf->Keys[pos] = key;
+			leaf->Values[pos] = value;
+			++leaf->Count;
+		}
+
+		void inner_insert(inner_type* inner, size_type pos, const key_type& key, node_type* right) {
+			for(size_type i = inner->Count; i > pos; i--) {
+				inner->Keys[i] = inner->Keys[i - 1];
+				inner->Children[i + 1] = inner->Children[i];
+			}
+			inner->Keys[pos] = key;
+			inner->Children[pos + 1] = right;
+			++inner->Count;
+		}
+
+		/**
+		 * @brief Split the full leaf, with the new element at pos, in leaf and right.
+		 * @return The iterator to the new element.
+		 */
+		iterator split_leaf(leaf_type* leaf, leaf_type* right, size_type pos, const key_type& key, const mapped_type& value) {
+			const size_type _left = (LeafSize + 1) / 2;
+
+			// The elements of the virtual sequence with the new element at pos
+			for(size_type j = _left; j <= LeafSize; j++) {
+				size_type _to = j - _left;
+				if(j < pos) 		{ right->Keys[_to] = leaf->Keys[j]; 	right->Values[_to] = leaf->Values[j]; }
+				else if(j == pos) 	{ right->Keys[_to] = key; 				right->Values[_to] = value; }
+				else 				{ right->Keys[_to] = leaf->Keys[j - 1]; right->Values[_to] = leaf->Values[j - 1]; }
+			}
+			right->Count = uint16_t(LeafSize + 1 - _left);
+			leaf->Count = uint16_t(_left);
+			if(pos < _left) {
+				leaf->Count = uint16_t(_left - 1);
+				leaf_insert(leaf, pos, key, value);
+			}
+
+			right->Next = leaf->Next;
+			right->Prev = leaf;
+			if(leaf->Next != nullptr) leaf->Next->Prev = right;
+			else m_pLast = right;
+			leaf->Next = right;
+
+			return (pos < _left) ? iterator(leaf, pos, &m_pLast) : iterator(right, pos - _left, &m_pLast);
+		}
+
+		/**
+		 * @brief Split the full inner node, with the new key at pos and the new child at pos + 1.
+		 * @return The key, that goes up to the parent.
+		 */
+		key_type split_inner(inner_type* inner, inner_type* right, size_type pos, const key_type& key, node_type* child) {
+			const size_type _left = (InnerSize + 1) / 2;
+
+			auto _keyAt = [&](size_type j) -> const key_type& {
+				return (j < pos) ? inner->Keys[j] : (j == pos) ? key : inner->Keys[j - 1];
+			};
+			auto _childAt = [&](size_type j) -> node_type* {
+				return (j <= pos) ? inner->Children[j] : (j == pos + 1) ? child : inner->Children[j - 1];
+			};
+
+			key_type _up = _keyAt(_left);
+			for(size_type j = _left + 1; j <= InnerSize; j++) right->Keys[j - _left - 1] = _keyAt(j);
+			for(size_type j = _left + 1; j <= InnerSize + 1; j++) right->Children[j - _left - 1] = _childAt(j);
+			right->Count = uint16_t(InnerSize - _left);
+
+			if(pos < _left) {
+				inner->Count = uint16_t(_left - 1);
+				inner_insert(inner, pos, key, child);
+			} else {
+				inner->Count = uint16_t(_left);
+			}
+			return _up;
+		}
+
+		/**
+		 * @brief Fix the leaf parent->Children[ci], that has too few elements.
+		 */
+		void fix_leaf(inner_type* parent, size_type ci) {
+			leaf_type* _pLeaf = static_cast<leaf_type*>(parent->Children[ci]);
+			leaf_type* _pLeft = (ci > 0) ? static_cast<leaf_type*>(parent->Children[ci - 1]) : nullptr;
+			leaf_type* _pRight = (ci < parent->Count) ? static_cast<leaf_type*>(parent->Children[ci + 1]) : nullptr;
+
+			if(_pLeft != nullptr && _pLeft->Count > MinLeaf) {
+				leaf_insert(_pLeaf, 0, _pLeft->Keys[_pLeft->Count - 1], _pLeft->Values[_pLeft->Count - 1]);
+				--_pLeft->Count;
+				parent->Keys[ci - 1] = _pLeaf->Keys[0];
+			} else if(_pRight != nullptr && _pRight->Count > MinLeaf) {
+				_pLeaf->Keys[_pLeaf->Count] = _pRight->Keys[0];
+				_pLeaf->Values[_pLeaf->Count] = _pRight->Values[0];
+				++_pLeaf->Count;
+				for(size_type i = 1; i < _pRight->Count; i++) {
+					_pRight->Keys[i - 1] = _pRight->Keys[i];
+					_pRight->Values[i - 1] = _pRight->Values[i];
+				}
+				--_pRight->Count;
+				parent->Keys[ci] = _pRight->Keys[0];
+			} else if(_pLeft != nullptr) {
+				merge_leaf(_pLeft, _pLeaf);
+				inner_remove(parent, ci - 1);
+			} else {
+				merge_leaf(_pLeaf, _pRight);
+				inner_remove(parent, ci);
+			}
+		}
+
+		/**
+		 * @brief Fix the inner node parent->Children[ci], that has too few keys.
+		 */
+		void fix_inner(inner_type* parent, size_type ci) {
+			inner_type* _pNode = static_cast<inner_type*>(parent->Children[ci]);
+			inner_type* _pLeft = (ci > 0) ? static_cast<inner_type*>(parent->Children[ci - 1]) : nullptr;
+			inner_type* _pRight = (ci < parent->Count) ? static_cast<inner_type*>(parent->Children[ci + 1]) : nullptr;
+
+			if(_pLeft != nullptr && _pLeft->Count > MinInner) {
+				_pNode->Children[_pNode->Count + 1] = _pNode->Children[_pNode->Count];
+				for(size_type i = _pNode->Count; i > 0; i--) {
+					_pNode->Keys[i] = _pNode->Keys[i - 1];
+					_pNode->Children[i] = _pNode->Children[i - 1];
+				}
+				_pNode->Keys[0] = parent->Keys[ci - 1];
+				_pNode->Children[0] = _pLeft->Children[_pLeft->Count];
+				++_pNode->Count;
+				parent->Keys[ci - 1] = _pLeft->Keys[_pLeft->Count - 1];
+				--_pLeft->Count;
+			} else if(_pRight != nullptr && _pRight->Count > MinInner) {
+				_pNode->Keys[_pNode->Count] = parent->Keys[ci];
+				_pNode->Children[_pNode->Count + 1] = _pRight->Children[0];
+				++_pNode->Count;
+				parent->Keys[ci] = _pRight->Keys[0];
+				for(size_type i = 1; i < _pRight->Count; i++) _pRight->Keys[i - 1] = _pRight->Keys[i];
+				for(size_type i = 1; i <= _pRight->Count; i++) _pRight->Children[i - 1] = _pRight->Children[i];
+				--_pRight->Count;
+			} else if(_pLeft != nullptr) {
+				merge_inner(_pLeft, _pNode, parent->Keys[ci - 1]);
+				inner_remove(parent, ci - 1);
+			} else {
+				merge_inner(_pNode, _pRight, parent->Keys[ci]);
+				inner_remove(parent, ci);
+			}
+		}
+
+		/**
+		 * @brief Move all elements of right to the end of left and free right.
+		 */
+		void merge_leaf(leaf_type* left, leaf_type* right) {
+			for(size_type i = 0; i < right->Count; i++) {
+				left->Keys[left->Count + i] = right->Keys[i];
+				left->Values[left->Count + i] = right->Values[i];
+			}
+			left->Count = uint16_t(left->Count + right->Count);
+			left->Next = right->Next;
+			if(right->Next != nullptr) right->Next->Prev = left;
+			else m_pLast = left;
+			delete_node(right);
+		}
+
+		/**
+		 * @brief Move the separator and all keys of right to the end of left and free right.
+		 */
+		void merge_inner(inner_type* left, inner_type* right, const key_type& separator) {
+			left->Keys[left->Count] = separator;
+			for(size_type i = 0; i < right->Count; i++) left->Keys[left->Count + 1 + i] = right->Keys[i];
+			for(size_type i = 0; i <= right->Count; i++) left->Children[left->Count + 1 + i] = right->Children[i];
+			left->Count = uint16_t(left->Count + 1 + right->Count);
+			delete_node(right);
+		}
+
+		/**
+		 * @brief Remove the key at pos and the child right of it.
+		 */
+		void inner_remove(inner_type* inner, size_type pos) {
+			for(size_type i = pos + 1; i < inner->Count; i++) {
+				inner->Keys[i - 1] = inner->Keys[i];
+				inner->Children[i] = inner->Children[i + 1];
+			}
+			--inner->Count;
+		}
+
+		leaf_type* new_leaf() {
+			void* _mem = m_aAllocator.allocate(1, sizeof(leaf_type), alignof(leaf_type));
+			return (_mem == nullptr) ? nullptr : ::new (_mem) leaf_type();
+		}
+		inner_type* new_inner() {
+			void* _mem = m_aAllocator.allocate(1, sizeof(inner_type), alignof(inner_type));
+			return (_mem == nullptr) ? nullptr : ::new (_mem) inner_type();
+		}
+		void delete_node(leaf_type* leaf) {
+			squads::destruct(leaf);
+			m_aAllocator.deallocate(leaf, 1, sizeof(leaf_type), alignof(leaf_type));
+		}
+		void delete_node(inner_type* inner) {
+			squads::destruct(inner);
+			m_aAllocator.deallocate(inner, 1, sizeof(inner_type), alignof(inner_type));
+		}
+
+		void free_subtree(node_type* node) {
+			if(node->IsLeaf) {
+				delete_node(static_cast<leaf_type*>(node));
+				return;
+			}
+			inner_type* _pInner = static_cast<inner_type*>(node);
+			for(size_type i = 0; i <= _pInner->Count; i++) free_subtree(_pInner->Children[i]);
+			delete_node(_pInner);
+		}
+	private:
+		node_type* 		m_pRoot;
+		leaf_type* 		m_pFirst;
+		leaf_type* 		m_pLast;
+		size_type 		m_sSize;
+		size_type 		m_sHeight;
+		key_compare 	m_cCompare;
+		allocator_type 	m_aAllocator;
+	};
+
+	template <typename TKey, typename TValue, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<>, size_t NNodeBytes = 256>
+	using btree_map = basic_btree_map<TKey, TValue, TCompare, TAllocator, NNodeBytes>;
+}
+
+#endif // __SQUADS_BTREE_MAP_H__
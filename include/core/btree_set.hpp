@@ -0,0 +1,137 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_BTREE_SET_H__
+#define __SQUADS_BTREE_SET_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "btree_map.hpp"
+
+namespace squads {
+	namespace internal {
+		/// The value of the keys in a basic_btree_set
+		struct btree_set_value { };
+	}
+
+	/**
+	 * @brief A ordered set as B+ tree.
+	 *
+	 * A thin wrapper around basic_btree_map with a empty value, see there.
+	 *
+	 * @tparam TKey The type of the keys.
+	 * @tparam TCompare The order of the keys, default squads::less<TKey>.
+	 * @tparam TAllocator The allocator for the nodes.
+	 * @tparam NNodeBytes The target size of a node in bytes.
+	 */
+	template <typename TKey, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<>, size_t NNodeBytes = 256>
+	class basic_btree_set {
+		using map_type = basic_btree_map<TKey, internal::btree_set_value, TCompare, TAllocator, NNodeBytes>;
+		using map_iterator = typename map_type::const_iterator;
+	public:
+		using key_type = TKey;
+		using value_type = TKey;
+		using size_type = squads::size_t;
+		using key_compare = TCompare;
+		using allocator_type = TAllocator;
+		using self_type = basic_btree_set<TKey, TCompare, TAllocator, NNodeBytes>;
+
+		/**
+		 * @brief Bidirectional iterator over the keys.
+		 */
+		class const_iterator {
+		public:
+			using iterator_category = squads::bidirectional_iterator_tag;
+			using value_type = TKey;
+			using pointer = const TKey*;
+			using reference = const TKey&;
+			using difference_type = squads::ptrdiff_t;
+
+			const_iterator() : m_itMap() { }
+			explicit const_iterator(map_iterator it) : m_itMap(it) { }
+
+			reference operator*() const 	{ return m_itMap.key(); }
+			pointer operator->() const 		{ return &m_itMap.key(); }
+
+			const_iterator& operator++() 	{ ++m_itMap; return *this; }
+			const_iterator& operator--() 	{ --m_itMap; return *this; }
+			const_iterator operator++(int) 	{ const_iterator _copy(*this); ++m_itMap; return _copy; }
+			const_iterator operator--(int) 	{ const_iterator _copy(*this); --m_itMap; return _copy; }
+
+			bool operator == (const const_iterator& rhs) const { return m_itMap == rhs.m_itMap; }
+			bool operator != (const const_iterator& rhs) const { return m_itMap != rhs.m_itMap; }
+		private:
+			map_iterator m_itMap;
+		};
+		using iterator = const_iterator;
+		using insert_result = squads::pair<iterator, bool>;
+
+		const_iterator begin() const 	{ return const_iterator(m_mapTree.begin()); }
+		const_iterator end() const 		{ return const_iterator(m_mapTree.end()); }
+
+		size_type size() const 		{ return m_mapTree.size(); }
+		bool empty() const 			{ return m_mapTree.empty(); }
+		size_type height() const 	{ return m_mapTree.height(); }
+
+		const_iterator find(const key_type& key) const 			{ return const_iterator(m_mapTree.find(key)); }
+		const_iterator lower_bound(const key_type& key) const 	{ return const_iterator(m_mapTree.lower_bound(key)); }
+		const_iterator upper_bound(const key_type& key) const 	{ return const_iterator(m_mapTree.upper_bound(key)); }
+		bool contains(const key_type& key) const 				{ return m_mapTree.contains(key); }
+		size_type count(const key_type& key) const 				{ return m_mapTree.count(key); }
+
+		/**
+		 * @brief Call fn(key) for all keys with first <= key < last, in order.
+		 * @return The number of visited keys.
+		 */
+		template <class TFn>
+		size_type for_range(const key_type& first, const key_type& last, TFn fn) const {
+			return m_mapTree.for_range(first, last,
+				[&fn](const key_type& key, const internal::btree_set_value&) { fn(key); });
+		}
+
+		/**
+		 * @brief Insert a key, when not in the set.
+		 * @return The iterator to the key and true when inserted. On allocation failure the iterator is end().
+		 */
+		insert_result insert(const key_type& key) {
+			typename map_type::insert_result _ret = m_mapTree.insert(key, internal::btree_set_value());
+			return insert_result(const_iterator(_ret.first()), _ret.second());
+		}
+
+		size_type erase(const key_type& key) 	{ return m_mapTree.erase(key); }
+		void clear() 							{ m_mapTree.clear(); }
+		void swap(self_type& other) 			{ m_mapTree.swap(other.m_mapTree); }
+
+		/**
+		 * @brief Replace the content with count sorted and unique keys.
+		 * @return False on allocation failure, the set is empty then.
+		 */
+		bool bulk_load(const key_type* keys, size_type count) {
+			return m_mapTree.bulk_load(keys, nullptr, count);
+		}
+	private:
+		map_type m_mapTree;
+	};
+
+	template <typename TKey, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<>, size_t NNodeBytes = 256>
+	using btree_set = basic_btree_set<TKey, TCompare, TAllocator, NNodeBytes>;
+}
+
+#endif // __SQUADS_BTREE_SET_H__
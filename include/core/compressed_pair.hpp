@@ -0,0 +1,133 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_BASIC_COMPRESSED_PAIR_H__
+#define __SQUADS_BASIC_COMPRESSED_PAIR_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "ebo_storage.hpp"
+#include "functional.hpp"
+
+#include <utility>
+
+namespace squads {
+	/**
+	 * @brief A pair, that use no space for empty members.
+	 *
+	 * Both members are stored as ebo_storage base, so a empty allocator, comparator or
+	 * deleter next to a pointer costs no byte. Supports get<I> and structured bindings.
+	 *
+	 * @tparam TFirst The type of the first value.
+	 * @tparam TSecond The type of the second value.
+	 */
+	template <typename TFirst, typename TSecond>
+	class basic_compressed_pair : private ebo_storage<TFirst, 0>, private ebo_storage<TSecond, 1> {
+		using first_base = ebo_storage<TFirst, 0>;
+		using second_base = ebo_storage<TSecond, 1>;
+	public:
+		using first_type = TFirst;
+		using second_type = TSecond;
+		using self_type = basic_compressed_pair<TFirst, TSecond>;
+
+		constexpr basic_compressed_pair() : first_base(), second_base() { }
+
+		template <typename U1, typename U2>
+		constexpr basic_compressed_pair(U1&& first, U2&& second)
+			: first_base(squads::forward<U1>(first)), second_base(squads::forward<U2>(second)) { }
+
+		/**
+		 * @brief Construct the first value and default construct the second value.
+		 */
+		template <typename U1, typename = squads::enable_if_t<
+			!squads::is_same<squads::type_t<squads::remove_cvref<U1>>, self_type>::value> >
+		constexpr explicit basic_compressed_pair(U1&& first)
+			: first_base(squads::forward<U1>(first)), second_base() { }
+
+		basic_compressed_pair(const self_type& other) = default;
+		basic_compressed_pair(self_type&& other) = default;
+		self_type& operator = (const self_type& other) = default;
+		self_type& operator = (self_type&& other) = default;
+
+				  TFirst& 		first() noexcept 		{ return first_base::get(); }
+		constexpr const TFirst& first() const noexcept 	{ return first_base::get(); }
+
+				  TSecond& 		 second() noexcept 		 { return second_base::get(); }
+		constexpr const TSecond& second() const noexcept { return second_base::get(); }
+
+		void swap(self_type& other) {
+			squads::swap(first(), other.first());
+			squads::swap(second(), other.second());
+		}
+
+		bool operator == (const self_type& rhs) const {
+			return first() == rhs.first() && second() == rhs.second();
+		}
+		bool operator != (const self_type& rhs) const { return !(*this == rhs); }
+	};
+
+	namespace internal {
+		template <size_t I>
+		struct compressed_pair_get;
+
+		template <>
+		struct compressed_pair_get<0> {
+			template <class TPair>
+			static auto get(TPair& pair) noexcept -> decltype(pair.first()) { return pair.first(); }
+		};
+		template <>
+		struct compressed_pair_get<1> {
+			template <class TPair>
+			static auto get(TPair& pair) noexcept -> decltype(pair.second()) { return pair.second(); }
+		};
+	}
+
+	template <size_t I, typename TFirst, typename TSecond>
+	auto get(basic_compressed_pair<TFirst, TSecond>& pair) noexcept
+		-> decltype(internal::compressed_pair_get<I>::get(pair)) {
+		return internal::compressed_pair_get<I>::get(pair);
+	}
+	template <size_t I, typename TFirst, typename TSecond>
+	auto get(const basic_compressed_pair<TFirst, TSecond>& pair) noexcept
+		-> decltype(internal::compressed_pair_get<I>::get(pair)) {
+		return internal::compressed_pair_get<I>::get(pair);
+	}
+	template <size_t I, typename TFirst, typename TSecond>
+	auto get(basic_compressed_pair<TFirst, TSecond>&& pair) noexcept
+		-> decltype(squads::move(internal::compressed_pair_get<I>::get(pair))) {
+		return squads::move(internal::compressed_pair_get<I>::get(pair));
+	}
+
+	template <typename TFirst, typename TSecond>
+	using compressed_pair = basic_compressed_pair<TFirst, TSecond>;
+}
+
+namespace std {
+	/// Structured bindings for squads::basic_compressed_pair
+	template <typename TFirst, typename TSecond>
+	struct tuple_size< squads::basic_compressed_pair<TFirst, TSecond> >
+		: std::integral_constant<std::size_t, 2> { };
+
+	template <typename TFirst, typename TSecond>
+	struct tuple_element<0, squads::basic_compressed_pair<TFirst, TSecond> > { using type = TFirst; };
+	template <typename TFirst, typename TSecond>
+	struct tuple_element<1, squads::basic_compressed_pair<TFirst, TSecond> > { using type = TSecond; };
+}
+
+#endif // __SQUADS_BASIC_COMPRESSED_PAIR_H__
@@ -0,0 +1,527 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_CONCURRENT_HASH_MAP_H__
+#define __SQUADS_CONCURRENT_HASH_MAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "allocator.hpp"
+#include "algorithm.hpp"
+#include "hash.hpp"
+#include "seqlock.hpp"
+#include "spinlock.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+#include "atomic/atomic.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief Lock a lock of the squads lock interface for the scope.
+		 */
+		template <class TLock>
+		class concurrent_lock_guard {
+		public:
+			explicit concurrent_lock_guard(TLock& lock) : m_refLock(lock) { m_refLock.lock(SQUADS_PORTMAX_DELAY); }
+			~concurrent_lock_guard() { m_refLock.unlock(); }
+
+			concurrent_lock_guard(const concurrent_lock_guard&) = delete;
+			concurrent_lock_guard& operator = (const concurrent_lock_guard&) = delete;
+		private:
+			TLock& m_refLock;
+		};
+	}
+
+	/**
+	 * @brief A hash map for more tasks, with striped locks for the writers and seqlock reads.
+	 *
+	 * The upper bits of the hash select one of NStripes stripes. Each stripe is a own
+	 * Robin Hood table with a lock for the writers and a basic_seqlock, so writers on
+	 * different stripes never wait for each other and find() never takes a lock.
+	 *
+	 * A full stripe grows without stop-the-world: a table with the double capacity is installed
+	 * and each following write on the stripe moves a few elements from the old table, lookups
+	 * search both tables meanwhile. Replaced tables are retired: each stripe counts the readers
+	 * in find(), and the next write on the stripe frees the retired tables, when no reader is in
+	 * the stripe after the table was unlinked (a reader that comes later can not see it anymore).
+	 *
+	 * @tparam TKey The type of the keys, must be trivially copyable.
+	 * @tparam TValue The type of the values, must be trivially copyable.
+	 * @tparam NStripes The number of stripes, a power of two and at least 2.
+	 * @tparam THash The hasher, default squads::hash<TKey>.
+	 * @tparam TEqual The key compare, default squads::equal_to<TKey>.
+	 * @tparam TLock The lock of a stripe, a type of the squads lock interface.
+	 * @tparam TAllocator The allocator for the tables.
+	 */
+	template <typename TKey, typename TValue, size_t NStripes = 16,
+			  class THash = squads::hash<TKey>, class TEqual = squads::equal_to<TKey>,
+			  class TLock = squads::basic_spinlock<bool>, class TAllocator = squads::default_allocator<> >
+	class basic_concurrent_hash_map {
+		static_assert(NStripes >= 2 && (NStripes & (NStripes - 1)) == 0,
+			"basic_concurrent_hash_map: NStripes must be a power of two and at least 2");
+		static_assert(squads::is_trivially_copyable<TKey>::value, "basic_concurrent_hash_map: the key must be trivially copyable");
+		static_assert(squads::is_trivially_copyable<TValue>::value, "basic_concurrent_hash_map: the value must be trivially copyable");
+	public:
+		using key_type = TKey;
+		using mapped_type = TValue;
+		using size_type = squads::size_t;
+		using hasher = THash;
+		using key_equal = TEqual;
+		using lock_type = TLock;
+		using allocator_type = TAllocator;
+		using self_type = basic_concurrent_hash_map<TKey, TValue, NStripes, THash, TEqual, TLock, TAllocator>;
+
+		static constexpr size_type StripeCount = NStripes;
+		/// The capacity of the first table of a stripe
+		static constexpr size_type InitialCapacity = 8;
+		/// The number of old slots, that each write moves while a stripe grows
+		static constexpr size_type MigrateStep = 8;
+	private:
+		/// Marks a element of a old table, that was moved or erased
+		static constexpr uint32_t MovedBit = 0x80000000u;
+
+		struct slot {
+			/// The probe distance + 1, 0 is a empty slot
+			uint32_t Dist;
+			key_type Key;
+			mapped_type Value;
+		};
+		struct table {
+			size_type Capacity;
+			slot* Slots;
+			table* NextRetired;
+		};
+		struct alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) stripe {
+			basic_seqlock<unsigned int> Seq;
+			/// The lock of the writers, mutable for the snapshot in for_each()
+			mutable lock_type Lock;
+			atomic::_atomic_ptr<table> Current;
+			/// The table, that is moved to Current, or nullptr
+			atomic::_atomic_ptr<table> Old;
+			atomic::_atomic<size_type> Size;
+			/// The number of readers in find(), the retired tables are freed only when it is 0
+			mutable atomic::_atomic<unsigned int> Readers;
+			size_type CurrentSize;
+			size_type MigratePos;
+			table* Retired;
+
+			stripe() : Seq(), Lock(), Current(nullptr), Old(nullptr), Size(0), Readers(0),
+				CurrentSize(0), MigratePos(0), Retired(nullptr) { }
+		};
+		/// Count a reader of a stripe for the scope, the tables it loads are not freed meanwhile.
+		class read_guard {
+		public:
+			explicit read_guard(const stripe& s) : m_refStripe(s) {
+				// Acquire, so the table pointers are loaded after the reader is counted
+				m_refStripe.Readers.fetch_add(1, atomic::memory_order::Acquire);
+			}
+			~read_guard() {
+				// Release, so all reads of the tables are done before a writer sees 0
+				m_refStripe.Readers.fetch_sub(1, atomic::memory_order::Release);
+			}
+
+			read_guard(const read_guard&) = delete;
+			read_guard& operator = (const read_guard&) = delete;
+		private:
+			const stripe& m_refStripe;
+		};
+		using guard_type = internal::concurrent_lock_guard<lock_type>;
+		using write_guard = typename basic_seqlock<unsigned int>::write_guard;
+	public:
+		basic_concurrent_hash_map() : m_aAllocator() { }
+		~basic_concurrent_hash_map() {
+			for(size_type i = 0; i < StripeCount; i++) {
+				stripe& _stripe = m_aStripes[i];
+				free_table(_stripe.Current.load(atomic::memory_order::Relaxed));
+				free_table(_stripe.Old.load(atomic::memory_order::Relaxed));
+				free_retired(_stripe);
+			}
+		}
+
+		basic_concurrent_hash_map(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		constexpr size_type stripe_count() const { return StripeCount; }
+
+		/**
+		 * @brief Get the number of elements, only a snapshot when other tasks write.
+		 */
+		size_type size() const {
+			size_type _size = 0;
+			for(size_type i = 0; i < StripeCount; i++) _size += m_aStripes[i].Size.load(atomic::memory_order::Relaxed);
+			return _size;
+		}
+		bool empty() const { return size() == 0; }
+
+		/**
+		 * @brief Find the value of key, without lock.
+		 * @param key The key to find.
+		 * @param value The value of the key is copied to this, when found.
+		 * @return True when the key was found.
+		 */
+		bool find(const key_type& key, mapped_type& value) const {
+			result_type _hash = hash_of(key);
+			const stripe& _stripe = stripe_of(_hash);
+			const slot* _pSlot = nullptr;
+			mapped_type _value;
+			unsigned int _seq;
+			read_guard _reader(_stripe);
+
+			do {
+				_seq = _stripe.Seq.read_begin();
+				if(_stripe.Seq.is_write_pending(_seq)) continue;
+
+				// Acquire, so a new table is seen initialized
+				_pSlot = find_slot(_stripe.Current.load(atomic::memory_order::Acquire), key, _hash);
+				if(_pSlot == nullptr) _pSlot = find_slot(_stripe.Old.load(atomic::memory_order::Acquire), key, _hash);
+				if(_pSlot != nullptr) _value = _pSlot->Value;
+			} while(_stripe.Seq.read_retry(_seq));
+
+			if(_pSlot == nullptr) return false;
+			value = _value;
+			return true;
+		}
+
+		bool contains(const key_type& key) const {
+			mapped_type _value;
+			return find(key, _value);
+		}
+
+		/**
+		 * @brief Insert a key/value, when the key is not in the map.
+		 * @return False when the key exist or on allocation failure.
+		 */
+		bool insert(const key_type& key, const mapped_type& value) {
+			return put(key, value, false);
+		}
+
+		/**
+		 * @brief Insert a key/value or overwrite the value of an existing key.
+		 * @return False on allocation failure.
+		 */
+		bool insert_or_assign(const key_type& key, const mapped_type& value) {
+			return put(key, value, true);
+		}
+
+		/**
+		 * @brief Change the value of key in place, with fn(value&) under the lock of the stripe.
+		 * @return False when the key is not in the map.
+		 */
+		template <class TFn>
+		bool update(const key_type& key, TFn fn) {
+			result_type _hash = hash_of(key);
+			stripe& _stripe = stripe_of(_hash);
+			guard_type _guard(_stripe.Lock);
+
+			slot* _pSlot = find_slot(_stripe.Current.load(atomic::memory_order::Relaxed), key, _hash);
+			if(_pSlot == nullptr) _pSlot = find_slot(_stripe.Old.load(atomic::memory_order::Relaxed), key, _hash);
+			if(_pSlot == nullptr) return false;
+
+			mapped_type _value = _pSlot->Value;
+			fn(_value);
+
+			write_guard _write(_stripe.Seq);
+			_pSlot->Value = _value;
+			return true;
+		}
+
+		/**
+		 * @brief Erase the element with the given key.
+		 * @return True when the key was erased.
+		 */
+		bool erase(const key_type& key) {
+			result_type _hash = hash_of(key);
+			stripe& _stripe = stripe_of(_hash);
+			guard_type _guard(_stripe.Lock);
+			write_guard _write(_stripe.Seq);
+
+			table* _pCurrent = _stripe.Current.load(atomic::memory_order::Relaxed);
+			table* _pOld = _stripe.Old.load(atomic::memory_order::Relaxed);
+			slot* _pSlot;
+
+			if( (_pSlot = find_slot(_pCurrent, key, _hash)) != nullptr) {
+				erase_slot(_pCurrent, size_type(_pSlot - _pCurrent->Slots));
+				--_stripe.CurrentSize;
+			} else if( (_pSlot = find_slot(_pOld, key, _hash)) != nullptr) {
+				_pSlot->Dist |= MovedBit;
+			} else {
+				return false;
+			}
+			_stripe.Size.store(_stripe.Size.load(atomic::memory_order::Relaxed) - 1, atomic::memory_order::Relaxed);
+			migrate(_stripe, MigrateStep);
+			return true;
+		}
+
+		/**
+		 * @brief Remove all elements, the tables are retired.
+		 */
+		void clear() {
+			for(size_type i = 0; i < StripeCount; i++) {
+				stripe& _stripe = m_aStripes[i];
+				guard_type _guard(_stripe.Lock);
+				write_guard _write(_stripe.Seq);
+
+				retire(_stripe, _stripe.Current.load(atomic::memory_order::Relaxed));
+				retire(_stripe, _stripe.Old.load(atomic::memory_order::Relaxed));
+				_stripe.Current.store(nullptr, atomic::memory_order::Relaxed);
+				_stripe.Old.store(nullptr, atomic::memory_order::Relaxed);
+				_stripe.Size.store(0, atomic::memory_order::Relaxed);
+				_stripe.CurrentSize = 0;
+				try_free_retired(_stripe);
+			}
+		}
+
+		/**
+		 * @brief Free the retired tables of all stripes without a reader.
+		 *
+		 * The writes free them too, so this is only needed to give the memory back
+		 * after the last write, when readers were active at that time.
+		 */
+		void reclaim() {
+			for(size_type i = 0; i < StripeCount; i++) {
+				guard_type _guard(m_aStripes[i].Lock);
+				try_free_retired(m_aStripes[i]);
+			}
+		}
+
+		/**
+		 * @brief Call fn(key, value) for all elements.
+		 *
+		 * Each stripe is locked while his elements are visited, so fn sees a consistent
+		 * snapshot of each stripe. fn must not change the map.
+		 */
+		template <class TFn>
+		TFn for_each(TFn fn) const {
+			for(size_type i = 0; i < StripeCount; i++) {
+				const stripe& _stripe = m_aStripes[i];
+				guard_type _guard(_stripe.Lock);
+
+				visit(_stripe.Current.load(atomic::memory_order::Relaxed), fn);
+				visit(_stripe.Old.load(atomic::memory_order::Relaxed), fn);
+			}
+			return fn;
+		}
+	private:
+		static result_type hash_of(const key_type& key) {
+			return internal::hash_mix(hasher()(key));
+		}
+		stripe& stripe_of(result_type hash) {
+			return m_aStripes[(hash >> (sizeof(result_type) * 8 - StripeBits)) & (StripeCount - 1)];
+		}
+		const stripe& stripe_of(result_type hash) const {
+			return m_aStripes[(hash >> (sizeof(result_type) * 8 - StripeBits)) & (StripeCount - 1)];
+		}
+
+		/// Find key in a table, moved elements of a old table are skipped.
+		static slot* find_slot(table* t, const key_type& key, result_type hash) {
+			if(t == nullptr) return nullptr;
+
+			size_type _mask = t->Capacity - 1;
+			size_type _index = size_type(hash) & _mask;
+			key_equal _equal;
+
+			for(uint32_t _dist = 1; _dist <= t->Capacity; _dist++) {
+				slot& _slot = t->Slots[_index];
+				uint32_t _slotDist = _slot.Dist & ~MovedBit;
+
+				if(_slotDist < _dist) return nullptr;
+				if(_slotDist == _dist && (_slot.Dist & MovedBit) == 0 && _equal(_slot.Key, key)) return &_slot;
+
+				_index = (_index + 1) & _mask;
+			}
+			return nullptr;
+		}
+
+		bool put(const key_type& key, const mapped_type& value, bool assign) {
+			result_type _hash = hash_of(key);
+			stripe& _stripe = stripe_of(_hash);
+			guard_type _guard(_stripe.Lock);
+
+			table* _pCurrent = _stripe.Current.load(atomic::memory_order::Relaxed);
+			slot* _pSlot = find_slot(_pCurrent, key, _hash);
+			if(_pSlot != nullptr) {
+				if(!assign) return false;
+
+				write_guard _write(_stripe.Seq);
+				_pSlot->Value = value;
+				migrate(_stripe, MigrateStep);
+				return true;
+			}
+
+			slot* _pOld = find_slot(_stripe.Old.load(atomic::memory_order::Relaxed), key, _hash);
+			if(_pOld != nullptr && !assign) return false;
+			if(!reserve_one(_stripe)) return false;
+
+			write_guard _write(_stripe.Seq);
+			if(_pOld != nullptr) {
+				// The key is moved to the current table with the new value.
+				_pOld->Dist |= MovedBit;
+			} else {
+				_stripe.Size.store(_stripe.Size.load(atomic::memory_order::Relaxed) + 1, atomic::memory_order::Relaxed);
+			}
+			insert_slot(_stripe.Current.load(atomic::memory_order::Relaxed), key, value, _hash);
+			++_stripe.CurrentSize;
+			migrate(_stripe, MigrateStep);
+			return true;
+		}
+
+		/// Make room for one more element in the current table, install a larger table when needed.
+		bool reserve_one(stripe& s) {
+			table* _pCurrent = s.Current.load(atomic::memory_order::Relaxed);
+			if(_pCurrent != nullptr && (s.CurrentSize + 1) * 4 <= _pCurrent->Capacity * 3) return true;
+
+			table* _pTable = alloc_table(_pCurrent == nullptr ? InitialCapacity : _pCurrent->Capacity * 2);
+			if(_pTable == nullptr) return _pCurrent != nullptr && s.CurrentSize + 1 < _pCurrent->Capacity;
+
+			write_guard _write(s.Seq);
+			if(s.Old.load(atomic::memory_order::Relaxed) != nullptr) migrate(s, npos());
+
+			s.Old.store(_pCurrent, atomic::memory_order::Release);
+			s.Current.store(_pTable, atomic::memory_order::Release);
+			s.CurrentSize = 0;
+			s.MigratePos = 0;
+			if(_pCurrent == nullptr) return true;
+
+			migrate(s, MigrateStep);
+			return true;
+		}
+
+		/// Move up to count slots of the old table to the current table, then free the retired tables when possible.
+		void migrate(stripe& s, size_type count) {
+			table* _pOld = s.Old.load(atomic::memory_order::Relaxed);
+			if(_pOld == nullptr) { try_free_retired(s); return; }
+
+			table* _pCurrent = s.Current.load(atomic::memory_order::Relaxed);
+			for(; count > 0 && s.MigratePos < _pOld->Capacity; --count, ++s.MigratePos) {
+				slot& _slot = _pOld->Slots[s.MigratePos];
+				if(_slot.Dist == 0 || (_slot.Dist & MovedBit) != 0) continue;
+
+				insert_slot(_pCurrent, _slot.Key, _slot.Value, hash_of(_slot.Key));
+				++s.CurrentSize;
+				_slot.Dist |= MovedBit;
+			}
+			if(s.MigratePos == _pOld->Capacity) {
+				s.Old.store(nullptr, atomic::memory_order::Relaxed);
+				retire(s, _pOld);
+			}
+			try_free_retired(s);
+		}
+
+		static void insert_slot(table* t, const key_type& key, const mapped_type& value, result_type hash) {
+			size_type _mask = t->Capacity - 1;
+			size_type _index = size_type(hash) & _mask;
+			slot _entry = { 1, key, value };
+
+			while(true) {
+				slot& _slot = t->Slots[_index];
+				if(_slot.Dist == 0) { _slot = _entry; return; }
+
+				// Robin Hood: take the slot from a richer element.
+				if(_slot.Dist < _entry.Dist) squads::swap(_entry, _slot);
+				_index = (_index + 1) & _mask;
+				++_entry.Dist;
+			}
+		}
+
+		static void erase_slot(table* t, size_type index) {
+			size_type _mask = t->Capacity - 1;
+			size_type _next = (index + 1) & _mask;
+
+			// Backward shift the chain behind the erased slot.
+			while(t->Slots[_next].Dist > 1) {
+				t->Slots[index] = t->Slots[_next];
+				--t->Slots[index].Dist;
+				index = _next;
+				_next = (_next + 1) & _mask;
+			}
+			t->Slots[index].Dist = 0;
+		}
+
+		template <class TFn>
+		static void visit(const table* t, TFn& fn) {
+			if(t == nullptr) return;
+			for(size_type i = 0; i < t->Capacity; i++) {
+				const slot& _slot = t->Slots[i];
+				if(_slot.Dist != 0 && (_slot.Dist & MovedBit) == 0) fn(_slot.Key, _slot.Value);
+			}
+		}
+
+		table* alloc_table(size_type capacity) {
+			table* _pTable = static_cast<table*>(m_aAllocator.allocate(1, sizeof(table), alignof(table)));
+			if(_pTable == nullptr) return nullptr;
+
+			_pTable->Slots = static_cast<slot*>(m_aAllocator.allocate(capacity, sizeof(slot), alignof(slot)));
+			if(_pTable->Slots == nullptr) {
+				m_aAllocator.deallocate(_pTable, 1, sizeof(table), alignof(table));
+				return nullptr;
+			}
+			for(size_type i = 0; i < capacity; i++) _pTable->Slots[i].Dist = 0;
+			_pTable->Capacity = capacity;
+			_pTable->NextRetired = nullptr;
+			return _pTable;
+		}
+
+		void free_table(table* t) {
+			if(t == nullptr) return;
+			m_aAllocator.deallocate(t->Slots, t->Capacity, sizeof(slot), alignof(slot));
+			m_aAllocator.deallocate(t, 1, sizeof(table), alignof(table));
+		}
+
+		static void retire(stripe& s, table* t) {
+			if(t == nullptr) return;
+			t->NextRetired = s.Retired;
+			s.Retired = t;
+		}
+
+		/**
+		 * Free the retired tables, when no reader is in the stripe. Must be called under the lock
+		 * of the stripe and after the tables are unlinked. The read-modify-write is ordered with
+		 * the counting of the readers: a reader counted later sees the unlinked tables, a reader
+		 * counted before is not done, so the count is not 0.
+		 */
+		void try_free_retired(stripe& s) {
+			if(s.Retired == nullptr) return;
+			if(s.Readers.fetch_add(0, atomic::memory_order::AcqRel) != 0) return;
+			free_retired(s);
+		}
+
+		void free_retired(stripe& s) {
+			while(s.Retired != nullptr) {
+				table* _pNext = s.Retired->NextRetired;
+				free_table(s.Retired);
+				s.Retired = _pNext;
+			}
+		}
+
+		static constexpr size_type npos() { return size_type(-1); }
+		static constexpr unsigned int log2(size_type n) { return (n <= 1) ? 0 : 1 + log2(n / 2); }
+
+		static constexpr unsigned int StripeBits = log2(NStripes);
+	private:
+		stripe m_aStripes[NStripes];
+		allocator_type m_aAllocator;
+	};
+
+	template <typename TKey, typename TValue, size_t NStripes = 16,
+			  class THash = squads::hash<TKey>, class TEqual = squads::equal_to<TKey>,
+			  class TLock = squads::basic_spinlock<bool>, class TAllocator = squads::default_allocator<> >
+	using concurrent_hash_map = basic_concurrent_hash_map<TKey, TValue, NStripes, THash, TEqual, TLock, TAllocator>;
+}
+
+#endif // __SQUADS_CONCURRENT_HASH_MAP_H__
@@ -0,0 +1,211 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_D_ARY_HEAP_H__
+#define __SQUADS_D_ARY_HEAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "utils.hpp"
+#include "flat_map.hpp"
+#include "compressed_pair.hpp"
+
+namespace squads {
+	/**
+	 * @brief A priority queue as implicit heap with D children per node in one contiguous array.
+	 *
+	 * With D = 4 the children of a node share one or two cache lines, the tree is half as
+	 * high as a binary heap and pop() needs less cache misses, push() is cheaper too.
+	 * top() is the first element in the order of TCompare, so squads::less gives a min heap
+	 * and squads::greater a max heap.
+	 *
+	 * @tparam T The type of the elements.
+	 * @tparam D The number of children per node, default 4.
+	 * @tparam TCompare The order of the elements, default squads::less<T>.
+	 * @tparam TAllocator The allocator for the array.
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename T, size_t D = 4, class TCompare = squads::less<T>,
+			  class TAllocator = squads::default_allocator<> >
+	class basic_d_ary_heap {
+		static_assert(D >= 2, "basic_d_ary_heap: D must be at least 2");
+		using array_type = internal::flat_array<T, TAllocator>;
+	public:
+		using value_type = T;
+		using size_type = squads::size_t;
+		using value_compare = TCompare;
+		using allocator_type = TAllocator;
+		using self_type = basic_d_ary_heap<T, D, TCompare, TAllocator>;
+
+		static constexpr size_type Arity = D;
+
+		basic_d_ary_heap() : m_pairHeap() { }
+
+		/**
+		 * @brief Construct the heap from count elements.
+		 * @see assign
+		 */
+		basic_d_ary_heap(const value_type* values, size_type count)
+			: basic_d_ary_heap() { assign(values, count); }
+
+		basic_d_ary_heap(const self_type& other)
+			: m_pairHeap(other.m_pairHeap) { }
+
+		basic_d_ary_heap(self_type&& other) : basic_d_ary_heap() { swap(other); }
+
+		self_type& operator = (const self_type& other) {
+			if(this != &other) { self_type _copy(other); swap(_copy); }
+			return *this;
+		}
+		self_type& operator = (self_type&& other) { swap(other); return *this; }
+
+		size_type size() const 		{ return heap().size(); }
+		bool empty() const 			{ return size() == 0; }
+		size_type capacity() const 	{ return heap().capacity(); }
+
+		/**
+		 * @brief Get the elements in heap order.
+		 */
+		const value_type* data() const { return heap().data(); }
+
+		/**
+		 * @brief Reserve space for count elements.
+		 * @return False on allocation failure.
+		 */
+		bool reserve(size_type count) { return heap().reserve(count); }
+
+		/**
+		 * @brief Get the first element in the order of TCompare.
+		 */
+		const value_type& top() const {
+			assert(!empty());
+			return heap()[0];
+		}
+
+		/**
+		 * @brief Add a element.
+		 * @return False on allocation failure.
+		 */
+		bool push(const value_type& value) {
+			if(!heap().push_back(value)) return false;
+			sift_up(size() - 1);
+			return true;
+		}
+
+		/**
+		 * @brief Remove the top element.
+		 */
+		void pop() {
+			assert(!empty());
+			size_type _last = size() - 1;
+
+			if(_last != 0) {
+				value_type _value = heap()[_last];
+				heap().truncate(_last);
+				sift_down(0, _value);
+			} else {
+				heap().truncate(0);
+			}
+		}
+
+		/**
+		 * @brief Copy and remove the top element.
+		 * @return False when the heap is empty.
+		 */
+		bool pop(value_type& value) {
+			if(empty()) return false;
+			value = heap()[0];
+			pop();
+			return true;
+		}
+
+		/**
+		 * @brief Replace the content with count elements, the heap is build in O(n).
+		 * @return False on allocation failure, the heap is empty then.
+		 */
+		bool assign(const value_type* values, size_type count) {
+			clear();
+			if(!reserve(count)) return false;
+
+			for(size_type i = 0; i < count; i++) heap().push_back(values[i]);
+			if(count < 2) return true;
+
+			for(size_type i = (count - 2) / Arity + 1; i-- > 0; ) {
+				value_type _value = heap()[i];
+				sift_down(i, _value);
+			}
+			return true;
+		}
+
+		void clear() { heap().clear(); }
+
+		void swap(self_type& other) {
+			heap().swap(other.heap());
+			squads::swap(compare(), other.compare());
+		}
+	private:
+		/// Move the element at index up, until the parent is not after it.
+		void sift_up(size_type index) {
+			value_type _value = heap()[index];
+
+			while(index > 0) {
+				size_type _parent = (index - 1) / Arity;
+				if(!compare()(_value, heap()[_parent])) break;
+
+				heap()[index] = heap()[_parent];
+				index = _parent;
+			}
+			heap()[index] = _value;
+		}
+
+		/// Fill the hole at index with value, the first child moves up until value fit.
+		void sift_down(size_type index, const value_type& value) {
+			const size_type _size = size();
+
+			for(;;) {
+				size_type _child = index * Arity + 1;
+				if(_child >= _size) break;
+
+				size_type _end = squads::min(_child + Arity, _size);
+				size_type _best = _child;
+				for(size_type i = _child + 1; i < _end; i++) {
+					if(compare()(heap()[i], heap()[_best])) _best = i;
+				}
+				if(!compare()(heap()[_best], value)) break;
+
+				heap()[index] = heap()[_best];
+				index = _best;
+			}
+			heap()[index] = value;
+		}
+
+		array_type& heap() 				{ return m_pairHeap.first(); }
+		const array_type& heap() const 	{ return m_pairHeap.first(); }
+		value_compare& compare() 		{ return m_pairHeap.second(); }
+	private:
+		/// The array and the comparator, a empty comparator use no space
+		basic_compressed_pair<array_type, value_compare> m_pairHeap;
+	};
+
+	template <typename T, size_t D = 4, class TCompare = squads::less<T>,
+			  class TAllocator = squads::default_allocator<> >
+	using d_ary_heap = basic_d_ary_heap<T, D, TCompare, TAllocator>;
+}
+
+#endif // __SQUADS_D_ARY_HEAP_H__
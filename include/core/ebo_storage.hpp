@@ -22,7 +22,16 @@
 #include "functional.hpp"
 
 namespace squads {
-	
+	/**
+	 * @brief Storage for a member, that use no space when the type is empty.
+	 *
+	 * Empty and not final classes are stored as base class, all other types as member.
+	 * Only a base class can use the empty base optimization, so derive from it
+	 * and use TAG to store the same type more times.
+	 *
+	 * @tparam T The type of the value.
+	 * @tparam TAG A tag to make the storage type unique.
+	 */
 	template <typename T, int TAG = 0, typename = void>
 	class ebo_storage {
 	public:
@@ -30,10 +39,14 @@ namespace squads {
 		using reference = T&;
 		using const_reference = const T&;
 
-		constexpr ebo_storage() = default;
+		constexpr ebo_storage() : m_iItem() { }
 
-		template<typename U>
-		constexpr ebo_storage(U&& u) noexcept : m_iItem(squads::forward(u) ) {}
+		template<typename U, typename = squads::enable_if_t<
+			!squads::is_same<squads::type_t<squads::remove_cvref<U>>, ebo_storage>::value> >
+		constexpr ebo_storage(U&& u) noexcept : m_iItem(squads::forward<U>(u) ) {}
+
+		ebo_storage(const ebo_storage& other) = default;
+		ebo_storage(ebo_storage&& other) = default;
 
 				  		reference get() noexcept 		{ return m_iItem; }
 		constexpr const_reference get() const noexcept 	{ return m_iItem; }
@@ -45,21 +58,28 @@ namespace squads {
 	};
 
 	template <typename T, int TAG>
-	class ebo_storage<T, TAG, squads::enable_if_t<squads::is_class<T>::value>> : private T {
+	class ebo_storage<T, TAG, squads::enable_if_t<squads::is_empty<T>::value && !squads::is_final<T>::value>>
+		: private T {
 		using base_type = T;
 	public:
 		using value_type = T;
 		using reference = T&;
 		using const_reference = const T&;
 
-		using base_type::T;
+		constexpr ebo_storage() : base_type() { }
+
+		template<typename U, typename = squads::enable_if_t<
+			!squads::is_same<squads::type_t<squads::remove_cvref<U>>, ebo_storage>::value> >
+		constexpr ebo_storage(U&& u) noexcept : base_type(squads::forward<U>(u) ) {}
 
-		constexpr ebo_storage() = default;
-		constexpr ebo_storage(const_reference type)  : base_type(type) { }
-		constexpr ebo_storage(const T&& type) 		 : base_type(squads::move(type)) { }
+		ebo_storage(const ebo_storage& other) = default;
+		ebo_storage(ebo_storage&& other) = default;
 
 				  reference 	  get() noexcept 		{ return *this; }
 		constexpr const_reference get() const noexcept 	{ return *this; }
+
+		ebo_storage& operator=( const ebo_storage& other ) = default;
+        ebo_storage& operator=( ebo_storage&& other ) = default;
 	};
 }
 #endif // __SQUADS_EBO_STORAGE_H__
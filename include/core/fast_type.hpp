@@ -108,9 +108,9 @@ namespace squads {
          * @return The count of bits to set to 1
          */
         unsigned int count() {
-            unsigned int i;
-            for(int j = 0; j < Bits; j++)
-                i += bits[i].bit;
+            unsigned int i = 0;
+            for(size_t j = 0; j < Bits; j++)
+                i += bits[j].bit;
             return i;
         }
         /**
@@ -0,0 +1,247 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_FIXED_STRING_H__
+#define __SQUADS_FIXED_STRING_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include <string.h>
+
+#include "hash.hpp"
+#include "string_view.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief Compare two strings with known length.
+		 * @return Less then 0, 0 or greater then 0, like memcmp.
+		 */
+		inline int string_compare(const char* lhs, size_t lhsLength,
+								  const char* rhs, size_t rhsLength) noexcept {
+			size_t _length = lhsLength < rhsLength ? lhsLength : rhsLength;
+			int _ret = (_length == 0) ? 0 : memcmp(lhs, rhs, _length);
+			if(_ret != 0) return _ret;
+			return (lhsLength < rhsLength) ? -1 : (lhsLength > rhsLength ? 1 : 0);
+		}
+	}
+
+	/**
+	 * @brief A string with a fixed capacity of N chars, that never use the heap.
+	 *
+	 * The length is stored, so size() and compare() never scan for the terminating zero.
+	 * The hash is computed on first use and cached until the string is changed.
+	 *
+	 * @tparam N The maximal number of chars, without the terminating zero.
+	 */
+	template <size_t N>
+	class basic_fixed_string {
+	public:
+		using value_type = char;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using iterator = const char*;
+		using const_iterator = const char*;
+		using self_type = basic_fixed_string<N>;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+		basic_fixed_string() noexcept : m_sLength(0), m_hHash(0) { m_aData[0] = '\0'; }
+
+		/**
+		 * @brief Construct from a zero terminated string, truncated to N chars.
+		 */
+		basic_fixed_string(const char* str) noexcept : basic_fixed_string() { append(str); }
+
+		/**
+		 * @brief Construct from length chars of str, truncated to N chars.
+		 */
+		basic_fixed_string(const char* str, size_type length) noexcept
+			: basic_fixed_string() { append(str, length); }
+
+		const char* c_str() const noexcept 	{ return m_aData; }
+		const char* data() const noexcept 	{ return m_aData; }
+
+		operator string_view() const noexcept { return string_view(m_aData, m_sLength); }
+
+		size_type size() const noexcept 		{ return m_sLength; }
+		size_type length() const noexcept 		{ return m_sLength; }
+		size_type capacity() const noexcept 	{ return N; }
+		size_type free_space() const noexcept 	{ return N - m_sLength; }
+		bool empty() const noexcept 			{ return m_sLength == 0; }
+		bool full() const noexcept 				{ return m_sLength == N; }
+
+		const_iterator begin() const noexcept 	{ return m_aData; }
+		const_iterator end() const noexcept 	{ return m_aData + m_sLength; }
+
+		char operator[](size_type pos) const noexcept { assert(pos < m_sLength); return m_aData[pos]; }
+
+		char front() const noexcept 	{ assert(m_sLength > 0); return m_aData[0]; }
+		char back() const noexcept 		{ assert(m_sLength > 0); return m_aData[m_sLength - 1]; }
+
+		/**
+		 * @brief Set the char at pos.
+		 */
+		void set(size_type pos, char ch) noexcept {
+			assert(pos < m_sLength);
+			m_aData[pos] = ch; m_hHash = 0;
+		}
+
+		void clear() noexcept { m_sLength = 0; m_aData[0] = '\0'; m_hHash = 0; }
+
+		/**
+		 * @brief Replace the content with length chars of str, str can point into this string.
+		 * @return False when the string was truncated.
+		 */
+		bool assign(const char* str, size_type length) noexcept {
+			bool _bFit = length <= N;
+			if(!_bFit) length = N;
+
+			if(length > 0) memmove(m_aData, str, length);
+			m_sLength = length;
+			m_aData[m_sLength] = '\0';
+			m_hHash = 0;
+			return _bFit;
+		}
+		bool assign(const char* str) noexcept {
+			if(str == nullptr) { clear(); return true; }
+			return assign(str, strlen(str));
+		}
+
+		/**
+		 * @brief Append length chars of str.
+		 * @return False when the string was truncated to the capacity.
+		 */
+		bool append(const char* str, size_type length) noexcept {
+			bool _bFit = length <= free_space();
+			if(!_bFit) length = free_space();
+
+			if(length > 0) memcpy(m_aData + m_sLength, str, length);
+			m_sLength += length;
+			m_aData[m_sLength] = '\0';
+			m_hHash = 0;
+			return _bFit;
+		}
+		bool append(const char* str) noexcept {
+			return (str == nullptr) ? true : append(str, strlen(str));
+		}
+		template <size_t M>
+		bool append(const basic_fixed_string<M>& str) noexcept {
+			return append(str.data(), str.size());
+		}
+
+		bool append(const string_view& str) noexcept {
+			return append(str.data(), str.size());
+		}
+
+		bool push_back(char ch) noexcept { return append(&ch, 1); }
+
+		void pop_back() noexcept {
+			assert(m_sLength > 0);
+			m_aData[--m_sLength] = '\0'; m_hHash = 0;
+		}
+
+		/**
+		 * @brief Shrink the string to length chars.
+		 */
+		void truncate(size_type length) noexcept {
+			if(length >= m_sLength) return;
+			m_sLength = length; m_aData[m_sLength] = '\0'; m_hHash = 0;
+		}
+
+		self_type& operator += (const char* str) noexcept 	{ append(str); return *this; }
+		self_type& operator += (char ch) noexcept 			{ push_back(ch); return *this; }
+		template <size_t M>
+		self_type& operator += (const basic_fixed_string<M>& str) noexcept { append(str); return *this; }
+
+		/**
+		 * @brief Compare with length chars of str.
+		 * @return Less then 0, 0 or greater then 0, like memcmp.
+		 */
+		int compare(const char* str, size_type length) const noexcept {
+			return internal::string_compare(m_aData, m_sLength, str, length);
+		}
+		int compare(const char* str) const noexcept {
+			return compare(str, strlen(str));
+		}
+		template <size_t M>
+		int compare(const basic_fixed_string<M>& str) const noexcept {
+			return compare(str.data(), str.size());
+		}
+
+		/**
+		 * @brief Find the first ch at or after pos.
+		 * @return The position or npos when not found.
+		 */
+		size_type find(char ch, size_type pos = 0) const noexcept {
+			if(pos >= m_sLength) return npos;
+			const void* _pFound = memchr(m_aData + pos, ch, m_sLength - pos);
+			return (_pFound == nullptr) ? npos : size_type(static_cast<const char*>(_pFound) - m_aData);
+		}
+
+		bool starts_with(const char* str, size_type length) const noexcept {
+			return length <= m_sLength && memcmp(m_aData, str, length) == 0;
+		}
+
+		/**
+		 * @brief Get the hash of the string, computed on first use.
+		 */
+		result_type hash() const noexcept {
+			return internal::string_hash(m_hHash, m_aData, m_sLength);
+		}
+
+		template <size_t M>
+		bool operator == (const basic_fixed_string<M>& rhs) const noexcept {
+			if(m_sLength != rhs.size()) return false;
+			if(m_hHash != 0 && rhs.m_hHash != 0 && m_hHash != rhs.m_hHash) return false;
+			return memcmp(m_aData, rhs.data(), m_sLength) == 0;
+		}
+		template <size_t M>
+		bool operator != (const basic_fixed_string<M>& rhs) const noexcept { return !(*this == rhs); }
+		template <size_t M>
+		bool operator < (const basic_fixed_string<M>& rhs) const noexcept { return compare(rhs) < 0; }
+		template <size_t M>
+		bool operator > (const basic_fixed_string<M>& rhs) const noexcept { return compare(rhs) > 0; }
+		template <size_t M>
+		bool operator <= (const basic_fixed_string<M>& rhs) const noexcept { return compare(rhs) <= 0; }
+		template <size_t M>
+		bool operator >= (const basic_fixed_string<M>& rhs) const noexcept { return compare(rhs) >= 0; }
+
+		bool operator == (const char* rhs) const noexcept { return compare(rhs) == 0; }
+		bool operator != (const char* rhs) const noexcept { return compare(rhs) != 0; }
+
+		template <size_t M> friend class basic_fixed_string;
+	private:
+		char m_aData[N + 1];
+		size_type m_sLength;
+		mutable result_type m_hHash;
+	};
+
+	template <size_t N>
+	struct hash< basic_fixed_string<N> > {
+		result_type operator()(const basic_fixed_string<N>& str) const noexcept {
+			return str.hash();
+		}
+	};
+
+	template <size_t N>
+	using fixed_string = basic_fixed_string<N>;
+}
+
+#endif // __SQUADS_FIXED_STRING_H__
@@ -0,0 +1,526 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_FLAT_MAP_H__
+#define __SQUADS_FLAT_MAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "compressed_pair.hpp"
+#include "iterator.hpp"
+#include "pair.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief A growable contiguous array, the storage of the flat containers.
+		 * @note On allocation failure the array is not changed and false is returned.
+		 */
+		template <typename T, class TAllocator>
+		class flat_array {
+		public:
+			using value_type = T;
+			using pointer = T*;
+			using const_pointer = const T*;
+			using size_type = squads::size_t;
+			using self_type = flat_array<T, TAllocator>;
+
+			static constexpr size_type MinCapacity = 8;
+
+			flat_array() : m_pData(nullptr), m_sSize(0), m_pairCapacity(0) { }
+
+			flat_array(const self_type& other) : flat_array() {
+				if(reserve(other.m_sSize)) {
+					for(size_type i = 0; i < other.m_sSize; i++)
+						::new (static_cast<void*>(m_pData + i)) value_type(other.m_pData[i]);
+					m_sSize = other.m_sSize;
+				}
+			}
+			~flat_array() { clear(); release(); }
+
+			self_type& operator = (const self_type&) = delete;
+
+			pointer data() 				{ return m_pData; }
+			const_pointer data() const 	{ return m_pData; }
+			size_type size() const 		{ return m_sSize; }
+			size_type capacity() const 	{ return m_pairCapacity.first(); }
+
+			value_type& operator[] (size_type i) 			 { return m_pData[i]; }
+			const value_type& operator[] (size_type i) const { return m_pData[i]; }
+
+			bool reserve(size_type count) {
+				if(count <= m_pairCapacity.first()) return true;
+
+				pointer _pData = static_cast<pointer>(m_pairCapacity.second().allocate(count, sizeof(value_type), alignof(value_type)));
+				if(_pData == nullptr) return false;
+
+				for(size_type i = 0; i < m_sSize; i++) {
+					::new (static_cast<void*>(_pData + i)) value_type(m_pData[i]);
+					squads::destruct(m_pData + i);
+				}
+				release();
+
+				m_pData = _pData;
+				m_pairCapacity.first() = count;
+				return true;
+			}
+
+			bool grow() {
+				return (m_sSize < m_pairCapacity.first()) || reserve(squads::max<size_type>(MinCapacity, m_pairCapacity.first() * 2));
+			}
+
+			/**
+			 * @brief Insert value before index, the elements behind are shifted.
+			 */
+			bool insert(size_type index, const value_type& value) {
+				assert(index <= m_sSize);
+				if(!grow()) return false;
+
+				if(index == m_sSize) {
+					::new (static_cast<void*>(m_pData + m_sSize)) value_type(value);
+				} else {
+					value_type _value(value);
+					::new (static_cast<void*>(m_pData + m_sSize)) value_type(m_pData[m_sSize - 1]);
+					for(size_type i = m_sSize - 1; i > index; i--) m_pData[i] = m_pData[i - 1];
+					m_pData[index] = _value;
+				}
+				++m_sSize;
+				return true;
+			}
+
+			bool push_back(const value_type& value) { return insert(m_sSize, value); }
+
+			/**
+			 * @brief Erase the element at index, the elements behind are shifted.
+			 */
+			void erase(size_type index) {
+				assert(index < m_sSize);
+				for(size_type i = index + 1; i < m_sSize; i++) m_pData[i - 1] = m_pData[i];
+				squads::destruct(m_pData + --m_sSize);
+			}
+
+			/**
+			 * @brief Destroy the elements from count to the end.
+			 */
+			void truncate(size_type count) {
+				while(m_sSize > count) squads::destruct(m_pData + --m_sSize);
+			}
+
+			void clear() { truncate(0); }
+
+			void swap(self_type& other) {
+				squads::swap(m_pData, other.m_pData);
+				squads::swap(m_sSize, other.m_sSize);
+				squads::swap(m_pairCapacity.first(), other.m_pairCapacity.first());
+			}
+		private:
+			void release() {
+				if(m_pData != nullptr)
+					m_pairCapacity.second().deallocate(m_pData, m_pairCapacity.first(), sizeof(value_type), alignof(value_type));
+				m_pData = nullptr;
+				m_pairCapacity.first() = 0;
+			}
+		private:
+			pointer 	m_pData;
+			size_type 	m_sSize;
+			/// The capacity and the allocator, a empty allocator use no space
+			basic_compressed_pair<size_type, TAllocator> m_pairCapacity;
+		};
+
+		/**
+		 * @brief Heap sort by index, for sorting more parallel arrays in one pass.
+		 * @param count The number of elements.
+		 * @param less less(i, j) compare the elements at index i and j.
+		 * @param swap swap(i, j) swap the elements at index i and j in all arrays.
+		 */
+		template <class TLess, class TSwap>
+		void flat_index_sort(size_t count, TLess less, TSwap swap) {
+			auto _sift = [&](size_t root, size_t end) {
+				while(2 * root + 1 < end) {
+					size_t _child = 2 * root + 1;
+					if(_child + 1 < end && less(_child, _child + 1)) ++_child;
+					if(!less(root, _child)) return;
+					swap(root, _child);
+					root = _child;
+				}
+			};
+
+			for(size_t i = count / 2; i > 0; i--) _sift(i - 1, count);
+			for(size_t _end = count; _end > 1; _end--) {
+				swap(0, _end - 1);
+				_sift(0, _end - 1);
+			}
+		}
+
+		/**
+		 * @brief Sort parallel arrays by key and remove the duplicated keys, the first occurrence is kept.
+		 *
+		 * The equal keys are ordered by their input position, so the kept element is the same
+		 * as with insert() in input order.
+		 * @param count The number of elements.
+		 * @param order Space for count positions.
+		 * @param less less(i, j) compare the keys at index i and j.
+		 * @param swap swap(i, j) swap the elements at index i and j in all arrays.
+		 * @param move move(to, from) assign the element at index from to index to in all arrays.
+		 * @return The number of kept elements, they are at the front.
+		 */
+		template <class TLess, class TSwap, class TMove>
+		size_t flat_sort_unique(size_t count, size_t* order, TLess less, TSwap swap, TMove move) {
+			for(size_t i = 0; i < count; i++) order[i] = i;
+
+			flat_index_sort(count,
+				[&](size_t a, size_t b) { return less(a, b) || (!less(b, a) && order[a] < order[b]); },
+				[&](size_t a, size_t b) { swap(a, b); squads::swap(order[a], order[b]); });
+
+			size_t _out = 0;
+			for(size_t i = 0; i < count; i++) {
+				if(_out != 0 && !less(_out - 1, i)) continue;
+				if(_out != i) move(_out, i);
+				++_out;
+			}
+			return _out;
+		}
+	}
+
+	/**
+	 * @brief The reference to a element of a basic_flat_map.
+	 */
+	template <typename TKey, typename TValue>
+	struct basic_flat_map_reference {
+		const TKey& key;
+		TValue& 	value;
+
+		const basic_flat_map_reference* operator->() const { return this; }
+	};
+
+	/**
+	 * @brief Random access iterator of the basic_flat_map.
+	 */
+	template <typename TKey, typename TValue>
+	class basic_flat_map_iterator {
+		template <typename UKey, typename UValue> friend class basic_flat_map_iterator;
+	public:
+		using iterator_category = squads::random_access_iterator_tag;
+		using value_type = basic_flat_map_reference<TKey, TValue>;
+		using reference = value_type;
+		using pointer = value_type;
+		using difference_type = squads::ptrdiff_t;
+		using self_type = basic_flat_map_iterator<TKey, TValue>;
+
+		basic_flat_map_iterator() : m_pKey(nullptr), m_pValue(nullptr) { }
+		basic_flat_map_iterator(const TKey* key, TValue* value) : m_pKey(key), m_pValue(value) { }
+
+		template <typename UValue>
+		basic_flat_map_iterator(const basic_flat_map_iterator<TKey, UValue>& other)
+			: m_pKey(other.m_pKey), m_pValue(other.m_pValue) { }
+
+		const TKey& key() const 	{ return *m_pKey; }
+		TValue& value() const 		{ return *m_pValue; }
+
+		reference operator*() const 	{ return reference{*m_pKey, *m_pValue}; }
+		pointer operator->() const 		{ return pointer{*m_pKey, *m_pValue}; }
+
+		self_type& operator++() 	{ ++m_pKey; ++m_pValue; return *this; }
+		self_type& operator--() 	{ --m_pKey; --m_pValue; return *this; }
+		self_type operator++(int) 	{ self_type _copy(*this); ++(*this); return _copy; }
+		self_type operator--(int) 	{ self_type _copy(*this); --(*this); return _copy; }
+
+		self_type& operator += (difference_type n) 	{ m_pKey += n; m_pValue += n; return *this; }
+		self_type& operator -= (difference_type n) 	{ m_pKey -= n; m_pValue -= n; return *this; }
+		self_type operator + (difference_type n) const { return self_type(m_pKey + n, m_pValue + n); }
+		self_type operator - (difference_type n) const { return self_type(m_pKey - n, m_pValue - n); }
+
+		template <typename UValue>
+		difference_type operator - (const basic_flat_map_iterator<TKey, UValue>& rhs) const { return m_pKey - rhs.m_pKey; }
+		template <typename UValue>
+		bool operator == (const basic_flat_map_iterator<TKey, UValue>& rhs) const { return m_pKey == rhs.m_pKey; }
+		template <typename UValue>
+		bool operator != (const basic_flat_map_iterator<TKey, UValue>& rhs) const { return m_pKey != rhs.m_pKey; }
+		template <typename UValue>
+		bool operator < (const basic_flat_map_iterator<TKey, UValue>& rhs) const { return m_pKey < rhs.m_pKey; }
+	private:
+		const TKey* m_pKey;
+		TValue* 	m_pValue;
+	};
+
+	/**
+	 * @brief A ordered map, that stores the sorted keys and the values in two
+	 * separate contiguous arrays.
+	 *
+	 * A lookup is a binary search over the key array only, that is dense and cache friendly,
+	 * the values are only touched for the found element. Insert and erase shift the
+	 * elements behind, so the map is made for tables that are built once and read often:
+	 * use the bulk constructor or assign(), that sort the input once and remove the duplicates.
+	 *
+	 * @tparam TKey The type of the keys.
+	 * @tparam TValue The type of the values.
+	 * @tparam TCompare The order of the keys, default squads::less<TKey>.
+	 * @tparam TAllocator The allocator for both arrays.
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename TKey, typename TValue, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<> >
+	class basic_flat_map {
+	public:
+		using key_type = TKey;
+		using mapped_type = TValue;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using key_compare = TCompare;
+		using allocator_type = TAllocator;
+		using iterator = basic_flat_map_iterator<TKey, TValue>;
+		using const_iterator = basic_flat_map_iterator<TKey, const TValue>;
+		using self_type = basic_flat_map<TKey, TValue, TCompare, TAllocator>;
+		using insert_result = squads::pair<iterator, bool>;
+
+		basic_flat_map() : m_arrKeys(), m_arrValues(), m_cCompare() { }
+
+		/**
+		 * @brief Construct the map from count unsorted keys and values.
+		 * @see assign
+		 */
+		basic_flat_map(const key_type* keys, const mapped_type* values, size_type count)
+			: basic_flat_map() { assign(keys, values, count); }
+
+		/**
+		 * @brief Construct the map from a range of unsorted key/value pairs.
+		 * @see assign
+		 */
+		basic_flat_map(const squads::pair<TKey, TValue>* first, const squads::pair<TKey, TValue>* last)
+			: basic_flat_map() { assign(first, last); }
+
+		basic_flat_map(const self_type& other)
+			: m_arrKeys(other.m_arrKeys), m_arrValues(other.m_arrValues), m_cCompare(other.m_cCompare) { }
+
+		basic_flat_map(self_type&& other) : basic_flat_map() { swap(other); }
+
+		self_type& operator = (const self_type& other) {
+			if(this != &other) { self_type _copy(other); swap(_copy); }
+			return *this;
+		}
+		self_type& operator = (self_type&& other) { swap(other); return *this; }
+
+		iterator begin() 				{ return iterator(m_arrKeys.data(), m_arrValues.data()); }
+		const_iterator begin() const 	{ return const_iterator(m_arrKeys.data(), m_arrValues.data()); }
+		iterator end() 					{ return begin() + difference_type(size()); }
+		const_iterator end() const 		{ return begin() + difference_type(size()); }
+
+		size_type size() const 		{ return m_arrKeys.size(); }
+		bool empty() const 			{ return size() == 0; }
+		size_type capacity() const 	{ return m_arrKeys.capacity(); }
+
+		/**
+		 * @brief Get the sorted key array, for direct scans.
+		 */
+		const key_type* keys() const 	{ return m_arrKeys.data(); }
+		/**
+		 * @brief Get the value array, in the same order as keys().
+		 */
+		mapped_type* values() 				{ return m_arrValues.data(); }
+		const mapped_type* values() const 	{ return m_arrValues.data(); }
+
+		/**
+		 * @brief Reserve space for count elements.
+		 * @return False on allocation failure.
+		 */
+		bool reserve(size_type count) {
+			return m_arrKeys.reserve(count) && m_arrValues.reserve(count);
+		}
+
+		/**
+		 * @brief Replace the content with count unsorted keys and values.
+		 *
+		 * The input is sorted once and for duplicated keys the first element is kept, like insert().
+		 * @return False on allocation failure, the map is empty then.
+		 */
+		bool assign(const key_type* keys, const mapped_type* values, size_type count) {
+			clear();
+			if(!reserve(count)) return false;
+
+			for(size_type i = 0; i < count; i++) {
+				m_arrKeys.push_back(keys[i]);
+				m_arrValues.push_back(values[i]);
+			}
+			return sort_unique();
+		}
+
+		/**
+		 * @brief Replace the content with a range of unsorted key/value pairs.
+		 * @see assign
+		 */
+		bool assign(const squads::pair<TKey, TValue>* first, const squads::pair<TKey, TValue>* last) {
+			clear();
+			if(!reserve(size_type(last - first))) return false;
+
+			for(; first != last; ++first) {
+				m_arrKeys.push_back(first->first());
+				m_arrValues.push_back(first->second());
+			}
+			return sort_unique();
+		}
+
+		/**
+		 * @brief Get the first element with a key not less than key.
+		 */
+		iterator lower_bound(const key_type& key) 				{ return begin() + lower_index(key); }
+		const_iterator lower_bound(const key_type& key) const 	{ return begin() + lower_index(key); }
+
+		/**
+		 * @brief Get the first element with a key greater than key.
+		 */
+		iterator upper_bound(const key_type& key) {
+			return begin() + difference_type(squads::upper_bound(m_arrKeys.data(), m_arrKeys.data() + size(), key, m_cCompare) - m_arrKeys.data());
+		}
+		const_iterator upper_bound(const key_type& key) const {
+			return const_cast<self_type*>(this)->upper_bound(key);
+		}
+
+		/**
+		 * @brief Find the element with the given key.
+		 * @return The iterator to the element or end() when not found.
+		 */
+		iterator find(const key_type& key) {
+			difference_type _index = lower_index(key);
+			return is_match(_index, key) ? begin() + _index : end();
+		}
+		const_iterator find(const key_type& key) const {
+			return const_cast<self_type*>(this)->find(key);
+		}
+
+		bool contains(const key_type& key) const 		{ return find(key) != end(); }
+		size_type count(const key_type& key) const 		{ return contains(key) ? 1 : 0; }
+
+		/**
+		 * @brief Insert a key/value, when the key is not in the map.
+		 * @return The iterator to the element and true when inserted.
+		 * On allocation failure the iterator is end().
+		 */
+		insert_result insert(const key_type& key, const mapped_type& value) {
+			difference_type _index = lower_index(key);
+			if(is_match(_index, key)) return insert_result(begin() + _index, false);
+
+			if(!insert_at(size_type(_index), key, value)) return insert_result(end(), false);
+			return insert_result(begin() + _index, true);
+		}
+
+		/**
+		 * @brief Insert a key/value or overwrite the value of an existing key.
+		 * @return False on allocation failure.
+		 */
+		bool insert_or_assign(const key_type& key, const mapped_type& value) {
+			difference_type _index = lower_index(key);
+			if(is_match(_index, key)) { m_arrValues[size_type(_index)] = value; return true; }
+
+			return insert_at(size_type(_index), key, value);
+		}
+
+		/**
+		 * @brief Get the value of the key, the key is inserted with a default value when not found.
+		 */
+		mapped_type& operator[] (const key_type& key) {
+			insert_result _ret = insert(key, mapped_type());
+			assert(_ret.first() != end());
+			return _ret.first().value();
+		}
+
+		/**
+		 * @brief Erase the element with the given key.
+		 * @return The number of erased elements.
+		 */
+		size_type erase(const key_type& key) {
+			difference_type _index = lower_index(key);
+			if(!is_match(_index, key)) return 0;
+
+			erase(begin() + _index);
+			return 1;
+		}
+
+		/**
+		 * @brief Erase the element at pos.
+		 * @return The iterator to the next element.
+		 */
+		iterator erase(const_iterator pos) {
+			size_type _index = size_type(pos - begin());
+			m_arrKeys.erase(_index);
+			m_arrValues.erase(_index);
+			return begin() + difference_type(_index);
+		}
+
+		void clear() {
+			m_arrKeys.clear();
+			m_arrValues.clear();
+		}
+
+		void swap(self_type& other) {
+			m_arrKeys.swap(other.m_arrKeys);
+			m_arrValues.swap(other.m_arrValues);
+			squads::swap(m_cCompare, other.m_cCompare);
+		}
+	private:
+		difference_type lower_index(const key_type& key) const {
+			const key_type* _pKeys = m_arrKeys.data();
+			return squads::lower_bound(_pKeys, _pKeys + size(), key, m_cCompare) - _pKeys;
+		}
+
+		bool is_match(difference_type index, const key_type& key) const {
+			return size_type(index) < size() && !m_cCompare(key, m_arrKeys[size_type(index)]);
+		}
+
+		bool insert_at(size_type index, const key_type& key, const mapped_type& value) {
+			// Grow both arrays first, so the inserts below can't fail
+			if(size() == capacity() && !reserve(squads::max<size_type>(8, 2 * size()))) return false;
+
+			m_arrKeys.insert(index, key);
+			m_arrValues.insert(index, value);
+			return true;
+		}
+
+		/// Sort the elements and remove the duplicated keys, false and empty on allocation failure
+		bool sort_unique() {
+			internal::flat_array<size_t, TAllocator> _order;
+			if(!_order.reserve(size())) { clear(); return false; }
+
+			key_type* _pKeys = m_arrKeys.data();
+			mapped_type* _pValues = m_arrValues.data();
+			const key_compare& _comp = m_cCompare;
+
+			size_type _out = internal::flat_sort_unique(size(), _order.data(),
+				[&](size_t a, size_t b) { return _comp(_pKeys[a], _pKeys[b]); },
+				[&](size_t a, size_t b) { squads::swap(_pKeys[a], _pKeys[b]); squads::swap(_pValues[a], _pValues[b]); },
+				[&](size_t to, size_t from) { _pKeys[to] = _pKeys[from]; _pValues[to] = _pValues[from]; });
+
+			m_arrKeys.truncate(_out);
+			m_arrValues.truncate(_out);
+			return true;
+		}
+	private:
+		internal::flat_array<TKey, TAllocator> 	 m_arrKeys;
+		internal::flat_array<TValue, TAllocator> m_arrValues;
+		key_compare m_cCompare;
+	};
+
+	template <typename TKey, typename TValue, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<> >
+	using flat_map = basic_flat_map<TKey, TValue, TCompare, TAllocator>;
+}
+
+#endif // __SQUADS_FLAT_MAP_H__
@@ -0,0 +1,193 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_FLAT_SET_H__
+#define __SQUADS_FLAT_SET_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "flat_map.hpp"
+
+namespace squads {
+	/**
+	 * @brief A ordered set, that stores the sorted keys in one contiguous array.
+	 *
+	 * Lookups are a binary search, insert and erase shift the elements behind.
+	 * Build large sets with the bulk constructor or assign(), that sort the input once
+	 * and remove the duplicates.
+	 *
+	 * @tparam TKey The type of the keys.
+	 * @tparam TCompare The order of the keys, default squads::less<TKey>.
+	 * @tparam TAllocator The allocator for the array.
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename TKey, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<> >
+	class basic_flat_set {
+	public:
+		using key_type = TKey;
+		using value_type = TKey;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using key_compare = TCompare;
+		using allocator_type = TAllocator;
+		using iterator = const TKey*;
+		using const_iterator = const TKey*;
+		using self_type = basic_flat_set<TKey, TCompare, TAllocator>;
+		using insert_result = squads::pair<iterator, bool>;
+
+		basic_flat_set() : m_arrKeys(), m_cCompare() { }
+
+		/**
+		 * @brief Construct the set from count unsorted keys.
+		 * @see assign
+		 */
+		basic_flat_set(const key_type* keys, size_type count)
+			: basic_flat_set() { assign(keys, count); }
+
+		basic_flat_set(const self_type& other)
+			: m_arrKeys(other.m_arrKeys), m_cCompare(other.m_cCompare) { }
+
+		basic_flat_set(self_type&& other) : basic_flat_set() { swap(other); }
+
+		self_type& operator = (const self_type& other) {
+			if(this != &other) { self_type _copy(other); swap(_copy); }
+			return *this;
+		}
+		self_type& operator = (self_type&& other) { swap(other); return *this; }
+
+		const_iterator begin() const 	{ return m_arrKeys.data(); }
+		const_iterator end() const 		{ return m_arrKeys.data() + size(); }
+
+		size_type size() const 		{ return m_arrKeys.size(); }
+		bool empty() const 			{ return size() == 0; }
+		size_type capacity() const 	{ return m_arrKeys.capacity(); }
+		const key_type* data() const { return m_arrKeys.data(); }
+
+		/**
+		 * @brief Reserve space for count keys.
+		 * @return False on allocation failure.
+		 */
+		bool reserve(size_type count) { return m_arrKeys.reserve(count); }
+
+		/**
+		 * @brief Replace the content with count unsorted keys.
+		 *
+		 * The input is sorted once and for duplicated keys the first one is kept, like insert().
+		 * @return False on allocation failure, the set is empty then.
+		 */
+		bool assign(const key_type* keys, size_type count) {
+			clear();
+			if(!reserve(count)) return false;
+
+			internal::flat_array<size_t, TAllocator> _order;
+			if(!_order.reserve(count)) return false;
+
+			for(size_type i = 0; i < count; i++) m_arrKeys.push_back(keys[i]);
+
+			key_type* _pKeys = m_arrKeys.data();
+			const key_compare& _comp = m_cCompare;
+
+			size_type _out = internal::flat_sort_unique(size(), _order.data(),
+				[&](size_t a, size_t b) { return _comp(_pKeys[a], _pKeys[b]); },
+				[&](size_t a, size_t b) { squads::swap(_pKeys[a], _pKeys[b]); },
+				[&](size_t to, size_t from) { _pKeys[to] = _pKeys[from]; });
+
+			m_arrKeys.truncate(_out);
+			return true;
+		}
+
+		/**
+		 * @brief Get the first key not less than key.
+		 */
+		const_iterator lower_bound(const key_type& key) const {
+			return squads::lower_bound(begin(), end(), key, m_cCompare);
+		}
+		/**
+		 * @brief Get the first key greater than key.
+		 */
+		const_iterator upper_bound(const key_type& key) const {
+			return squads::upper_bound(begin(), end(), key, m_cCompare);
+		}
+
+		/**
+		 * @brief Find the key.
+		 * @return The iterator to the key or end() when not found.
+		 */
+		const_iterator find(const key_type& key) const {
+			const_iterator _it = lower_bound(key);
+			return (_it != end() && !m_cCompare(key, *_it)) ? _it : end();
+		}
+
+		bool contains(const key_type& key) const 		{ return find(key) != end(); }
+		size_type count(const key_type& key) const 		{ return contains(key) ? 1 : 0; }
+
+		/**
+		 * @brief Insert a key, when not in the set.
+		 * @return The iterator to the key and true when inserted.
+		 * On allocation failure the iterator is end().
+		 */
+		insert_result insert(const key_type& key) {
+			const_iterator _it = lower_bound(key);
+			size_type _index = size_type(_it - begin());
+
+			if(_it != end() && !m_cCompare(key, *_it)) return insert_result(_it, false);
+			if(!m_arrKeys.insert(_index, key)) return insert_result(end(), false);
+			return insert_result(begin() + _index, true);
+		}
+
+		/**
+		 * @brief Erase the key.
+		 * @return The number of erased keys.
+		 */
+		size_type erase(const key_type& key) {
+			const_iterator _it = find(key);
+			if(_it == end()) return 0;
+
+			erase(_it);
+			return 1;
+		}
+
+		/**
+		 * @brief Erase the key at pos.
+		 * @return The iterator to the next key.
+		 */
+		const_iterator erase(const_iterator pos) {
+			size_type _index = size_type(pos - begin());
+			m_arrKeys.erase(_index);
+			return begin() + _index;
+		}
+
+		void clear() { m_arrKeys.clear(); }
+
+		void swap(self_type& other) {
+			m_arrKeys.swap(other.m_arrKeys);
+			squads::swap(m_cCompare, other.m_cCompare);
+		}
+	private:
+		internal::flat_array<TKey, TAllocator> m_arrKeys;
+		key_compare m_cCompare;
+	};
+
+	template <typename TKey, class TCompare = squads::less<TKey>,
+			  class TAllocator = squads::default_allocator<> >
+	using flat_set = basic_flat_set<TKey, TCompare, TAllocator>;
+}
+
+#endif // __SQUADS_FLAT_SET_H__
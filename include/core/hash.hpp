@@ -22,8 +22,11 @@
 
 #include "config.hpp"
 #include <stdint.h>
+#include <string.h>
 #include "defines.hpp"
 
+#include "span.hpp"
+
 namespace squads {
     using result_type = squads::size_t;
 
@@ -62,13 +65,50 @@ namespace squads {
 			}
 			return static_cast<result_type>(_iRet);
 		}
+
+		/**
+		 * @brief Spread the bits of a hash value.
+		 * The basic hashes are a plain multiply, so the low bits only depend on the low bits
+		 * of the key. Tables that index with a mask instead of a modulo mix the value first.
+		 */
+		inline result_type hash_mix(result_type h) noexcept {
+			// Mixed in a intermediate of the width, so no shift is wider then result_type
+			if(sizeof(result_type) > 4) {
+				uint64_t _x = static_cast<uint64_t>(h) * 0x9E3779B97F4A7C15ull;
+				return static_cast<result_type>(_x ^ (_x >> 32));
+			}
+			uint32_t _x = static_cast<uint32_t>(h) * 0x9E3779B9u;
+			return static_cast<result_type>(_x ^ (_x >> 16));
+		}
+
+		/**
+		 * @brief Hash a block of bytes, a machine word at once.
+		 * @param data The pointer to the bytes.
+		 * @param length The number of bytes.
+		 */
+		inline result_type hash_bytes(const void* data, size_t length) noexcept {
+			const unsigned char* _pData = static_cast<const unsigned char*>(data);
+			result_type _hash = static_cast<result_type>(length) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
+			result_type _word;
+
+			for(; length >= sizeof(result_type); length -= sizeof(result_type), _pData += sizeof(result_type)) {
+				memcpy(&_word, _pData, sizeof(result_type));
+				_hash = hash_mix(_hash ^ _word);
+			}
+			if(length > 0) {
+				_word = 0;
+				memcpy(&_word, _pData, length);
+				_hash = hash_mix(_hash ^ _word);
+			}
+			return _hash;
+		}
 	}
 	/**
 	 * @brief Default implementation of hasher.
 	 */
 	template<typename T>
 	struct hash {
-		const result_type operator()(T& t) const noexcept {
+		const result_type operator()(const T& t) const noexcept {
 			return internal::rjenkins_hash(t);
 		}
 	};
@@ -99,7 +139,7 @@ namespace squads {
     template<>
     struct hash<int8_t>{
 		result_type operator () (int8_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
@@ -107,7 +147,7 @@ namespace squads {
 	template<>
     struct hash<uint8_t>{
 		result_type operator () (uint8_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
@@ -115,28 +155,28 @@ namespace squads {
 	template<>
     struct hash<int16_t>{
 		result_type operator () (int16_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
 	template<>
     struct hash<uint16_t>{
 		result_type operator () (uint16_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
 	template<>
     struct hash<int32_t>{
 		result_type operator () (int32_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
 	template<>
     struct hash<uint32_t>{
 		result_type operator () (uint32_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
@@ -144,7 +184,7 @@ namespace squads {
 	template<>
     struct hash<int64_t>{
 		result_type operator () (int64_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
@@ -152,10 +192,22 @@ namespace squads {
 	template<>
     struct hash<uint64_t>{
 		result_type operator () (const uint64_t n) const noexcept {
-			return static_cast<result_type>(n) * SQUADS_THREAD_CONFIG_BASIC_HASHMUL_VAL;
+			return static_cast<result_type>(n) * SQUADS_CONFIG_BASIC_HASHMUL_VAL;
 		}
     };
 
+	/**
+	 * @brief Hash the bytes of a span, T must have no padding bytes.
+	 */
+	template<typename T>
+	struct hash< basic_span<T> > {
+		static_assert(squads::is_trivially_copyable<T>::value, "hash<span<T>>: T must be trivially copyable");
+
+		result_type operator () (const basic_span<T>& s) const noexcept {
+			return internal::hash_bytes(s.data(), s.size_bytes());
+		}
+	};
+
     template <class T>
 	struct hash_function {
 		result_type operator () (T key, size_t maxValue) const noexcept {
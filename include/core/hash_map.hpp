@@ -0,0 +1,668 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_HASH_MAP_H__
+#define __SQUADS_HASH_MAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "hash.hpp"
+#include "iterator.hpp"
+#include "pair.hpp"
+#include "utils.hpp"
+
+#if SQUADS_CONFIG_HAS_SSE2 == SQUADS_CONFIG_YES
+	#include <emmintrin.h>
+#elif SQUADS_CONFIG_HAS_NEON == SQUADS_CONFIG_YES
+	#include <arm_neon.h>
+#endif
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief The control byte of a hash table slot.
+		 * A full slot holds the lower 7 bits of the hash (H2), empty and deleted slots
+		 * have the sign bit set.
+		 */
+		using hash_ctrl_t = int8_t;
+
+		constexpr hash_ctrl_t hash_ctrl_empty   = -128;
+		constexpr hash_ctrl_t hash_ctrl_deleted = -2;
+
+		/// The number of control bytes probed at once.
+		constexpr size_t hash_group_width = 16;
+
+		inline bool hash_ctrl_is_full(hash_ctrl_t c) 	{ return c >= 0; }
+		inline size_t hash_h1(result_type hash) 		{ return hash >> 7; }
+		inline hash_ctrl_t hash_h2(result_type hash) 	{ return static_cast<hash_ctrl_t>(hash & 0x7f); }
+
+		/**
+		 * @brief A set of slot positions inside a probed group.
+		 * @tparam TMask The mask type.
+		 * @tparam TShift log2 of the number of mask bits per slot.
+		 */
+		template <typename TMask, int TShift>
+		class basic_hash_bitmask {
+		public:
+			static constexpr size_t UnusedBits = sizeof(TMask) * CHAR_BIT - (hash_group_width << TShift);
+
+			explicit basic_hash_bitmask(TMask mask) : m_mask(mask) { }
+
+			/**
+			 * @brief Is any slot set in this mask?
+			 */
+			bool any() const 				{ return m_mask != 0; }
+
+			/**
+			 * @brief Get the position of the lowest set slot.
+			 */
+			size_t lowest() const 			{ return squads::ctz(m_mask) >> TShift; }
+
+			/**
+			 * @brief Remove the lowest set slot.
+			 */
+			void next() 					{ m_mask &= (m_mask - 1); }
+
+			/**
+			 * @brief Get the number of unset slots from the start of the group.
+			 */
+			size_t trailing_zeros() const {
+				return (m_mask == 0) ? hash_group_width : squads::ctz(m_mask) >> TShift;
+			}
+
+			/**
+			 * @brief Get the number of unset slots before the end of the group.
+			 */
+			size_t leading_zeros() const {
+				return (m_mask == 0) ? hash_group_width : (squads::clz(m_mask) - UnusedBits) >> TShift;
+			}
+		private:
+			TMask m_mask;
+		};
+
+#if SQUADS_CONFIG_HAS_SSE2 == SQUADS_CONFIG_YES
+		/**
+		 * @brief A group of 16 control bytes, matched with SSE2.
+		 */
+		class hash_group {
+		public:
+			using bitmask_type = basic_hash_bitmask<uint32_t, 0>;
+
+			explicit hash_group(const hash_ctrl_t* pos)
+				: m_vCtrl(_mm_loadu_si128(reinterpret_cast<const __m128i*>(pos))) { }
+
+			bitmask_type match(hash_ctrl_t h2) const {
+				return bitmask_type(static_cast<uint32_t>(
+					_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), m_vCtrl)) ));
+			}
+			bitmask_type match_empty() const {
+				return match(hash_ctrl_empty);
+			}
+			bitmask_type match_empty_or_deleted() const {
+				return bitmask_type(static_cast<uint32_t>(_mm_movemask_epi8(m_vCtrl)));
+			}
+		private:
+			__m128i m_vCtrl;
+		};
+#elif SQUADS_CONFIG_HAS_NEON == SQUADS_CONFIG_YES
+		/**
+		 * @brief A group of 16 control bytes, matched with NEON.
+		 * @note The compare result is narrowed to four bits per slot.
+		 */
+		class hash_group {
+		public:
+			using bitmask_type = basic_hash_bitmask<uint64_t, 2>;
+
+			explicit hash_group(const hash_ctrl_t* pos)
+				: m_vCtrl(vld1q_s8(pos)) { }
+
+			bitmask_type match(hash_ctrl_t h2) const {
+				return bitmask_type(to_mask(vceqq_s8(m_vCtrl, vdupq_n_s8(h2))));
+			}
+			bitmask_type match_empty() const {
+				return match(hash_ctrl_empty);
+			}
+			bitmask_type match_empty_or_deleted() const {
+				return bitmask_type(to_mask(vcltq_s8(m_vCtrl, vdupq_n_s8(0))));
+			}
+		private:
+			static uint64_t to_mask(uint8x16_t cmp) {
+				uint8x8_t _nibbles = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+				return vget_lane_u64(vreinterpret_u64_u8(_nibbles), 0) & 0x8888888888888888ull;
+			}
+		private:
+			int8x16_t m_vCtrl;
+		};
+#else
+		/**
+		 * @brief A group of 16 control bytes, matched with a scalar loop (Xtensa).
+		 */
+		class hash_group {
+		public:
+			using bitmask_type = basic_hash_bitmask<uint32_t, 0>;
+
+			explicit hash_group(const hash_ctrl_t* pos) {
+				memcpy(m_aCtrl, pos, hash_group_width);
+			}
+
+			bitmask_type match(hash_ctrl_t h2) const {
+				uint32_t _mask = 0;
+				for(size_t i = 0; i < hash_group_width; i++)
+					_mask |= uint32_t(m_aCtrl[i] == h2) << i;
+				return bitmask_type(_mask);
+			}
+			bitmask_type match_empty() const {
+				return match(hash_ctrl_empty);
+			}
+			bitmask_type match_empty_or_deleted() const {
+				uint32_t _mask = 0;
+				for(size_t i = 0; i < hash_group_width; i++)
+					_mask |= uint32_t(m_aCtrl[i] < 0) << i;
+				return bitmask_type(_mask);
+			}
+		private:
+			hash_ctrl_t m_aCtrl[hash_group_width];
+		};
+#endif
+
+		/**
+		 * @brief Triangular probe sequence over the groups of a power of two table.
+		 * Visits every group exactly once.
+		 */
+		class hash_probe_seq {
+		public:
+			hash_probe_seq(size_t hash, size_t mask)
+				: m_sMask(mask), m_sOffset(hash & mask), m_sIndex(0) { }
+
+			size_t offset() const 			{ return m_sOffset; }
+			size_t offset(size_t i) const 	{ return (m_sOffset + i) & m_sMask; }
+			size_t index() const 			{ return m_sIndex; }
+
+			void next() {
+				m_sIndex += hash_group_width;
+				m_sOffset = (m_sOffset + m_sIndex) & m_sMask;
+			}
+		private:
+			size_t m_sMask;
+			size_t m_sOffset;
+			size_t m_sIndex;
+		};
+	} // internal
+
+	/**
+	 * @brief Forward iterator over the full slots of a basic_hash_map.
+	 */
+	template <typename T>
+	class basic_hash_map_iterator {
+		template <typename U> friend class basic_hash_map_iterator;
+	public:
+		using iterator_category = squads::forward_iterator_tag;
+		using value_type = T;
+		using pointer = value_type*;
+		using reference = value_type&;
+		using difference_type = squads::ptrdiff_t;
+		using self_type = basic_hash_map_iterator<T>;
+		using ctrl_pointer = const internal::hash_ctrl_t*;
+
+		basic_hash_map_iterator()
+			: m_pCtrl(nullptr), m_pEnd(nullptr), m_pSlot(nullptr) { }
+
+		basic_hash_map_iterator(ctrl_pointer ctrl, ctrl_pointer end, pointer slot)
+			: m_pCtrl(ctrl), m_pEnd(end), m_pSlot(slot) { skip_empty(); }
+
+		template <typename U>
+		basic_hash_map_iterator(const basic_hash_map_iterator<U>& other)
+			: m_pCtrl(other.m_pCtrl), m_pEnd(other.m_pEnd), m_pSlot(other.m_pSlot) { }
+
+		reference operator*() const 	{ return *m_pSlot; }
+		pointer operator->() const 		{ return m_pSlot; }
+		pointer get() const 			{ return m_pSlot; }
+
+		self_type& operator++() {
+			++m_pCtrl; ++m_pSlot;
+			skip_empty();
+			return *this;
+		}
+		self_type operator++(int) {
+			self_type _copy(*this); ++(*this); return _copy;
+		}
+
+		template <typename U>
+		bool operator == (const basic_hash_map_iterator<U>& rhs) const { return m_pCtrl == rhs.m_pCtrl; }
+		template <typename U>
+		bool operator != (const basic_hash_map_iterator<U>& rhs) const { return m_pCtrl != rhs.m_pCtrl; }
+	private:
+		void skip_empty() {
+			while(m_pCtrl != m_pEnd && !internal::hash_ctrl_is_full(*m_pCtrl)) {
+				++m_pCtrl; ++m_pSlot;
+			}
+		}
+	private:
+		ctrl_pointer m_pCtrl;
+		ctrl_pointer m_pEnd;
+		pointer 	 m_pSlot;
+	};
+
+	/**
+	 * @brief A flat open-addressing hash map (Swiss table layout).
+	 *
+	 * Every slot has a one byte control tag. Lookups load 16 tags at once and compare
+	 * them against the 7 bit fingerprint of the key (SSE2, NEON or a scalar loop on Xtensa),
+	 * so only slots with a matching fingerprint are compared with the key.
+	 * Erased slots only become a tombstone when a probe sequence could have passed them,
+	 * otherwise they are marked empty again.
+	 *
+	 * The control bytes and the slots are one block allocated through TAllocator.
+	 *
+	 * @tparam TKey The type of the keys.
+	 * @tparam TValue The type of the mapped values.
+	 * @tparam THash The hasher, default squads::hash<TKey>.
+	 * @tparam TEqual The key compare, default squads::equal_to<TKey>.
+	 * @tparam TAllocator The allocator, a basic_storage type.
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename TKey, typename TValue, class THash = squads::hash<TKey>,
+			  class TEqual = squads::equal_to<TKey>, class TAllocator = squads::default_allocator<> >
+	class basic_hash_map {
+	public:
+		using key_type = TKey;
+		using mapped_type = TValue;
+		using value_type = squads::pair<TKey, TValue>;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using hasher = THash;
+		using key_equal = TEqual;
+		using allocator_type = TAllocator;
+		using iterator = basic_hash_map_iterator<value_type>;
+		using const_iterator = basic_hash_map_iterator<const value_type>;
+		using self_type = basic_hash_map<TKey, TValue, THash, TEqual, TAllocator>;
+		using insert_result = squads::pair<iterator, bool>;
+
+		static constexpr size_type GroupWidth = internal::hash_group_width;
+		static constexpr size_type MinCapacity = internal::hash_group_width;
+
+		basic_hash_map() noexcept
+			: m_pCtrl(nullptr), m_pSlots(nullptr), m_sCapacity(0), m_sSize(0), m_sGrowthLeft(0),
+			  m_hHasher(), m_eEqual(), m_aAllocator() { }
+
+		/**
+		 * @brief Construct a hash map with space for at least count elements.
+		 */
+		explicit basic_hash_map(size_type count)
+			: basic_hash_map() { reserve(count); }
+
+		/**
+		 * @brief Copy the elements of other.
+		 * @note On allocation failure the map is empty, use assign() to check it.
+		 */
+		basic_hash_map(const self_type& other)
+			: basic_hash_map() { assign(other); }
+
+		basic_hash_map(self_type&& other) noexcept
+			: basic_hash_map() { swap(other); }
+
+		~basic_hash_map() {
+			clear();
+			release();
+		}
+
+		iterator begin() 				{ return iterator(m_pCtrl, m_pCtrl + m_sCapacity, m_pSlots); }
+		const_iterator begin() const 	{ return const_iterator(m_pCtrl, m_pCtrl + m_sCapacity, m_pSlots); }
+		iterator end() 					{ return iterator(m_pCtrl + m_sCapacity, m_pCtrl + m_sCapacity, m_pSlots + m_sCapacity); }
+		const_iterator end() const 		{ return const_iterator(m_pCtrl + m_sCapacity, m_pCtrl + m_sCapacity, m_pSlots + m_sCapacity); }
+
+		bool empty() const 				{ return m_sSize == 0; }
+		size_type size() const 			{ return m_sSize; }
+		size_type capacity() const 		{ return m_sCapacity; }
+
+		/**
+		 * @brief Get the current load factor.
+		 */
+		float load_factor() const {
+			return m_sCapacity == 0 ? 0.0f : float(m_sSize) / float(m_sCapacity);
+		}
+
+		/**
+		 * @brief Find the element with the given key.
+		 * @return The iterator to the element or end() when not found.
+		 */
+		iterator find(const key_type& key) {
+			size_type _index = find_index(key);
+			return (_index == npos()) ? end() : iterator_at(_index);
+		}
+		const_iterator find(const key_type& key) const {
+			size_type _index = find_index(key);
+			return (_index == npos()) ? end() : const_iterator(m_pCtrl + _index, m_pCtrl + m_sCapacity, m_pSlots + _index);
+		}
+
+		/**
+		 * @brief Is an element with the given key in the map?
+		 */
+		bool contains(const key_type& key) const {
+			return find_index(key) != npos();
+		}
+
+		/**
+		 * @brief Insert a key/value, when the key is not in the map.
+		 * @return The iterator to the element and true when inserted, false when the key exist.
+		 * On allocation failure the iterator is end().
+		 */
+		insert_result insert(const key_type& key, const mapped_type& value) {
+			result_type _hash = hash_of(key);
+			size_type _index = find_index(key, _hash);
+			if(_index != npos()) return insert_result(iterator_at(_index), false);
+
+			_index = prepare_insert(_hash);
+			if(_index == npos()) return insert_result(end(), false);
+
+			::new (static_cast<void*>(m_pSlots + _index)) value_type(key, value);
+			return insert_result(iterator_at(_index), true);
+		}
+
+		/**
+		 * @brief Insert a key/value or overwrite the value of an existing key.
+		 * @return True when the key is now in the map.
+		 */
+		bool insert_or_assign(const key_type& key, const mapped_type& value) {
+			insert_result _ret = insert(key, value);
+			if(_ret.first() == end()) return false;
+			if(!_ret.second()) _ret.first()->second() = value;
+			return true;
+		}
+
+		/**
+		 * @brief Get the value of the key, a default value is inserted when the key is not in the map.
+		 */
+		mapped_type& operator[](const key_type& key) {
+			insert_result _ret = insert(key, mapped_type());
+			assert(_ret.first() != end());
+			return _ret.first()->second();
+		}
+
+		/**
+		 * @brief Erase the element with the given key.
+		 * @return The number of erased elements.
+		 */
+		size_type erase(const key_type& key) {
+			size_type _index = find_index(key);
+			if(_index == npos()) return 0;
+
+			erase_at(_index);
+			return 1;
+		}
+
+		/**
+		 * @brief Erase the element on the given position.
+		 * @return The iterator to the next element.
+		 */
+		iterator erase(const_iterator pos) {
+			size_type _index = size_type(pos.get() - m_pSlots);
+			erase_at(_index);
+			return iterator(m_pCtrl + _index + 1, m_pCtrl + m_sCapacity, m_pSlots + _index + 1);
+		}
+
+		/**
+		 * @brief Remove all elements, the capacity is not changed.
+		 */
+		void clear() {
+			if(m_sCapacity == 0) return;
+
+			for(size_type i = 0; i < m_sCapacity; i++) {
+				if(internal::hash_ctrl_is_full(m_pCtrl[i]))
+					squads::destruct(m_pSlots + i);
+			}
+			reset_ctrl();
+			m_sSize = 0;
+			m_sGrowthLeft = capacity_to_growth(m_sCapacity);
+		}
+
+		/**
+		 * @brief Reserve space for count elements without a rehash.
+		 * @return False when the allocation failed.
+		 */
+		bool reserve(size_type count) {
+			if(count <= m_sSize + m_sGrowthLeft) return true;
+			return rehash(growth_to_capacity(count));
+		}
+
+		/**
+		 * @brief Rebuild the table with at least the given capacity, this drops all tombstones.
+		 * @return False when the allocation failed.
+		 */
+		bool rehash(size_type count) {
+			size_type _new = squads::max<size_type>(growth_to_capacity(m_sSize), count);
+			_new = squads::max<size_type>(MinCapacity, squads::nexthigher<size_type>(_new));
+			return resize(_new);
+		}
+
+		void swap(self_type& other) {
+			squads::swap(m_pCtrl, other.m_pCtrl);
+			squads::swap(m_pSlots, other.m_pSlots);
+			squads::swap(m_sCapacity, other.m_sCapacity);
+			squads::swap(m_sSize, other.m_sSize);
+			squads::swap(m_sGrowthLeft, other.m_sGrowthLeft);
+			squads::swap(m_hHasher, other.m_hHasher);
+			squads::swap(m_eEqual, other.m_eEqual);
+			squads::swap(m_aAllocator, other.m_aAllocator);
+		}
+
+		/**
+		 * @brief Replace the content with a copy of other.
+		 * @return False on allocation failure, the map is unchanged then.
+		 */
+		bool assign(const self_type& other) {
+			if(this == &other) return true;
+
+			self_type _tmp;
+			_tmp.m_hHasher = other.m_hHasher;
+			_tmp.m_eEqual = other.m_eEqual;
+			if(!_tmp.reserve(other.m_sSize)) return false;
+
+			for(const_iterator it = other.begin(); it != other.end(); ++it)
+				_tmp.insert(it->first(), it->second());
+			swap(_tmp);
+			return true;
+		}
+
+		/**
+		 * @note On allocation failure the map is unchanged, use assign() to check it.
+		 */
+		self_type& operator = (const self_type& other) {
+			assign(other);
+			return *this;
+		}
+		self_type& operator = (self_type&& other) noexcept {
+			swap(other);
+			return *this;
+		}
+	private:
+		static constexpr size_type npos() 		{ return size_type(-1); }
+
+		static size_type capacity_to_growth(size_type cap) {
+			return cap - cap / 8;
+		}
+		static size_type growth_to_capacity(size_type growth) {
+			return growth + (growth + 6) / 7;
+		}
+
+		result_type hash_of(const key_type& key) const {
+			return internal::hash_mix(m_hHasher(key));
+		}
+
+		iterator iterator_at(size_type index) {
+			return iterator(m_pCtrl + index, m_pCtrl + m_sCapacity, m_pSlots + index);
+		}
+
+		size_type find_index(const key_type& key) const {
+			return (m_sSize == 0) ? npos() : find_index(key, hash_of(key));
+		}
+
+		size_type find_index(const key_type& key, result_type hash) const {
+			if(m_sCapacity == 0) return npos();
+
+			const internal::hash_ctrl_t _h2 = internal::hash_h2(hash);
+			internal::hash_probe_seq _seq(internal::hash_h1(hash), m_sCapacity - 1);
+
+			while(true) {
+				internal::hash_group _group(m_pCtrl + _seq.offset());
+
+				for(auto _match = _group.match(_h2); _match.any(); _match.next()) {
+					size_type _index = _seq.offset(_match.lowest());
+					if(m_eEqual(m_pSlots[_index].first(), key)) return _index;
+				}
+				if(_group.match_empty().any()) return npos();
+
+				_seq.next();
+				if(_seq.index() >= m_sCapacity) return npos();
+			}
+		}
+
+		size_type find_first_non_full(result_type hash) const {
+			internal::hash_probe_seq _seq(internal::hash_h1(hash), m_sCapacity - 1);
+
+			while(true) {
+				internal::hash_group _group(m_pCtrl + _seq.offset());
+				auto _mask = _group.match_empty_or_deleted();
+
+				if(_mask.any()) return _seq.offset(_mask.lowest());
+				_seq.next();
+			}
+		}
+
+		size_type prepare_insert(result_type hash) {
+			if(m_sGrowthLeft == 0) {
+				// Many tombstones: rebuild in the same capacity, otherwise grow.
+				size_type _new = (m_sCapacity != 0 && m_sSize * 32 <= m_sCapacity * 25)
+									? m_sCapacity : squads::max<size_type>(MinCapacity, m_sCapacity * 2);
+				if(!resize(_new)) return npos();
+			}
+			size_type _index = find_first_non_full(hash);
+
+			if(m_pCtrl[_index] == internal::hash_ctrl_empty) --m_sGrowthLeft;
+			set_ctrl(_index, internal::hash_h2(hash));
+			++m_sSize;
+			return _index;
+		}
+
+		void erase_at(size_type index) {
+			squads::destruct(m_pSlots + index);
+			--m_sSize;
+
+			// The slot can be empty again, when no probe has ever seen a full group around it.
+			size_type _before = (index - GroupWidth) & (m_sCapacity - 1);
+			auto _empty_after  = internal::hash_group(m_pCtrl + index).match_empty();
+			auto _empty_before = internal::hash_group(m_pCtrl + _before).match_empty();
+
+			bool _was_never_full = _empty_before.any() && _empty_after.any() &&
+				(_empty_after.trailing_zeros() + _empty_before.leading_zeros()) < GroupWidth;
+
+			if(_was_never_full) {
+				set_ctrl(index, internal::hash_ctrl_empty);
+				++m_sGrowthLeft;
+			} else {
+				set_ctrl(index, internal::hash_ctrl_deleted);
+			}
+		}
+
+		void set_ctrl(size_type index, internal::hash_ctrl_t value) {
+			m_pCtrl[index] = value;
+			// The first group is mirrored behind the table, so a group load never wraps.
+			if(index < GroupWidth) m_pCtrl[m_sCapacity + index] = value;
+		}
+
+		void reset_ctrl() {
+			memset(m_pCtrl, static_cast<unsigned char>(internal::hash_ctrl_empty), m_sCapacity + GroupWidth);
+		}
+
+		static size_type slots_offset(size_type cap) {
+			return squads::align_up<size_type>(cap + GroupWidth, alignof(value_type));
+		}
+		static size_type alloc_size(size_type cap) {
+			return slots_offset(cap) + cap * sizeof(value_type);
+		}
+		static size_type alloc_alignment() {
+			return squads::max<size_type>(alignof(value_type), alignof(void*));
+		}
+
+		bool resize(size_type cap) {
+			internal::hash_ctrl_t* _oldCtrl = m_pCtrl;
+			pointer _oldSlots = m_pSlots;
+			size_type _oldCap = m_sCapacity;
+
+			void* _mem = m_aAllocator.allocate(1, alloc_size(cap), alloc_alignment());
+			if(_mem == nullptr) return false;
+
+			m_pCtrl = static_cast<internal::hash_ctrl_t*>(_mem);
+			m_pSlots = reinterpret_cast<pointer>(static_cast<char*>(_mem) + slots_offset(cap));
+			m_sCapacity = cap;
+			reset_ctrl();
+
+			for(size_type i = 0; i < _oldCap; i++) {
+				if(!internal::hash_ctrl_is_full(_oldCtrl[i])) continue;
+
+				result_type _hash = hash_of(_oldSlots[i].first());
+				size_type _index = find_first_non_full(_hash);
+
+				set_ctrl(_index, internal::hash_h2(_hash));
+				::new (static_cast<void*>(m_pSlots + _index)) value_type(_oldSlots[i]);
+				squads::destruct(_oldSlots + i);
+			}
+			m_sGrowthLeft = capacity_to_growth(m_sCapacity) - m_sSize;
+
+			if(_oldCtrl != nullptr)
+				m_aAllocator.deallocate(_oldCtrl, 1, alloc_size(_oldCap), alloc_alignment());
+			return true;
+		}
+
+		void release() {
+			if(m_pCtrl != nullptr)
+				m_aAllocator.deallocate(m_pCtrl, 1, alloc_size(m_sCapacity), alloc_alignment());
+			m_pCtrl = nullptr;
+			m_pSlots = nullptr;
+			m_sCapacity = m_sGrowthLeft = 0;
+		}
+	private:
+		internal::hash_ctrl_t* m_pCtrl;
+		pointer 	m_pSlots;
+		size_type 	m_sCapacity;
+		size_type 	m_sSize;
+		size_type 	m_sGrowthLeft;
+		hasher 		m_hHasher;
+		key_equal 	m_eEqual;
+		allocator_type m_aAllocator;
+	};
+
+	template <typename TKey, typename TValue, class THash, class TEqual, class TAllocator>
+	inline void swap(basic_hash_map<TKey, TValue, THash, TEqual, TAllocator>& a,
+					 basic_hash_map<TKey, TValue, THash, TEqual, TAllocator>& b) {
+		a.swap(b);
+	}
+
+	template <typename TKey, typename TValue, class THash = squads::hash<TKey>,
+			  class TEqual = squads::equal_to<TKey>, class TAllocator = squads::default_allocator<> >
+	using hash_map = basic_hash_map<TKey, TValue, THash, TEqual, TAllocator>;
+}
+
+#endif // __SQUADS_HASH_MAP_H__
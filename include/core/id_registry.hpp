@@ -0,0 +1,106 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_ID_REGISTRY_H__
+#define __SQUADS_ID_REGISTRY_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "sparse_set.hpp"
+
+namespace squads {
+	/**
+	 * @brief A registry, that gives out small integer ids for objects, e.g. tasks or connections.
+	 *
+	 * Backed by a basic_sparse_map, so add, remove and lookup are O(1) and
+	 * a removed id is given out again by a later add.
+	 *
+	 * @tparam T The type of the registered objects, e.g. a pointer.
+	 * @tparam N The number of ids.
+	 * @tparam TIndex A unsigned integer type for the ids.
+	 *
+	 * @note Is not thread-safe, guard it with a lock when used from more tasks.
+	 */
+	template <typename T, size_t N, typename TIndex = uint32_t>
+	class basic_id_registry {
+	public:
+		using id_type = TIndex;
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using size_type = squads::size_t;
+		using map_type = basic_sparse_map<TIndex, T, N>;
+		using self_type = basic_id_registry<T, N, TIndex>;
+
+		static constexpr size_type Capacity = N;
+
+		basic_id_registry() : m_mapObjects() { }
+
+		size_type size() const 		{ return m_mapObjects.size(); }
+		bool empty() const 			{ return m_mapObjects.empty(); }
+		bool full() const 			{ return m_mapObjects.full(); }
+		constexpr size_type capacity() const { return Capacity; }
+
+		/**
+		 * @brief Register value with a free id.
+		 * @param[out] id The id of the value.
+		 * @return False when all ids are in use.
+		 */
+		bool add(const value_type& value, id_type& id) {
+			return m_mapObjects.acquire(value, id) != nullptr;
+		}
+
+		/**
+		 * @brief Register value with the given id, e.g. a id from a other system.
+		 * @return False when id is in use or not smaller then N.
+		 */
+		bool add_with_id(const value_type& value, id_type id) {
+			return m_mapObjects.insert(id, value) != nullptr;
+		}
+
+		/**
+		 * @brief Remove the value of id, the id is free after.
+		 * @return False when id is not in use.
+		 */
+		bool remove(id_type id) { return m_mapObjects.erase(id); }
+
+		/**
+		 * @brief Get the value of id.
+		 * @return The pointer to the value or nullptr when id is not in use.
+		 */
+		pointer get(id_type id) 				{ return m_mapObjects.find(id); }
+		const_pointer get(id_type id) const 	{ return m_mapObjects.find(id); }
+
+		bool contains(id_type id) const { return m_mapObjects.contains(id); }
+
+		void clear() { m_mapObjects.clear(); }
+
+		/**
+		 * @brief Call fn(id, value) for all registered values.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) { return m_mapObjects.foreach(fn); }
+	private:
+		map_type m_mapObjects;
+	};
+
+	template <typename T, size_t N, typename TIndex = uint32_t>
+	using id_registry = basic_id_registry<T, N, TIndex>;
+}
+
+#endif // __SQUADS_ID_REGISTRY_H__
@@ -0,0 +1,270 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_INTRUSIVE_HASH_TABLE_H__
+#define __SQUADS_INTRUSIVE_HASH_TABLE_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "functional.hpp"
+#include "hash.hpp"
+#include "intrusive_list.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	/**
+	 * @brief The hook of a intrusive hash table, embed it in the element.
+	 *
+	 * The bucket chains are single linked with a back link to the previous
+	 * link field, so a element can be removed in O(1) without searching his bucket.
+	 * The hash of the key is cached in the hook.
+	 */
+	struct intrusive_hash_node {
+		intrusive_hash_node*  Next;
+		intrusive_hash_node** PPrev;
+		result_type 		  Hash;
+
+		intrusive_hash_node() : Next(nullptr), PPrev(nullptr), Hash(0) { }
+
+		/// A copied element is not in the table of the source
+		intrusive_hash_node(const intrusive_hash_node&) : Next(nullptr), PPrev(nullptr), Hash(0) { }
+		intrusive_hash_node& operator = (const intrusive_hash_node&) { return *this; }
+
+		/**
+		 * @brief Is this hook in a table?
+		 */
+		bool is_linked() const { return PPrev != nullptr; }
+
+		/**
+		 * @brief Remove this hook from his bucket, in O(1).
+		 */
+		void unlink() {
+			*PPrev = Next;
+			if(Next) Next->PPrev = PPrev;
+			Next = nullptr; PPrev = nullptr;
+		}
+
+		/**
+		 * @brief Link this hook at the head of the bucket.
+		 */
+		void link_head(intrusive_hash_node** head) {
+			Next = *head;
+			if(Next) Next->PPrev = &Next;
+			*head = this;
+			PPrev = head;
+		}
+	};
+
+	/**
+	 * @brief A chained hash table, that links the elements with a hook inside the element.
+	 *
+	 * The bucket array is a part of the table and the table never allocate memory,
+	 * insert and remove only relink the hook of the element.
+	 *
+	 * @tparam TKey The type of the keys.
+	 * @tparam T The type of the elements.
+	 * @tparam Hook The pointer to the intrusive_hash_node member of T.
+	 * @tparam TKeyOf A functor that returns the key of a element: const TKey& operator()(const T&).
+	 * @tparam NBuckets The number of buckets, a power of two.
+	 * @tparam THash The hasher, default squads::hash<TKey>.
+	 * @tparam TEqual The key compare, default squads::equal_to<TKey>.
+	 *
+	 * @code
+	 * struct connection {
+	 *     int id;
+	 *     squads::intrusive_hash_node hook;
+	 * };
+	 * struct connection_id {
+	 *     const int& operator()(const connection& c) const { return c.id; }
+	 * };
+	 * squads::intrusive_hash_table<int, connection, &connection::hook, connection_id, 64> table;
+	 * @endcode
+	 *
+	 * @note The key of a element must not change while the element is in the table.
+	 * Is not thread-safe.
+	 */
+	template <typename TKey, typename T, intrusive_hash_node T::*Hook, class TKeyOf, size_t NBuckets,
+			  class THash = squads::hash<TKey>, class TEqual = squads::equal_to<TKey> >
+	class basic_intrusive_hash_table {
+		static_assert(NBuckets >= 1 && (NBuckets & (NBuckets - 1)) == 0,
+			"basic_intrusive_hash_table: NBuckets must be a power of two");
+	public:
+		using key_type = TKey;
+		using value_type = T;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using size_type = squads::size_t;
+		using hasher = THash;
+		using key_equal = TEqual;
+		using key_of = TKeyOf;
+		using node_type = intrusive_hash_node;
+		using traits_type = internal::intrusive_hook_traits<T, intrusive_hash_node, Hook>;
+		using self_type = basic_intrusive_hash_table<TKey, T, Hook, TKeyOf, NBuckets, THash, TEqual>;
+
+		static constexpr size_type BucketCount = NBuckets;
+
+		basic_intrusive_hash_table() : m_sSize(0) {
+			for(size_type i = 0; i < BucketCount; i++) m_aBuckets[i] = nullptr;
+		}
+		~basic_intrusive_hash_table() { clear(); }
+
+		basic_intrusive_hash_table(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		size_type size() const 				{ return m_sSize; }
+		bool empty() const 					{ return m_sSize == 0; }
+		constexpr size_type bucket_count() const 	{ return BucketCount; }
+		float load_factor() const 			{ return float(m_sSize) / float(BucketCount); }
+
+		/**
+		 * @brief Insert the element, when his key is not in the table.
+		 * @note The element must not be in a table.
+		 * @return False when a element with the same key is in the table.
+		 */
+		bool insert(reference value) {
+			result_type _hash = hash_of(key_of()(value));
+			if(find_node(key_of()(value), _hash) != nullptr) return false;
+
+			link(value, _hash);
+			return true;
+		}
+
+		/**
+		 * @brief Insert the element, also when his key is in the table.
+		 * @note The element must not be in a table.
+		 */
+		void insert_multi(reference value) {
+			link(value, hash_of(key_of()(value)));
+		}
+
+		/**
+		 * @brief Remove the element from the table, in O(1).
+		 * @note The element must be in this table.
+		 */
+		void remove(reference value) {
+			node_type* _pNode = traits_type::to_hook(&value);
+			assert(_pNode->is_linked());
+
+			_pNode->unlink();
+			--m_sSize;
+		}
+
+		/**
+		 * @brief Remove the first element with the given key.
+		 * @return The removed element or nullptr when not found.
+		 */
+		pointer erase(const key_type& key) {
+			pointer _pValue = find(key);
+			if(_pValue != nullptr) remove(*_pValue);
+			return _pValue;
+		}
+
+		/**
+		 * @brief Find a element with the given key.
+		 * @return The element or nullptr when not found.
+		 */
+		pointer find(const key_type& key) {
+			node_type* _pNode = find_node(key, hash_of(key));
+			return (_pNode == nullptr) ? nullptr : traits_type::to_value(_pNode);
+		}
+		const_pointer find(const key_type& key) const {
+			return const_cast<self_type*>(this)->find(key);
+		}
+
+		bool contains(const key_type& key) const { return find(key) != nullptr; }
+
+		/**
+		 * @brief Get the number of elements with the given key.
+		 */
+		size_type count(const key_type& key) const {
+			result_type _hash = hash_of(key);
+			size_type _count = 0;
+			key_equal _equal;
+
+			for(node_type* _pNode = m_aBuckets[bucket_of(_hash)]; _pNode != nullptr; _pNode = _pNode->Next) {
+				if(_pNode->Hash == _hash && _equal(key_of()(*traits_type::to_value(_pNode)), key))
+					++_count;
+			}
+			return _count;
+		}
+
+		/**
+		 * @brief Remove all elements, the elements are not destroyed.
+		 */
+		void clear() {
+			for(size_type i = 0; i < BucketCount; i++) {
+				while(m_aBuckets[i] != nullptr) m_aBuckets[i]->unlink();
+			}
+			m_sSize = 0;
+		}
+
+		/**
+		 * @brief Call fn(element) for all elements.
+		 * @note fn can remove the current element.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) {
+			for(size_type i = 0; i < BucketCount; i++) {
+				node_type* _pNode = m_aBuckets[i];
+				while(_pNode != nullptr) {
+					node_type* _pNext = _pNode->Next;
+					fn(*traits_type::to_value(_pNode));
+					_pNode = _pNext;
+				}
+			}
+			return fn;
+		}
+	private:
+		static result_type hash_of(const key_type& key) {
+			return internal::hash_mix(hasher()(key));
+		}
+		static size_type bucket_of(result_type hash) {
+			return size_type(hash) & (BucketCount - 1);
+		}
+
+		void link(reference value, result_type hash) {
+			node_type* _pNode = traits_type::to_hook(&value);
+			assert(!_pNode->is_linked());
+
+			_pNode->Hash = hash;
+			_pNode->link_head(&m_aBuckets[bucket_of(hash)]);
+			++m_sSize;
+		}
+
+		node_type* find_node(const key_type& key, result_type hash) const {
+			key_equal _equal;
+
+			for(node_type* _pNode = m_aBuckets[bucket_of(hash)]; _pNode != nullptr; _pNode = _pNode->Next) {
+				if(_pNode->Hash == hash && _equal(key_of()(*traits_type::to_value(_pNode)), key))
+					return _pNode;
+			}
+			return nullptr;
+		}
+	private:
+		node_type* m_aBuckets[NBuckets];
+		size_type  m_sSize;
+	};
+
+	template <typename TKey, typename T, intrusive_hash_node T::*Hook, class TKeyOf, size_t NBuckets,
+			  class THash = squads::hash<TKey>, class TEqual = squads::equal_to<TKey> >
+	using intrusive_hash_table = basic_intrusive_hash_table<TKey, T, Hook, TKeyOf, NBuckets, THash, TEqual>;
+}
+
+#endif // __SQUADS_INTRUSIVE_HASH_TABLE_H__
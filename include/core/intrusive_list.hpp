@@ -0,0 +1,344 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_INTRUSIVE_LIST_H__
+#define __SQUADS_INTRUSIVE_LIST_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "iterator.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief Convert between a element and the hook, that is embedded in the element.
+		 * @tparam T The type of the element.
+		 * @tparam THook The type of the hook.
+		 * @tparam Hook The pointer to the hook member.
+		 */
+		template <typename T, typename THook, THook T::*Hook>
+		struct intrusive_hook_traits {
+			static THook* to_hook(T* value) 			{ return &(value->*Hook); }
+			static const THook* to_hook(const T* value) { return &(value->*Hook); }
+
+			static T* to_value(THook* hook) {
+				return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - offset());
+			}
+			static const T* to_value(const THook* hook) {
+				return reinterpret_cast<const T*>(reinterpret_cast<const char*>(hook) - offset());
+			}
+			/**
+			 * @brief Get the offset of the hook inside the element.
+			 */
+			static squads::ptrdiff_t offset() {
+				// A dummy, well aligned address and not nullptr, to keep the compiler happy
+				const T* _pDummy = reinterpret_cast<const T*>(0x1000);
+				return reinterpret_cast<const char*>(&(_pDummy->*Hook)) - reinterpret_cast<const char*>(_pDummy);
+			}
+		};
+	}
+
+	/**
+	 * @brief The hook of a intrusive list, embed it in the element.
+	 * A hook that is not in a list has nullptr links.
+	 *
+	 * @code
+	 * struct timer {
+	 *     int timeout;
+	 *     squads::intrusive_list_node hook;
+	 * };
+	 * squads::intrusive_list<timer, &timer::hook> list;
+	 * @endcode
+	 */
+	struct intrusive_list_node {
+		intrusive_list_node* Prev;
+		intrusive_list_node* Next;
+
+		intrusive_list_node() : Prev(nullptr), Next(nullptr) { }
+
+		/// A copied element is not in the list of the source
+		intrusive_list_node(const intrusive_list_node&) : Prev(nullptr), Next(nullptr) { }
+		intrusive_list_node& operator = (const intrusive_list_node&) { return *this; }
+
+		/**
+		 * @brief Is this hook in a list?
+		 */
+		bool is_linked() const { return Next != nullptr; }
+
+		/**
+		 * @brief Remove this hook from his list, in O(1).
+		 * @note Use this only when the list don't count his size,
+		 * else use basic_intrusive_list::remove.
+		 */
+		void unlink() {
+			Prev->Next = Next;
+			Next->Prev = Prev;
+			Prev = Next = nullptr;
+		}
+
+		/**
+		 * @brief Link this hook in front of the given hook.
+		 */
+		void link_before(intrusive_list_node* pos) {
+			Prev = pos->Prev;
+			Next = pos;
+			pos->Prev->Next = this;
+			pos->Prev = this;
+		}
+	};
+
+	/**
+	 * @brief Bidirectional iterator of the basic_intrusive_list.
+	 */
+	template <typename T, typename TTraits>
+	class basic_intrusive_list_iterator {
+		template <typename U, typename UTraits> friend class basic_intrusive_list_iterator;
+	public:
+		using iterator_category = squads::bidirectional_iterator_tag;
+		using value_type = T;
+		using pointer = value_type*;
+		using reference = value_type&;
+		using difference_type = squads::ptrdiff_t;
+		using self_type = basic_intrusive_list_iterator<T, TTraits>;
+		using node_type = intrusive_list_node;
+
+		basic_intrusive_list_iterator() : m_pNode(nullptr) { }
+		explicit basic_intrusive_list_iterator(const node_type* node)
+			: m_pNode(const_cast<node_type*>(node)) { }
+
+		template <typename U>
+		basic_intrusive_list_iterator(const basic_intrusive_list_iterator<U, TTraits>& other)
+			: m_pNode(other.m_pNode) { }
+
+		reference operator*() const 	{ return *get(); }
+		pointer operator->() const 		{ return get(); }
+		pointer get() const 			{ return TTraits::to_value(m_pNode); }
+		node_type* get_node() const 	{ return m_pNode; }
+
+		self_type& operator++() 	{ m_pNode = m_pNode->Next; return *this; }
+		self_type& operator--() 	{ m_pNode = m_pNode->Prev; return *this; }
+		self_type operator++(int) 	{ self_type _copy(*this); m_pNode = m_pNode->Next; return _copy; }
+		self_type operator--(int) 	{ self_type _copy(*this); m_pNode = m_pNode->Prev; return _copy; }
+
+		template <typename U>
+		bool operator == (const basic_intrusive_list_iterator<U, TTraits>& rhs) const { return m_pNode == rhs.m_pNode; }
+		template <typename U>
+		bool operator != (const basic_intrusive_list_iterator<U, TTraits>& rhs) const { return m_pNode != rhs.m_pNode; }
+	private:
+		node_type* m_pNode;
+	};
+
+	/**
+	 * @brief A doubly linked list, that links the elements with a hook inside the element.
+	 *
+	 * The list don't own the elements and never allocate memory. Insert and remove,
+	 * also from the middle of the list, are O(1). A element can be in so many lists
+	 * as he have hooks.
+	 *
+	 * @tparam T The type of the elements.
+	 * @tparam Hook The pointer to the intrusive_list_node member of T.
+	 *
+	 * @note The elements must outlive the list or be removed before destroyed.
+	 * Is not thread-safe.
+	 */
+	template <typename T, intrusive_list_node T::*Hook>
+	class basic_intrusive_list {
+	public:
+		using value_type = T;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using node_type = intrusive_list_node;
+		using traits_type = internal::intrusive_hook_traits<T, intrusive_list_node, Hook>;
+		using self_type = basic_intrusive_list<T, Hook>;
+
+		using iterator = basic_intrusive_list_iterator<T, traits_type>;
+		using const_iterator = basic_intrusive_list_iterator<const T, traits_type>;
+		using reverse_iterator = squads::reverse_iterator<iterator>;
+		using const_reverse_iterator = squads::reverse_iterator<const_iterator>;
+
+		basic_intrusive_list() : m_sSize(0) { m_nodeRoot.Prev = m_nodeRoot.Next = &m_nodeRoot; }
+		~basic_intrusive_list() { clear(); }
+
+		basic_intrusive_list(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		iterator begin() 				{ return iterator(m_nodeRoot.Next); }
+		const_iterator begin() const 	{ return const_iterator(m_nodeRoot.Next); }
+		iterator end() 					{ return iterator(&m_nodeRoot); }
+		const_iterator end() const 		{ return const_iterator(&m_nodeRoot); }
+
+		reverse_iterator rbegin() 				{ return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const 	{ return const_reverse_iterator(end()); }
+		reverse_iterator rend() 				{ return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const 	{ return const_reverse_iterator(begin()); }
+
+		size_type size() const 		{ return m_sSize; }
+		bool empty() const 			{ return m_sSize == 0; }
+
+		reference front() 				{ assert(!empty()); return *begin(); }
+		const_reference front() const 	{ assert(!empty()); return *begin(); }
+		reference back() 				{ assert(!empty()); return *iterator(m_nodeRoot.Prev); }
+		const_reference back() const 	{ assert(!empty()); return *const_iterator(m_nodeRoot.Prev); }
+
+		void push_front(reference value) 	{ insert(begin(), value); }
+		void push_back(reference value) 	{ insert(end(), value); }
+
+		void pop_front() { assert(!empty()); remove(front()); }
+		void pop_back() { assert(!empty()); remove(back()); }
+
+		/**
+		 * @brief Insert the element in front of pos.
+		 * @note The element must not be in a list.
+		 * @return The iterator to the inserted element.
+		 */
+		iterator insert(const_iterator pos, reference value) {
+			node_type* _pNode = traits_type::to_hook(&value);
+			assert(!_pNode->is_linked());
+
+			_pNode->link_before(pos.get_node());
+			++m_sSize;
+			return iterator(_pNode);
+		}
+
+		/**
+		 * @brief Remove the element from the list, in O(1).
+		 * @return The iterator to the next element.
+		 */
+		iterator erase(const_iterator pos) {
+			assert(pos != end());
+			node_type* _pNode = pos.get_node();
+			node_type* _pNext = _pNode->Next;
+
+			_pNode->unlink();
+			--m_sSize;
+			return iterator(_pNext);
+		}
+
+		/**
+		 * @brief Remove the element from the list, in O(1).
+		 * @note The element must be in this list.
+		 */
+		void remove(reference value) {
+			erase(iterator_to(value));
+		}
+
+		/**
+		 * @brief Remove all elements with pred(element) == true.
+		 * @return The number of removed elements.
+		 */
+		template <class TPred>
+		size_type remove_if(TPred pred) {
+			size_type _count = 0;
+			for(iterator it = begin(); it != end(); ) {
+				if(pred(*it)) { it = erase(it); ++_count; }
+				else ++it;
+			}
+			return _count;
+		}
+
+		/**
+		 * @brief Move the element to the front, for LRU lists.
+		 */
+		void move_to_front(reference value) { splice(begin(), *this, iterator_to(value)); }
+		/**
+		 * @brief Move the element to the back.
+		 */
+		void move_to_back(reference value) { splice(end(), *this, iterator_to(value)); }
+
+		/**
+		 * @brief Move the element it from the list other in front of pos.
+		 */
+		void splice(const_iterator pos, self_type& other, const_iterator it) {
+			node_type* _pNode = it.get_node();
+			if(_pNode == pos.get_node() || _pNode->Next == pos.get_node()) return;
+
+			_pNode->unlink();
+			--other.m_sSize;
+			_pNode->link_before(pos.get_node());
+			++m_sSize;
+		}
+
+		/**
+		 * @brief Move all elements of the list other in front of pos.
+		 */
+		void splice(const_iterator pos, self_type& other) {
+			if(&other == this || other.empty()) return;
+
+			node_type* _pFirst = other.m_nodeRoot.Next;
+			node_type* _pLast = other.m_nodeRoot.Prev;
+			node_type* _pPos = pos.get_node();
+
+			other.m_nodeRoot.Prev = other.m_nodeRoot.Next = &other.m_nodeRoot;
+
+			_pFirst->Prev = _pPos->Prev;
+			_pPos->Prev->Next = _pFirst;
+			_pLast->Next = _pPos;
+			_pPos->Prev = _pLast;
+
+			m_sSize += other.m_sSize;
+			other.m_sSize = 0;
+		}
+
+		/**
+		 * @brief Get the iterator of a element in the list, in O(1).
+		 */
+		iterator iterator_to(reference value) {
+			assert(traits_type::to_hook(&value)->is_linked());
+			return iterator(traits_type::to_hook(&value));
+		}
+		const_iterator iterator_to(const_reference value) const {
+			assert(traits_type::to_hook(&value)->is_linked());
+			return const_iterator(traits_type::to_hook(&value));
+		}
+
+		/**
+		 * @brief Remove all elements, the elements are not destroyed.
+		 */
+		void clear() {
+			node_type* _pNode = m_nodeRoot.Next;
+			while(_pNode != &m_nodeRoot) {
+				node_type* _pNext = _pNode->Next;
+				_pNode->Prev = _pNode->Next = nullptr;
+				_pNode = _pNext;
+			}
+			m_nodeRoot.Prev = m_nodeRoot.Next = &m_nodeRoot;
+			m_sSize = 0;
+		}
+
+		/**
+		 * @brief Call fn(element) for all elements.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) {
+			for(iterator it = begin(); it != end(); ++it) fn(*it);
+			return fn;
+		}
+	private:
+		node_type m_nodeRoot;
+		size_type m_sSize;
+	};
+
+	template <typename T, intrusive_list_node T::*Hook>
+	using intrusive_list = basic_intrusive_list<T, Hook>;
+}
+
+#endif // __SQUADS_INTRUSIVE_LIST_H__
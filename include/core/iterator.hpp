@@ -177,6 +177,9 @@ namespace squads {
 		constexpr bool operator== (const self_type& iter) const {
 			return m_itter == iter.m_itter; }
 
+		constexpr bool operator!= (const self_type& iter) const {
+			return m_itter != iter.m_itter; }
+
 		constexpr bool operator< (const self_type& iter) const {
 			return iter.m_itter < m_itter; }
 
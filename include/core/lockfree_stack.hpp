@@ -0,0 +1,154 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_LOCKFREE_STACK_H__
+#define __SQUADS_LOCKFREE_STACK_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include <new>
+
+#include "algorithm.hpp"
+#include "atomic/atomic.hpp"
+
+namespace squads {
+	/**
+	 * @brief A lock-free Treiber stack with a fixed capacity of N elements, for more producers and consumers.
+	 *
+	 * The nodes are a array inside the stack. Free nodes are kept in a second Treiber stack,
+	 * so push and pop never allocate. Both heads are one word: the lower half is the node index
+	 * and the upper half is a tag. The tag is incremented on each change, so a pop never succeeds
+	 * on a head, that was popped and pushed again in between (ABA). This needs only a CAS of one word,
+	 * which is lock-free on 32 bit targets too.
+	 *
+	 * @tparam T The type of the elements.
+	 * @tparam N The number of elements, less then 2^(bits of a long / 2) - 1.
+	 *
+	 * @note The tag is 16 bit on 32 bit targets. ABA is only possible,
+	 * when a pop is preempted while 65536 other changes happen.
+	 */
+	template <typename T, size_t N>
+	class basic_lockfree_stack {
+		using word_type = unsigned long;
+		using atomic_word = atomic::_atomic<word_type>;
+
+		static constexpr unsigned int IndexBits = sizeof(word_type) * 4;
+		static constexpr word_type IndexMask = (word_type(1) << IndexBits) - 1;
+		/// The index of no node
+		static constexpr word_type Nil = IndexMask;
+
+		static_assert(N >= 1 && N < Nil, "basic_lockfree_stack: N is too large for the index");
+
+		struct node {
+			atomic_word Next;
+			alignas(T) unsigned char Storage[sizeof(T)];
+
+			node() : Next(Nil) { }
+			T* get() { return reinterpret_cast<T*>(Storage); }
+		};
+	public:
+		using value_type = T;
+		using size_type = squads::size_t;
+		using self_type = basic_lockfree_stack<T, N>;
+
+		static constexpr size_type Capacity = N;
+
+		basic_lockfree_stack() : m_atomicHead(Nil), m_atomicFree(0) {
+			for(size_type i = 0; i + 1 < Capacity; i++) m_aNodes[i].Next.store(word_type(i + 1), atomic::memory_order::Relaxed);
+		}
+		~basic_lockfree_stack() {
+			for(word_type i = pop_index(m_atomicHead); i != Nil; i = pop_index(m_atomicHead))
+				squads::destruct(m_aNodes[i].get());
+		}
+
+		basic_lockfree_stack(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		constexpr size_type capacity() const { return Capacity; }
+
+		/**
+		 * @brief Is the stack empty, only a snapshot when other tasks use the stack.
+		 */
+		bool empty() const {
+			return index_of(m_atomicHead.load(atomic::memory_order::Acquire)) == Nil;
+		}
+
+		/**
+		 * @brief Push a copy of value.
+		 * @return False when the stack is full.
+		 */
+		bool push(const value_type& value) {
+			word_type _index = pop_index(m_atomicFree);
+			if(_index == Nil) return false;
+
+			::new (static_cast<void*>(m_aNodes[_index].Storage)) value_type(value);
+			push_index(m_atomicHead, _index);
+			return true;
+		}
+
+		/**
+		 * @brief Pop the top element.
+		 * @param[out] value The popped element.
+		 * @return False when the stack is empty.
+		 */
+		bool pop(value_type& value) {
+			word_type _index = pop_index(m_atomicHead);
+			if(_index == Nil) return false;
+
+			value_type* _pValue = m_aNodes[_index].get();
+			value = squads::move(*_pValue);
+			squads::destruct(_pValue);
+			push_index(m_atomicFree, _index);
+			return true;
+		}
+	private:
+		static word_type index_of(word_type head) 	{ return head & IndexMask; }
+		static word_type make_head(word_type index, word_type old) {
+			return index | (((old >> IndexBits) + 1) << IndexBits);
+		}
+
+		void push_index(atomic_word& head, word_type index) {
+			word_type _old = head.load(atomic::memory_order::Relaxed);
+			do {
+				m_aNodes[index].Next.store(index_of(_old), atomic::memory_order::Relaxed);
+			} while(!head.compare_exchange_weak(_old, make_head(index, _old), atomic::memory_order::Release));
+		}
+
+		word_type pop_index(atomic_word& head) {
+			word_type _old = head.load(atomic::memory_order::Acquire);
+			word_type _index;
+			do {
+				_index = index_of(_old);
+				if(_index == Nil) return Nil;
+				// the node can be popped by a other task in between, then the CAS fails on the tag
+			} while(!head.compare_exchange_weak(_old,
+						make_head(m_aNodes[_index].Next.load(atomic::memory_order::Relaxed), _old),
+						atomic::memory_order::Acquire));
+			return _index;
+		}
+	private:
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) atomic_word m_atomicHead;
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) atomic_word m_atomicFree;
+		node m_aNodes[N];
+	};
+
+	template <typename T, size_t N>
+	using lockfree_stack = basic_lockfree_stack<T, N>;
+}
+
+#endif // __SQUADS_LOCKFREE_STACK_H__
@@ -0,0 +1,319 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_LRU_CACHE_H__
+#define __SQUADS_LRU_CACHE_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include <new>
+
+#include "algorithm.hpp"
+#include "intrusive_list.hpp"
+#include "intrusive_hash_table.hpp"
+
+#include "arch/arch_utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief Get the smallest power of two, that is not smaller then n.
+		 */
+		constexpr size_t lru_bucket_count(size_t n, size_t count = 1) {
+			return (count >= n) ? count : lru_bucket_count(n, count * 2);
+		}
+
+		/**
+		 * @brief The default clock of the lru cache, arch_micros() extended to 64 bit.
+		 * @note A overflow of arch_micros() is only seen, when the clock is asked at least once
+		 * per overflow period, with a 32 bit unsigned long all 71 minutes.
+		 */
+		class lru_micros_clock {
+		public:
+			lru_micros_clock() : m_uLast(0), m_uHigh(0) { }
+
+			uint64_t operator()() {
+				unsigned long _now = arch::arch_micros();
+				if(_now < m_uLast) m_uHigh += uint64_t(~0ul) + 1;
+				m_uLast = _now;
+				return m_uHigh + _now;
+			}
+		private:
+			unsigned long m_uLast;
+			uint64_t m_uHigh;
+		};
+
+		/**
+		 * @brief The default eviction callback of the lru cache, do nothing.
+		 */
+		struct lru_evict_none {
+			template <typename K, typename V>
+			void operator()(const K&, V&) const { }
+		};
+	}
+
+	/**
+	 * @brief A least recently used cache with a fixed capacity of N entries.
+	 *
+	 * The entries are stored in a pre-allocated array inside the cache, so the cache never allocate.
+	 * A intrusive hash table find the entries, a intrusive list keeps them in the order of use,
+	 * so get, put, touch and erase are O(1). When the cache is full, put evicts the least recently used entry.
+	 *
+	 * With a time to live (ttl) each entry expires ttl microseconds after his last put,
+	 * expired entries are evicted on access or with evict_expired(). The clock is only asked
+	 * when a ttl is set.
+	 *
+	 * @tparam TKey The type of the keys.
+	 * @tparam TValue The type of the values.
+	 * @tparam N The number of entries.
+	 * @tparam THash The hasher, default squads::hash<TKey>.
+	 * @tparam TEqual The key compare, default squads::equal_to<TKey>.
+	 * @tparam TEvict Called as fn(key, value) before a entry is evicted because of the capacity or the ttl.
+	 * @tparam TClock Returns the current time in microseconds as uint64_t, default arch_micros().
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename TKey, typename TValue, size_t N,
+			  class THash = squads::hash<TKey>, class TEqual = squads::equal_to<TKey>,
+			  class TEvict = internal::lru_evict_none, class TClock = internal::lru_micros_clock>
+	class basic_lru_cache {
+		static_assert(N >= 1, "basic_lru_cache: N must be greater then 0");
+	public:
+		using key_type = TKey;
+		using value_type = TValue;
+		using size_type = squads::size_t;
+		using time_type = uint64_t;
+		using self_type = basic_lru_cache<TKey, TValue, N, THash, TEqual, TEvict, TClock>;
+
+		static constexpr size_type Capacity = N;
+		static constexpr size_type BucketCount = internal::lru_bucket_count(N);
+	private:
+		struct entry {
+			key_type Key;
+			value_type Value;
+
+			entry(const key_type& key, const value_type& value) : Key(key), Value(value) { }
+		};
+		struct node {
+			intrusive_list_node ListHook;
+			intrusive_hash_node HashHook;
+			time_type Expire;
+			alignas(entry) unsigned char Storage[sizeof(entry)];
+
+			entry* get() 				{ return reinterpret_cast<entry*>(Storage); }
+			const entry* get() const 	{ return reinterpret_cast<const entry*>(Storage); }
+		};
+		struct node_key {
+			const key_type& operator()(const node& n) const { return n.get()->Key; }
+		};
+
+		using list_type = basic_intrusive_list<node, &node::ListHook>;
+		using table_type = basic_intrusive_hash_table<key_type, node, &node::HashHook, node_key,
+			BucketCount, THash, TEqual>;
+	public:
+		/**
+		 * @brief Construct a empty cache.
+		 * @param ttl The time to live of the entries in microseconds, 0 for no expiry.
+		 */
+		explicit basic_lru_cache(time_type ttl = 0)
+			: m_aNodes(), m_tTtl(ttl), m_bAnyExpire(false), m_sHits(0), m_sMisses(0), m_sEvictions(0), m_fnEvict(), m_fnClock() {
+			for(size_type i = 0; i < Capacity; i++) m_listFree.push_back(m_aNodes[i]);
+		}
+		~basic_lru_cache() { clear(); }
+
+		basic_lru_cache(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		size_type size() const 		{ return m_listUsed.size(); }
+		bool empty() const 			{ return m_listUsed.empty(); }
+		bool full() const 			{ return m_listFree.empty(); }
+		constexpr size_type capacity() const { return Capacity; }
+
+		time_type get_ttl() const 		{ return m_tTtl; }
+		/**
+		 * @brief Set the time to live for entries, that are put after this call.
+		 */
+		void set_ttl(time_type ttl) 	{ m_tTtl = ttl; }
+
+		/**
+		 * @brief Get the value of key and mark it as most recently used.
+		 * @return The pointer to the value or nullptr when not found or expired.
+		 */
+		value_type* get(const key_type& key) {
+			node* _pNode = lookup(key);
+			if(_pNode == nullptr) { ++m_sMisses; return nullptr; }
+
+			++m_sHits;
+			m_listUsed.move_to_front(*_pNode);
+			return &_pNode->get()->Value;
+		}
+
+		/**
+		 * @brief Get the value of key, without change the order and the counters.
+		 * @return The pointer to the value or nullptr when not found.
+		 * @note A expired entry is returned too.
+		 */
+		const value_type* peek(const key_type& key) const {
+			const node* _pNode = m_tableKeys.find(key);
+			return (_pNode == nullptr) ? nullptr : &_pNode->get()->Value;
+		}
+
+		bool contains(const key_type& key) const { return peek(key) != nullptr; }
+
+		/**
+		 * @brief Insert or assign the value of key and mark it as most recently used.
+		 *
+		 * When the cache is full, the least recently used entry is evicted.
+		 * @return True when key was inserted, false when assigned.
+		 */
+		bool put(const key_type& key, const value_type& value) {
+			node* _pNode = m_tableKeys.find(key);
+			if(_pNode != nullptr) {
+				_pNode->get()->Value = value;
+				_pNode->Expire = expire_time();
+				m_listUsed.move_to_front(*_pNode);
+				return false;
+			}
+			if(full()) evict(m_listUsed.back());
+
+			_pNode = &m_listFree.front();
+			m_listFree.pop_front();
+
+			::new (static_cast<void*>(_pNode->Storage)) entry(key, value);
+			_pNode->Expire = expire_time();
+			m_tableKeys.insert(*_pNode);
+			m_listUsed.push_front(*_pNode);
+			return true;
+		}
+
+		/**
+		 * @brief Mark key as most recently used, without change his expiry.
+		 * @return False when not found or expired.
+		 */
+		bool touch(const key_type& key) {
+			node* _pNode = lookup(key);
+			if(_pNode != nullptr) m_listUsed.move_to_front(*_pNode);
+			return _pNode != nullptr;
+		}
+
+		/**
+		 * @brief Remove key, the eviction callback is not called.
+		 * @return False when not found.
+		 */
+		bool erase(const key_type& key) {
+			node* _pNode = m_tableKeys.find(key);
+			if(_pNode != nullptr) release(*_pNode);
+			return _pNode != nullptr;
+		}
+
+		/**
+		 * @brief Evict all expired entries.
+		 * @return The number of evicted entries.
+		 */
+		size_type evict_expired() {
+			if(m_tTtl == 0 && !m_bAnyExpire) return 0;
+
+			time_type _now = m_fnClock();
+			size_type _count = 0;
+			for(typename list_type::iterator it = m_listUsed.begin(); it != m_listUsed.end(); ) {
+				node& _node = *it; ++it;
+				if(is_expired(_node, _now)) { evict(_node); ++_count; }
+			}
+			return _count;
+		}
+
+		/**
+		 * @brief Remove all entries, the eviction callback is not called.
+		 */
+		void clear() {
+			while(!m_listUsed.empty()) release(m_listUsed.back());
+		}
+
+		/**
+		 * @brief Call fn(key, value) for all entries, from the most to the least recently used.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) {
+			for(typename list_type::iterator it = m_listUsed.begin(); it != m_listUsed.end(); ++it)
+				fn(static_cast<const key_type&>(it->get()->Key), it->get()->Value);
+			return fn;
+		}
+
+		size_type get_hits() const 		{ return m_sHits; }
+		size_type get_misses() const 	{ return m_sMisses; }
+		/// The number of entries evicted because of the capacity or the ttl
+		size_type get_evictions() const { return m_sEvictions; }
+
+		void reset_stats() { m_sHits = m_sMisses = m_sEvictions = 0; }
+	private:
+		/// Find key and evict it, when expired.
+		node* lookup(const key_type& key) {
+			node* _pNode = m_tableKeys.find(key);
+			if(_pNode != nullptr && _pNode->Expire != 0 && is_expired(*_pNode, m_fnClock())) {
+				evict(*_pNode);
+				_pNode = nullptr;
+			}
+			return _pNode;
+		}
+
+		time_type expire_time() {
+			if(m_tTtl == 0) return 0;
+
+			m_bAnyExpire = true;
+			return m_fnClock() + m_tTtl;
+		}
+
+		static bool is_expired(const node& n, time_type now) {
+			return n.Expire != 0 && now >= n.Expire;
+		}
+
+		void evict(node& n) {
+			m_fnEvict(static_cast<const key_type&>(n.get()->Key), n.get()->Value);
+			++m_sEvictions;
+			release(n);
+		}
+
+		void release(node& n) {
+			m_tableKeys.remove(n);
+			m_listUsed.remove(n);
+			squads::destruct(n.get());
+			m_listFree.push_front(n);
+		}
+	private:
+		/// The node storage, declared first so it is destroyed after the list and the table
+		node m_aNodes[N];
+		time_type m_tTtl;
+		/// Was a entry ever put with a ttl
+		bool m_bAnyExpire;
+		size_type m_sHits;
+		size_type m_sMisses;
+		size_type m_sEvictions;
+		TEvict m_fnEvict;
+		TClock m_fnClock;
+		list_type m_listUsed;
+		list_type m_listFree;
+		table_type m_tableKeys;
+	};
+
+	template <typename TKey, typename TValue, size_t N,
+			  class THash = squads::hash<TKey>, class TEqual = squads::equal_to<TKey>,
+			  class TEvict = internal::lru_evict_none, class TClock = internal::lru_micros_clock>
+	using lru_cache = basic_lru_cache<TKey, TValue, N, THash, TEqual, TEvict, TClock>;
+}
+
+#endif // __SQUADS_LRU_CACHE_H__
@@ -0,0 +1,137 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_MPSC_QUEUE_H__
+#define __SQUADS_MPSC_QUEUE_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "intrusive_list.hpp"
+#include "atomic/atomic.hpp"
+
+namespace squads {
+	/**
+	 * @brief The hook of a basic_mpsc_queue, embed it in the element.
+	 */
+	struct mpsc_queue_node {
+		atomic::_atomic_ptr<mpsc_queue_node> Next;
+
+		mpsc_queue_node() : Next(nullptr) { }
+		/// A copied element is not in the queue of the source
+		mpsc_queue_node(const mpsc_queue_node&) : Next(nullptr) { }
+		mpsc_queue_node& operator = (const mpsc_queue_node&) { return *this; }
+	};
+
+	/**
+	 * @brief A intrusive queue for more producers and one consumer, after Dmitry Vyukov.
+	 *
+	 * push() is wait-free: one exchange of the head and one store, so it can be used in a ISR.
+	 * pop() is lock-free and must only be called by one consumer task.
+	 * The queue never allocate, the elements are linked with the hook inside.
+	 *
+	 * @tparam T The type of the elements.
+	 * @tparam Hook The pointer to the mpsc_queue_node member of T.
+	 *
+	 * @code
+	 * struct message {
+	 *     int id;
+	 *     squads::mpsc_queue_node hook;
+	 * };
+	 * squads::mpsc_queue<message, &message::hook> queue;
+	 * @endcode
+	 *
+	 * @note A element must stay valid until it is popped. pop() can return nullptr
+	 * for a short time, while a producer is between his exchange and his store.
+	 */
+	template <typename T, mpsc_queue_node T::*Hook>
+	class basic_mpsc_queue {
+	public:
+		using value_type = T;
+		using pointer = T*;
+		using reference = T&;
+		using node_type = mpsc_queue_node;
+		using traits_type = internal::intrusive_hook_traits<T, mpsc_queue_node, Hook>;
+		using self_type = basic_mpsc_queue<T, Hook>;
+
+		basic_mpsc_queue() : m_atomicHead(&m_nodeStub), m_pTail(&m_nodeStub) { }
+
+		basic_mpsc_queue(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		/**
+		 * @brief Push the element, wait-free, for all producers.
+		 */
+		void push(reference value) {
+			push_node(traits_type::to_hook(&value));
+		}
+
+		/**
+		 * @brief Pop the oldest element, only for the consumer.
+		 * @return The element or nullptr when empty.
+		 */
+		pointer pop() {
+			node_type* _pTail = m_pTail;
+			node_type* _pNext = _pTail->Next.load(atomic::memory_order::Acquire);
+
+			if(_pTail == &m_nodeStub) {
+				if(_pNext == nullptr) return nullptr;
+				m_pTail = _pNext;
+				_pTail = _pNext;
+				_pNext = _pNext->Next.load(atomic::memory_order::Acquire);
+			}
+			if(_pNext != nullptr) {
+				m_pTail = _pNext;
+				return traits_type::to_value(_pTail);
+			}
+
+			// the tail is the last node, or a producer has not linked his node yet
+			if(_pTail != m_atomicHead.load(atomic::memory_order::Acquire)) return nullptr;
+
+			push_node(&m_nodeStub);
+			_pNext = _pTail->Next.load(atomic::memory_order::Acquire);
+			if(_pNext == nullptr) return nullptr;
+
+			m_pTail = _pNext;
+			return traits_type::to_value(_pTail);
+		}
+
+		/**
+		 * @brief Is the queue empty, only for the consumer.
+		 */
+		bool empty() const {
+			return m_pTail == &m_nodeStub && m_nodeStub.Next.load(atomic::memory_order::Acquire) == nullptr;
+		}
+	private:
+		void push_node(node_type* node) {
+			node->Next.store(nullptr, atomic::memory_order::Relaxed);
+			node_type* _pPrev = m_atomicHead.exchange(node, atomic::memory_order::AcqRel);
+			_pPrev->Next.store(node, atomic::memory_order::Release);
+		}
+	private:
+		/// The last pushed node, for the producers
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) atomic::_atomic_ptr<node_type> m_atomicHead;
+		/// The next node to pop, for the consumer
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) node_type* m_pTail;
+		node_type m_nodeStub;
+	};
+
+	template <typename T, mpsc_queue_node T::*Hook>
+	using mpsc_queue = basic_mpsc_queue<T, Hook>;
+}
+
+#endif // __SQUADS_MPSC_QUEUE_H__
@@ -52,6 +52,11 @@ namespace squads {
 		explicit  basic_pair(first_const_reference f) noexcept
 			: m_first(f) { }
 
+		/**
+		 * @brief Construct the second value, only when the types are not the same,
+		 * else the signature is the one of the first value.
+		 */
+		template <typename U = TSECOND, typename = squads::enable_if_t<!squads::is_same<U, TFIRST>::value> >
 		explicit basic_pair(second_const_reference s) noexcept
 			: m_second(s) { }
 
@@ -73,21 +78,21 @@ namespace squads {
 		}
 
 		self_type& operator = (const self_type& rhs) noexcept {
-			squads::swap(m_first,  rhs.m_first);
-			squads::swap(m_second, rhs.m_second);
+			m_first = rhs.m_first;
+			m_second = rhs.m_second;
+			return *this;
 		}
 
-		bool operator == (const self_type& rhs) noexcept {
-			if(m_first != rhs.m_first) return false;
-			return m_second == rhs.m_second;
+		bool operator == (const self_type& rhs) const noexcept {
+			if(first() != rhs.first()) return false;
+			return second() == rhs.second();
 		}
-		bool operator != (const self_type& rhs) noexcept {
-			if(m_first == rhs.m_first) return false;
-			return m_second != rhs.m_second;
+		bool operator != (const self_type& rhs) const noexcept {
+			return !(*this == rhs);
 		}
 	private:
-		ebo_storage<T, 0>  m_first;
-		ebo_storage<U, 1>  m_second;
+		ebo_storage<TFIRST, 0>  m_first;
+		ebo_storage<TSECOND, 1>  m_second;
 	};
 
 	template<typename TFIRST, typename TSECOND>
@@ -0,0 +1,306 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_PAIRING_HEAP_H__
+#define __SQUADS_PAIRING_HEAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "tuple.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief A node of a basic_pairing_heap.
+		 * Prev is the parent for the first child, else the left sibling.
+		 */
+		template <typename T>
+		struct pairing_heap_node {
+			T Value;
+			pairing_heap_node* Child;
+			pairing_heap_node* Sibling;
+			pairing_heap_node* Prev;
+
+			explicit pairing_heap_node(const T& value)
+				: Value(value), Child(nullptr), Sibling(nullptr), Prev(nullptr) { }
+		};
+	}
+
+	/**
+	 * @brief A addressable priority queue as pairing heap.
+	 *
+	 * push() returns a handle to the element, that is valid until the element is popped
+	 * or erased. With the handle the element can be moved forward (decrease_key) in O(1),
+	 * be changed (update) or be erased in O(log n) amortized, for example to reschedule
+	 * or cancel timers. top() is the first element in the order of TCompare, so
+	 * squads::less gives a min heap.
+	 *
+	 * The nodes are allocated one by one through the allocator, so a pool allocator can be used.
+	 *
+	 * @tparam T The type of the elements.
+	 * @tparam TCompare The order of the elements, default squads::less<T>.
+	 * @tparam TAllocator The allocator for the nodes.
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename T, class TCompare = squads::less<T>,
+			  class TAllocator = squads::default_allocator<> >
+	class basic_pairing_heap {
+		using node_type = internal::pairing_heap_node<T>;
+	public:
+		using value_type = T;
+		using size_type = squads::size_t;
+		using value_compare = TCompare;
+		using allocator_type = TAllocator;
+		using handle_type = node_type*;
+		using self_type = basic_pairing_heap<T, TCompare, TAllocator>;
+
+		basic_pairing_heap() : m_pRoot(nullptr), m_tupleState(size_type(0), value_compare(), allocator_type()) { }
+		~basic_pairing_heap() { clear(); }
+
+		basic_pairing_heap(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		basic_pairing_heap(self_type&& other) : basic_pairing_heap() { swap(other); }
+		self_type& operator = (self_type&& other) { swap(other); return *this; }
+
+		size_type size() const 	{ return squads::get<0>(m_tupleState); }
+		bool empty() const 		{ return m_pRoot == nullptr; }
+
+		/**
+		 * @brief Get the first element in the order of TCompare.
+		 */
+		const value_type& top() const {
+			assert(!empty());
+			return m_pRoot->Value;
+		}
+		handle_type top_handle() const { return m_pRoot; }
+
+		/**
+		 * @brief Get the element of a handle.
+		 */
+		const value_type& value(handle_type handle) const { return handle->Value; }
+
+		/**
+		 * @brief Add a element in O(1).
+		 * @return The handle of the element or nullptr on allocation failure.
+		 */
+		handle_type push(const value_type& value) {
+			void* _mem = allocator().allocate(1, sizeof(node_type), alignof(node_type));
+			if(_mem == nullptr) return nullptr;
+
+			node_type* _pNode = ::new (_mem) node_type(value);
+			m_pRoot = link(m_pRoot, _pNode);
+			++count();
+			return _pNode;
+		}
+
+		/**
+		 * @brief Remove the top element, the handle is invalid then.
+		 */
+		void pop() {
+			assert(!empty());
+			node_type* _pOld = m_pRoot;
+
+			m_pRoot = combine(_pOld->Child);
+			delete_node(_pOld);
+		}
+
+		/**
+		 * @brief Copy and remove the top element.
+		 * @return False when the heap is empty.
+		 */
+		bool pop(value_type& value) {
+			if(empty()) return false;
+			value = m_pRoot->Value;
+			pop();
+			return true;
+		}
+
+		/**
+		 * @brief Set a new value, that is not after the old value in the order of TCompare.
+		 */
+		void decrease_key(handle_type handle, const value_type& value) {
+			assert(!compare()(handle->Value, value));
+			handle->Value = value;
+			if(handle == m_pRoot) return;
+
+			detach(handle);
+			m_pRoot = link(m_pRoot, handle);
+		}
+
+		/**
+		 * @brief Set a new value in any direction, the handle stay valid.
+		 */
+		void update(handle_type handle, const value_type& value) {
+			if(!compare()(handle->Value, value)) {
+				decrease_key(handle, value);
+				return;
+			}
+			node_type* _pChildren = handle->Child;
+			handle->Child = nullptr;
+			handle->Value = value;
+
+			if(handle == m_pRoot) {
+				m_pRoot = combine(_pChildren);
+			} else {
+				detach(handle);
+				m_pRoot = link(m_pRoot, combine(_pChildren));
+			}
+			m_pRoot = link(m_pRoot, handle);
+		}
+
+		/**
+		 * @brief Remove the element of a handle, the handle is invalid then.
+		 */
+		void erase(handle_type handle) {
+			if(handle == m_pRoot) {
+				pop();
+				return;
+			}
+			detach(handle);
+			m_pRoot = link(m_pRoot, combine(handle->Child));
+			delete_node(handle);
+		}
+
+		/**
+		 * @brief Move all elements of other into this heap in O(1), the handles stay valid.
+		 * @note Both heaps must use the same allocator.
+		 */
+		void merge(self_type& other) {
+			if(this == &other) return;
+
+			m_pRoot = link(m_pRoot, other.m_pRoot);
+			count() += other.count();
+			other.m_pRoot = nullptr;
+			other.count() = 0;
+		}
+
+		/**
+		 * @brief Remove all elements, all handles are invalid then.
+		 */
+		void clear() {
+			node_type* _pNode = m_pRoot;
+
+			// Walk the tree as list, the children are spliced in after the node
+			while(_pNode != nullptr) {
+				if(_pNode->Child != nullptr) {
+					node_type* _pLast = _pNode->Child;
+					while(_pLast->Sibling != nullptr) _pLast = _pLast->Sibling;
+
+					_pLast->Sibling = _pNode->Sibling;
+					_pNode->Sibling = _pNode->Child;
+				}
+				node_type* _pNext = _pNode->Sibling;
+				delete_node(_pNode);
+				_pNode = _pNext;
+			}
+			m_pRoot = nullptr;
+		}
+
+		void swap(self_type& other) {
+			squads::swap(m_pRoot, other.m_pRoot);
+			m_tupleState.swap(other.m_tupleState);
+		}
+	private:
+		/// Link two roots, the later one becomes the first child of the other
+		node_type* link(node_type* a, node_type* b) {
+			if(a == nullptr) return b;
+			if(b == nullptr) return a;
+			if(compare()(b->Value, a->Value)) squads::swap(a, b);
+
+			b->Sibling = a->Child;
+			if(a->Child != nullptr) a->Child->Prev = b;
+			b->Prev = a;
+			a->Child = b;
+			a->Sibling = nullptr;
+			a->Prev = nullptr;
+			return a;
+		}
+
+		/// Cut a node with its subtree out of the tree
+		void detach(node_type* node) {
+			if(node->Prev->Child == node) node->Prev->Child = node->Sibling;
+			else node->Prev->Sibling = node->Sibling;
+
+			if(node->Sibling != nullptr) node->Sibling->Prev = node->Prev;
+			node->Sibling = nullptr;
+			node->Prev = nullptr;
+		}
+
+		/// Merge a list of siblings to one tree, in two passes
+		node_type* combine(node_type* first) {
+			if(first == nullptr) return nullptr;
+			node_type* _pPairs = nullptr;
+
+			// Left to right: link pairs and push them on a stack
+			while(first != nullptr) {
+				node_type* _pA = first;
+				node_type* _pB = _pA->Sibling;
+				if(_pB == nullptr) {
+					_pA->Sibling = _pPairs;
+					_pPairs = _pA;
+					break;
+				}
+				first = _pB->Sibling;
+				_pA->Sibling = _pB->Sibling = nullptr;
+
+				node_type* _pTree = link(_pA, _pB);
+				_pTree->Sibling = _pPairs;
+				_pPairs = _pTree;
+			}
+
+			// Right to left: link the pairs to one tree
+			node_type* _pRoot = _pPairs;
+			_pPairs = _pPairs->Sibling;
+			_pRoot->Sibling = nullptr;
+			_pRoot->Prev = nullptr;
+
+			while(_pPairs != nullptr) {
+				node_type* _pTree = _pPairs;
+				_pPairs = _pTree->Sibling;
+				_pTree->Sibling = nullptr;
+				_pRoot = link(_pRoot, _pTree);
+			}
+			return _pRoot;
+		}
+
+		void delete_node(node_type* node) {
+			squads::destruct(node);
+			allocator().deallocate(node, 1, sizeof(node_type), alignof(node_type));
+			--count();
+		}
+
+		size_type& count() 				{ return squads::get<0>(m_tupleState); }
+		value_compare& compare() 		{ return squads::get<1>(m_tupleState); }
+		allocator_type& allocator() 	{ return squads::get<2>(m_tupleState); }
+	private:
+		node_type* 		m_pRoot;
+		/// The size, the comparator and the allocator, empty ones use no space
+		basic_tuple<size_type, value_compare, allocator_type> m_tupleState;
+	};
+
+	template <typename T, class TCompare = squads::less<T>,
+			  class TAllocator = squads::default_allocator<> >
+	using pairing_heap = basic_pairing_heap<T, TCompare, TAllocator>;
+}
+
+#endif // __SQUADS_PAIRING_HEAP_H__
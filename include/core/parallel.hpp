@@ -0,0 +1,444 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_PARALLEL_H__
+#define __SQUADS_PARALLEL_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "sort.hpp"
+#include "stable_sort.hpp"
+#include "arch/arch_thread.hpp"
+#include "atomic/atomic.hpp"
+
+namespace squads {
+	/**
+	 * @brief The worker set of the parallel algorithms.
+	 *
+	 * The workers are a pool, that is started on the first use and then kept for the lifetime
+	 * of the program, so a call only wakes them. Pinned and StackSize are used, when a worker is started.
+	 * When the pool is busy, a nested call or a call from a other task, the workers are created for the call.
+	 */
+	struct parallel_policy {
+		/// The number of workers with the caller, 0 for one per core
+		unsigned int Workers;
+		/// Below this number of elements the algorithm run serial in the caller
+		size_t Threshold;
+		/// Pin worker i to core i % cores, the caller is worker 0
+		bool Pinned;
+		/// The stack size of a worker in bytes
+		unsigned int StackSize;
+
+		constexpr parallel_policy(unsigned int workers = 0, size_t threshold = SQUADS_CONFIG_PARALLEL_THRESHOLD,
+								  bool pinned = true, unsigned int stack = SQUADS_CONFIG_PARALLEL_STACKSIZE)
+			: Workers(workers), Threshold(threshold), Pinned(pinned), StackSize(stack) { }
+	};
+
+	namespace internal {
+		static constexpr size_t ParallelMaxWorkers = SQUADS_CONFIG_PARALLEL_MAX_WORKERS;
+
+		/// The number of workers for n elements, 1 means serial
+		inline size_t parallel_workers(const parallel_policy& policy, size_t n) {
+			if (n < policy.Threshold || n < 2) return 1;
+
+			size_t _workers = (policy.Workers != 0) ? policy.Workers : arch::arch_thread_cores();
+			_workers = squads::min<size_t>(_workers, ParallelMaxWorkers);
+			_workers = squads::min<size_t>(_workers, n);
+			return (_workers == 0) ? 1 : _workers;
+		}
+
+		/// The first element of part p, when n elements are split in parts
+		inline size_t parallel_bound(size_t n, size_t p, size_t parts) {
+			return size_t((unsigned long long)(n) * p / parts);
+		}
+
+		template <class TFn>
+		struct parallel_job {
+			TFn* Fn;
+			size_t Part;
+		};
+
+		template <class TFn>
+		void parallel_entry(void* arg) {
+			parallel_job<TFn>* _pJob = static_cast<parallel_job<TFn>*>(arg);
+			(*_pJob->Fn)(_pJob->Part);
+		}
+
+		/**
+		 * @brief The persistent workers of the parallel algorithms, see parallel_policy.
+		 *
+		 * Worker i waits on its start signal, runs the posted job and gives its done signal.
+		 * The pool is used by one parallel_run at a time, a second caller gets false from try_acquire().
+		 * The workers never end, so the pool has no destructor.
+		 */
+		class parallel_pool {
+		public:
+			/// The pool of the program
+			static parallel_pool& instance() {
+				static parallel_pool _pool;
+				return _pool;
+			}
+
+			bool try_acquire() { return m_atomicBusy.exchange(1, atomic::memory_order::Acquire) == 0; }
+			void release() 		{ m_atomicBusy.store(0, atomic::memory_order::Release); }
+
+			/**
+			 * @brief Run fn(arg) on worker i, the worker is started on the first use.
+			 * @return False when the worker can not be started.
+			 */
+			bool post(size_t i, const parallel_policy& policy, arch::arch_thread_fn fn, void* arg) {
+				worker& _worker = m_aWorkers[i];
+				if (_worker.Thread == nullptr && !start(i, policy)) return false;
+
+				_worker.Fn = fn;
+				_worker.Arg = arg;
+				arch::arch_signal_give(_worker.Start);
+				return true;
+			}
+
+			/// Wait until worker i has run the posted job
+			void wait(size_t i) { arch::arch_signal_take(m_aWorkers[i].Done); }
+		private:
+			struct worker {
+				arch::thread_handle_t* Thread;
+				arch::thread_signal_t* Start;
+				arch::thread_signal_t* Done;
+				arch::arch_thread_fn Fn;
+				void* Arg;
+			};
+
+			parallel_pool() : m_aWorkers(), m_atomicBusy(0) { }
+
+			bool start(size_t i, const parallel_policy& policy) {
+				worker& _worker = m_aWorkers[i];
+				if (_worker.Start == nullptr) _worker.Start = arch::arch_signal_create();
+				if (_worker.Done == nullptr) _worker.Done = arch::arch_signal_create();
+				if (_worker.Start == nullptr || _worker.Done == nullptr) return false;
+
+				int _core = policy.Pinned ? int(i % arch::arch_thread_cores()) : SQUADS_ARCH_THREAD_ANY_CORE;
+				_worker.Thread = arch::arch_thread_start(&worker_loop, &_worker, _core, policy.StackSize);
+				return _worker.Thread != nullptr;
+			}
+
+			static void worker_loop(void* arg) {
+				worker* _pWorker = static_cast<worker*>(arg);
+				for (;;) {
+					arch::arch_signal_take(_pWorker->Start);
+					_pWorker->Fn(_pWorker->Arg);
+					arch::arch_signal_give(_pWorker->Done);
+				}
+			}
+		private:
+			worker m_aWorkers[ParallelMaxWorkers + 1];
+			atomic::_atomic<unsigned int> m_atomicBusy;
+		};
+
+		/**
+		 * @brief Call fn(part) for all parts on workers, that are created for this call.
+		 * When a worker can not be started, its part runs in the caller.
+		 */
+		template <class TFn>
+		void parallel_run_threads(const parallel_policy& policy, size_t parts, TFn& fn) {
+			parallel_job<TFn> _aJobs[ParallelMaxWorkers + 1];
+			arch::thread_handle_t* _aThreads[ParallelMaxWorkers + 1];
+			const unsigned int _cores = arch::arch_thread_cores();
+
+			for (size_t i = 1; i < parts; i++) {
+				_aJobs[i] = parallel_job<TFn>{ &fn, i };
+				int _core = policy.Pinned ? int(i % _cores) : SQUADS_ARCH_THREAD_ANY_CORE;
+
+				_aThreads[i] = arch::arch_thread_start(&parallel_entry<TFn>, &_aJobs[i], _core, policy.StackSize);
+				if (_aThreads[i] == nullptr) fn(i);
+			}
+			fn(0);
+
+			for (size_t i = 1; i < parts; i++) {
+				if (_aThreads[i] != nullptr) arch::arch_thread_join(_aThreads[i]);
+			}
+		}
+
+		/**
+		 * @brief Call fn(part) for all parts, part 0 in the caller and the others on the pool workers.
+		 * When the pool is busy, the workers are created for this call. When a worker can
+		 * not be started, its part runs in the caller.
+		 */
+		template <class TFn>
+		void parallel_run(const parallel_policy& policy, size_t parts, TFn& fn) {
+			assert(parts <= ParallelMaxWorkers + 1);
+			if (parts < 2) { fn(0); return; }
+
+			parallel_pool& _pool = parallel_pool::instance();
+			if (!_pool.try_acquire()) {
+				parallel_run_threads(policy, parts, fn);
+				return;
+			}
+
+			parallel_job<TFn> _aJobs[ParallelMaxWorkers + 1];
+			bool _aPosted[ParallelMaxWorkers + 1];
+
+			for (size_t i = 1; i < parts; i++) {
+				_aJobs[i] = parallel_job<TFn>{ &fn, i };
+				_aPosted[i] = _pool.post(i, policy, &parallel_entry<TFn>, &_aJobs[i]);
+				if (!_aPosted[i]) fn(i);
+			}
+			fn(0);
+
+			for (size_t i = 1; i < parts; i++) {
+				if (_aPosted[i]) _pool.wait(i);
+			}
+			_pool.release();
+		}
+
+		/// Call fn(first, last) for each part of [0, n)
+		template <class TFn>
+		void parallel_for(const parallel_policy& policy, size_t n, size_t parts, TFn fn) {
+			auto _run = [&](size_t p) {
+				fn(parallel_bound(n, p, parts), parallel_bound(n, p + 1, parts));
+			};
+			parallel_run(policy, parts, _run);
+		}
+
+		/**
+		 * @brief Find the number of elements of A in the first k elements of the stable merge of A and B.
+		 */
+		template <typename T, class TPredicate>
+		size_t merge_corank(size_t k, const T* a, size_t na, const T* b, size_t nb, TPredicate& pred) {
+			size_t lo = (k > nb) ? k - nb : 0;
+			size_t hi = squads::min(k, na);
+
+			while (lo < hi) {
+				size_t i = lo + (hi - lo) / 2;
+				size_t j = k - i;
+				if (j > 0 && i < na && !pred(b[j - 1], a[i])) lo = i + 1;
+				else hi = i;
+			}
+			return lo;
+		}
+
+		/// Merge A and B to out, on equal elements A first
+		template <typename T, class TPredicate>
+		void merge_to(const T* a, const T* ae, const T* b, const T* be, T* out, TPredicate& pred) {
+			while (a < ae && b < be) *out++ = pred(*b, *a) ? *b++ : *a++;
+			while (a < ae) *out++ = *a++;
+			while (b < be) *out++ = *b++;
+		}
+
+		/**
+		 * @brief Sort the parts in parallel, then merge the sorted parts in rounds.
+		 * Each merge is split by the co-rank in more pieces, so all workers merge in every round.
+		 */
+		template <typename T, class TPredicate, class TAllocator>
+		bool parallel_merge_sort(const parallel_policy& policy, T* begin, T* end, TPredicate& pred,
+								 TAllocator& allocator, bool stable) {
+			const size_t n = (size_t)(end - begin);
+			const size_t _workers = parallel_workers(policy, n);
+
+			if (_workers < 2) {
+				if (stable) return squads::stable_sort(begin, end, pred, allocator);
+				squads::sort(begin, end, pred);
+				return true;
+			}
+
+			T* _pBuffer = static_cast<T*>(allocator.allocate(n, sizeof(T), alignof(T)));
+			if (_pBuffer == nullptr) {
+				if (stable) squads::stable_sort(begin, end, pred, allocator);
+				else squads::sort(begin, end, pred);
+				return false;
+			}
+
+			size_t _aBounds[ParallelMaxWorkers + 1];
+			for (size_t p = 0; p <= _workers; p++) _aBounds[p] = parallel_bound(n, p, _workers);
+
+			// Sort the parts and construct the buffer
+			auto _sortPart = [&](size_t p) {
+				T* _pFirst = begin + _aBounds[p];
+				T* _pLast = begin + _aBounds[p + 1];
+
+				if (stable) {
+					TAllocator _allocator(allocator);
+					squads::stable_sort(_pFirst, _pLast, pred, _allocator);
+				} else {
+					squads::sort(_pFirst, _pLast, pred);
+				}
+				for (T* _pIt = _pFirst; _pIt < _pLast; ++_pIt)
+					::new (static_cast<void*>(_pBuffer + (_pIt - begin))) T(*_pIt);
+			};
+			parallel_run(policy, _workers, _sortPart);
+
+			T* _pSrc = begin;
+			T* _pDst = _pBuffer;
+			size_t _runs = _workers;
+
+			while (_runs > 1) {
+				const size_t _pairs = _runs / 2;
+				const size_t _pieces = squads::max<size_t>(1, _workers / _pairs);
+				const size_t _tasks = _pairs * _pieces + (_runs & 1);
+
+				auto _merge = [&](size_t t) {
+					if (t >= _pairs * _pieces) {
+						// The odd last run is copied
+						for (size_t i = _aBounds[_runs - 1]; i < n; i++) _pDst[i] = _pSrc[i];
+						return;
+					}
+					const size_t _pair = t / _pieces;
+					const size_t _piece = t % _pieces;
+
+					const T* _pA = _pSrc + _aBounds[2 * _pair];
+					const size_t _na = _aBounds[2 * _pair + 1] - _aBounds[2 * _pair];
+					const T* _pB = _pSrc + _aBounds[2 * _pair + 1];
+					const size_t _nb = _aBounds[2 * _pair + 2] - _aBounds[2 * _pair + 1];
+
+					const size_t _lo = parallel_bound(_na + _nb, _piece, _pieces);
+					const size_t _hi = parallel_bound(_na + _nb, _piece + 1, _pieces);
+					const size_t _ia = merge_corank(_lo, _pA, _na, _pB, _nb, pred);
+					const size_t _ib = merge_corank(_hi, _pA, _na, _pB, _nb, pred);
+
+					merge_to(_pA + _ia, _pA + _ib, _pB + (_lo - _ia), _pB + (_hi - _ib),
+							 _pDst + _aBounds[2 * _pair] + _lo, pred);
+				};
+				parallel_run(policy, _tasks, _merge);
+
+				for (size_t k = 0; k < (_runs + 1) / 2; k++) _aBounds[k] = _aBounds[2 * k];
+				_runs = (_runs + 1) / 2;
+				_aBounds[_runs] = n;
+				squads::swap(_pSrc, _pDst);
+			}
+
+			// Copy back, when the last round has merged into the buffer, and destroy the buffer
+			auto _finish = [&](size_t p) {
+				const size_t _first = parallel_bound(n, p, _workers);
+				const size_t _last = parallel_bound(n, p + 1, _workers);
+				for (size_t i = _first; i < _last; i++) {
+					if (_pSrc != begin) begin[i] = _pBuffer[i];
+					squads::destruct(_pBuffer + i);
+				}
+			};
+			parallel_run(policy, _workers, _finish);
+
+			allocator.deallocate(_pBuffer, n, sizeof(T), alignof(T));
+			return true;
+		}
+	} // internal
+
+	/**
+	 * @brief Call fn(element) for all elements, the parts of the range on more workers.
+	 */
+	template <typename T, class TFn>
+	void parallel_foreach(const parallel_policy& policy, T* begin, T* end, TFn fn) {
+		const size_t n = (size_t)(end - begin);
+		internal::parallel_for(policy, n, internal::parallel_workers(policy, n),
+			[&](size_t first, size_t last) { squads::foreach(begin + first, begin + last, fn); });
+	}
+
+	/**
+	 * @brief Set all elements to value, the parts of the range on more workers.
+	 */
+	template <typename T>
+	void parallel_fill(const parallel_policy& policy, T* begin, T* end, const T& value) {
+		const size_t n = (size_t)(end - begin);
+		internal::parallel_for(policy, n, internal::parallel_workers(policy, n),
+			[&](size_t first, size_t last) { squads::fill(begin + first, begin + last, value); });
+	}
+
+	/**
+	 * @brief Set out[i] = fn(in[i]) for all elements, the parts of the range on more workers.
+	 */
+	template <typename T, typename U, class TFn>
+	void parallel_transform(const parallel_policy& policy, const T* begin, const T* end, U* out, TFn fn) {
+		const size_t n = (size_t)(end - begin);
+		internal::parallel_for(policy, n, internal::parallel_workers(policy, n),
+			[&](size_t first, size_t last) {
+				for (size_t i = first; i < last; i++) out[i] = fn(begin[i]);
+			});
+	}
+
+	/**
+	 * @brief Combine init and all elements with op, each worker reduce a part.
+	 * @note op must be associative, the parts are combined in order.
+	 */
+	template <typename T, typename TValue, class TOp>
+	TValue parallel_reduce(const parallel_policy& policy, const T* begin, const T* end, TValue init, TOp op) {
+		const size_t n = (size_t)(end - begin);
+		const size_t _parts = internal::parallel_workers(policy, n);
+
+		if (_parts < 2) {
+			for (const T* _pIt = begin; _pIt < end; ++_pIt) init = op(init, *_pIt);
+			return init;
+		}
+
+		alignas(TValue) unsigned char _aStorage[internal::ParallelMaxWorkers][sizeof(TValue)];
+		TValue* _pPartials = reinterpret_cast<TValue*>(_aStorage);
+
+		auto _reducePart = [&](size_t p) {
+			const size_t _first = internal::parallel_bound(n, p, _parts);
+			const size_t _last = internal::parallel_bound(n, p + 1, _parts);
+
+			TValue _value = TValue(begin[_first]);
+			for (size_t i = _first + 1; i < _last; i++) _value = op(_value, begin[i]);
+			::new (static_cast<void*>(_pPartials + p)) TValue(_value);
+		};
+		internal::parallel_run(policy, _parts, _reducePart);
+
+		for (size_t p = 0; p < _parts; p++) {
+			init = op(init, _pPartials[p]);
+			squads::destruct(_pPartials + p);
+		}
+		return init;
+	}
+
+	/**
+	 * @brief Sort the range on more workers, with a parallel merge of the sorted parts.
+	 * @return False when the merge buffer could not be allocated, the range is sorted serial then.
+	 */
+	template <typename T, class TPredicate, class TAllocator>
+	bool parallel_sort(const parallel_policy& policy, T* begin, T* end, TPredicate pred, TAllocator& allocator) {
+		return internal::parallel_merge_sort(policy, begin, end, pred, allocator, false);
+	}
+	template <typename T, class TPredicate>
+	bool parallel_sort(const parallel_policy& policy, T* begin, T* end, TPredicate pred) {
+		squads::default_allocator<> _allocator;
+		return parallel_sort(policy, begin, end, pred, _allocator);
+	}
+	template <typename T>
+	bool parallel_sort(const parallel_policy& policy, T* begin, T* end) {
+		return parallel_sort(policy, begin, end, squads::less<T>());
+	}
+
+	/**
+	 * @brief Stable sort the range on more workers, the order of equal elements is kept.
+	 * @note The allocator is copied for each worker and must be thread-safe.
+	 * @return False when the merge buffer could not be allocated, the range is sorted serial then.
+	 */
+	template <typename T, class TPredicate, class TAllocator>
+	bool parallel_stable_sort(const parallel_policy& policy, T* begin, T* end, TPredicate pred, TAllocator& allocator) {
+		return internal::parallel_merge_sort(policy, begin, end, pred, allocator, true);
+	}
+	template <typename T, class TPredicate>
+	bool parallel_stable_sort(const parallel_policy& policy, T* begin, T* end, TPredicate pred) {
+		squads::default_allocator<> _allocator;
+		return parallel_stable_sort(policy, begin, end, pred, _allocator);
+	}
+	template <typename T>
+	bool parallel_stable_sort(const parallel_policy& policy, T* begin, T* end) {
+		return parallel_stable_sort(policy, begin, end, squads::less<T>());
+	}
+}
+
+#endif // __SQUADS_PARALLEL_H__
@@ -0,0 +1,170 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_RADIX_SORT_H__
+#define __SQUADS_RADIX_SORT_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "allocator.hpp"
+#include "functional.hpp"
+#include "sort.hpp"
+#include "type_traits.hpp"
+
+#include <stdint.h>
+#include <string.h>
+
+namespace squads {
+	namespace internal {
+		/// The number of buckets of a 8 bit digit
+		static constexpr size_t RadixBuckets = 256;
+
+		template <size_t NSize> struct radix_uint;
+		template <> struct radix_uint<1> { using type = uint8_t; };
+		template <> struct radix_uint<2> { using type = uint16_t; };
+		template <> struct radix_uint<4> { using type = uint32_t; };
+		template <> struct radix_uint<8> { using type = uint64_t; };
+
+		/**
+		 * @brief Map a key to unsigned bits with the same order.
+		 * The sign bit of signed integers is flipped, negative floats are inverted and
+		 * positive floats get the sign bit set.
+		 */
+		template <typename TKey, bool = squads::is_floating_point<TKey>::value>
+		struct radix_key {
+			static_assert(squads::is_integral<TKey>::value, "radix_sort: the key must be a integer or a float");
+			using bits_type = typename radix_uint<sizeof(TKey)>::type;
+
+			static constexpr bits_type SignBit = (TKey(-1) < TKey(0)) ? bits_type(bits_type(1) << (sizeof(TKey) * 8 - 1)) : 0;
+
+			static bits_type to_bits(TKey key) { return bits_type(key) ^ SignBit; }
+		};
+
+		template <typename TKey>
+		struct radix_key<TKey, true> {
+			using bits_type = typename radix_uint<sizeof(TKey)>::type;
+
+			static constexpr bits_type SignBit = bits_type(bits_type(1) << (sizeof(TKey) * 8 - 1));
+
+			static bits_type to_bits(TKey key) {
+				bits_type _bits;
+				memcpy(&_bits, &key, sizeof(_bits));
+				return (_bits & SignBit) ? bits_type(~_bits) : bits_type(_bits | SignBit);
+			}
+		};
+
+		/// The key extractor of radix_sort(begin, end), the element is the key
+		template <typename T>
+		struct radix_identity {
+			const T& operator()(const T& value) const { return value; }
+		};
+	}
+
+	/**
+	 * @brief Sort the range by the keys with a LSD radix sort in O(n * sizeof(key)).
+	 *
+	 * The keys are integers or floats, one 8 bit digit is sorted per pass. The histograms
+	 * of all passes are build in one read over the range, a pass is skipped, when all
+	 * keys have the same digit there. So small keys in wide types cost less passes.
+	 * The sort is stable.
+	 *
+	 * @param key key(element) returns the key of the element.
+	 * @param allocator The allocator for the scratch buffer of n elements and the histograms.
+	 * @return False when the scratch memory could not be allocated,
+	 * the range is then sorted with squads::sort by the key (not stable).
+	 */
+	template <typename T, class TKeyFn, class TAllocator>
+	bool radix_sort(T* begin, T* end, TKeyFn key, TAllocator& allocator) {
+		static_assert(squads::is_trivially_copyable<T>::value, "radix_sort: T must be trivially copyable");
+
+		using key_type = squads::type_t<squads::remove_cvref<decltype(key(*begin))>>;
+		using traits = internal::radix_key<key_type>;
+		using bits_type = typename traits::bits_type;
+
+		constexpr size_t Passes = sizeof(bits_type);
+		const size_t n = (size_t)(end - begin);
+		if (n < 2) return true;
+
+		T* _pScratch = static_cast<T*>(allocator.allocate(n, sizeof(T), alignof(T)));
+		size_t* _pCounts = static_cast<size_t*>(allocator.allocate(Passes * internal::RadixBuckets, sizeof(size_t), alignof(size_t)));
+
+		if (_pScratch == nullptr || _pCounts == nullptr) {
+			if (_pScratch != nullptr) allocator.deallocate(_pScratch, n, sizeof(T), alignof(T));
+			if (_pCounts != nullptr) allocator.deallocate(_pCounts, Passes * internal::RadixBuckets, sizeof(size_t), alignof(size_t));
+
+			squads::sort(begin, end, [&key](const T& a, const T& b) {
+				return traits::to_bits(key(a)) < traits::to_bits(key(b)); });
+			return false;
+		}
+		memset(_pCounts, 0, Passes * internal::RadixBuckets * sizeof(size_t));
+
+		for (size_t i = 0; i < n; i++) {
+			bits_type _bits = traits::to_bits(key(begin[i]));
+			for (size_t p = 0; p < Passes; p++)
+				_pCounts[p * internal::RadixBuckets + ((_bits >> (p * 8)) & 0xff)]++;
+		}
+
+		T* _pSrc = begin;
+		T* _pDst = _pScratch;
+		const bits_type _first = traits::to_bits(key(begin[0]));
+
+		for (size_t p = 0; p < Passes; p++) {
+			size_t* _pOffsets = _pCounts + p * internal::RadixBuckets;
+			const size_t _shift = p * 8;
+
+			// All keys have the same digit, the pass would not change the order
+			if (_pOffsets[(_first >> _shift) & 0xff] == n) continue;
+
+			size_t _sum = 0;
+			for (size_t b = 0; b < internal::RadixBuckets; b++) {
+				size_t _count = _pOffsets[b];
+				_pOffsets[b] = _sum;
+				_sum += _count;
+			}
+			for (size_t i = 0; i < n; i++) {
+				size_t _digit = (traits::to_bits(key(_pSrc[i])) >> _shift) & 0xff;
+				memcpy(static_cast<void*>(_pDst + _pOffsets[_digit]++), static_cast<const void*>(_pSrc + i), sizeof(T));
+			}
+			squads::swap(_pSrc, _pDst);
+		}
+		if (_pSrc != begin) memcpy(static_cast<void*>(begin), static_cast<const void*>(_pSrc), n * sizeof(T));
+
+		allocator.deallocate(_pCounts, Passes * internal::RadixBuckets, sizeof(size_t), alignof(size_t));
+		allocator.deallocate(_pScratch, n, sizeof(T), alignof(T));
+		return true;
+	}
+
+	/**
+	 * @brief Sort the range by the keys, the scratch memory is from squads::default_allocator.
+	 */
+	template <typename T, class TKeyFn>
+	bool radix_sort(T* begin, T* end, TKeyFn key) {
+		squads::default_allocator<> _allocator;
+		return radix_sort(begin, end, key, _allocator);
+	}
+
+	/**
+	 * @brief Sort a range of integers or floats in ascending order.
+	 */
+	template <typename T>
+	bool radix_sort(T* begin, T* end) {
+		return radix_sort(begin, end, internal::radix_identity<T>());
+	}
+}
+
+#endif // __SQUADS_RADIX_SORT_H__
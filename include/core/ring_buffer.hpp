@@ -0,0 +1,300 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_RING_BUFFER_H__
+#define __SQUADS_RING_BUFFER_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "span.hpp"
+#include "type_traits.hpp"
+#include "atomic/atomic.hpp"
+
+namespace squads {
+	/**
+	 * @brief A contiguous region inside a ring buffer.
+	 */
+	template <typename T>
+	struct basic_ring_region {
+		T* 				data;
+		squads::size_t 	size;
+
+		bool empty() const { return size == 0; }
+	};
+
+	/**
+	 * @brief The up to two contiguous regions of a ring buffer,
+	 * the second region is used when the area wraps around the end.
+	 */
+	template <typename T>
+	struct basic_ring_spans {
+		basic_ring_region<T> first;
+		basic_ring_region<T> second;
+
+		/**
+		 * @brief Get the number of elements in both regions.
+		 */
+		squads::size_t size() const { return first.size + second.size; }
+		bool empty() const 			{ return size() == 0; }
+	};
+
+	/**
+	 * @brief A fixed size ring buffer, safe for one producer and one consumer.
+	 *
+	 * The read and write indices run free and are masked on access, so N must be a power of two
+	 * and all N elements can be used. The producer owns the write index, the consumer the read index,
+	 * each side publish his index with release and read the other with acquire.
+	 *
+	 * Beside push and pop, write_spans() and read_spans() give direct access to the free
+	 * and the used area as up to two contiguous regions. Fill the regions (memcpy, DMA) and
+	 * publish the data with commit(n), or consume the data and free it with consume(n).
+	 *
+	 * @tparam T The element type, must be trivially copyable.
+	 * @tparam N The number of elements, a power of two.
+	 *
+	 * @note Producer functions: push, write, write_spans, commit, free_space.
+	 * Consumer functions: pop, read, read_spans, consume, front, clear.
+	 */
+	template <typename T, size_t N>
+	class basic_ring_buffer {
+		static_assert(N >= 2 && (N & (N - 1)) == 0, "basic_ring_buffer: N must be a power of two");
+		static_assert(squads::is_trivially_copyable<T>::value, "basic_ring_buffer: T must be trivially copyable");
+	public:
+		using value_type = T;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using size_type = squads::size_t;
+		using self_type = basic_ring_buffer<T, N>;
+		using region_type = basic_ring_region<T>;
+		using const_region_type = basic_ring_region<const T>;
+		using spans_type = basic_ring_spans<T>;
+		using const_spans_type = basic_ring_spans<const T>;
+		using index_type = atomic::_atomic<size_type>;
+
+		static constexpr size_type Capacity = N;
+		static constexpr size_type Mask = N - 1;
+
+		basic_ring_buffer() noexcept
+			: m_atomicWrite(0), m_atomicRead(0) { }
+
+		basic_ring_buffer(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		constexpr size_type capacity() const { return Capacity; }
+
+		/**
+		 * @brief Get the number of elements in the buffer.
+		 */
+		size_type size() const {
+			return m_atomicWrite.load(atomic::memory_order::Acquire) -
+				   m_atomicRead.load(atomic::memory_order::Acquire);
+		}
+		size_type free_space() const 	{ return Capacity - size(); }
+		bool empty() const 				{ return size() == 0; }
+		bool full() const 				{ return size() == Capacity; }
+
+		/**
+		 * @brief Add one element.
+		 * @return False when the buffer is full.
+		 */
+		bool push(const_reference value) {
+			size_type _write = m_atomicWrite.load(atomic::memory_order::Relaxed);
+			size_type _read = m_atomicRead.load(atomic::memory_order::Acquire);
+			if(_write - _read == Capacity) return false;
+
+			m_aBuffer[_write & Mask] = value;
+			m_atomicWrite.store(_write + 1, atomic::memory_order::Release);
+			return true;
+		}
+
+		/**
+		 * @brief Remove the oldest element.
+		 * @param value The removed element is copied to this.
+		 * @return False when the buffer is empty.
+		 */
+		bool pop(reference value) {
+			size_type _read = m_atomicRead.load(atomic::memory_order::Relaxed);
+			size_type _write = m_atomicWrite.load(atomic::memory_order::Acquire);
+			if(_write == _read) return false;
+
+			value = m_aBuffer[_read & Mask];
+			m_atomicRead.store(_read + 1, atomic::memory_order::Release);
+			return true;
+		}
+
+		/**
+		 * @brief Get a pointer to the oldest element, without remove it.
+		 * @return The pointer or nullptr when the buffer is empty.
+		 */
+		const_pointer front() const {
+			size_type _read = m_atomicRead.load(atomic::memory_order::Relaxed);
+			size_type _write = m_atomicWrite.load(atomic::memory_order::Acquire);
+			return (_write == _read) ? nullptr : &m_aBuffer[_read & Mask];
+		}
+
+		/**
+		 * @brief Copy up to count elements into the buffer.
+		 * @return The number of copied elements.
+		 */
+		size_type write(const_pointer data, size_type count) {
+			spans_type _spans = write_spans();
+			size_type _first = squads::min(count, _spans.first.size);
+			size_type _second = squads::min(count - _first, _spans.second.size);
+
+			memcpy(_spans.first.data, data, _first * sizeof(value_type));
+			memcpy(_spans.second.data, data + _first, _second * sizeof(value_type));
+
+			commit(_first + _second);
+			return _first + _second;
+		}
+
+		/**
+		 * @brief Copy up to count elements out of the buffer and remove them.
+		 * @return The number of copied elements.
+		 */
+		size_type read(pointer data, size_type count) {
+			const_spans_type _spans = read_spans();
+			size_type _first = squads::min(count, _spans.first.size);
+			size_type _second = squads::min(count - _first, _spans.second.size);
+
+			memcpy(data, _spans.first.data, _first * sizeof(value_type));
+			memcpy(data + _first, _spans.second.data, _second * sizeof(value_type));
+
+			consume(_first + _second);
+			return _first + _second;
+		}
+
+		/**
+		 * @brief Copy up to data.size() elements into the buffer.
+		 * @return The number of copied elements.
+		 */
+		size_type write(basic_span<const value_type> data) { return write(data.data(), data.size()); }
+
+		/**
+		 * @brief Copy up to data.size() elements out of the buffer and remove them.
+		 * @return The number of copied elements.
+		 */
+		size_type read(basic_span<value_type> data) { return read(data.data(), data.size()); }
+
+		/**
+		 * @brief Get the free area of the buffer, for the producer.
+		 * The data written to the regions is published with commit().
+		 */
+		spans_type write_spans() {
+			size_type _write = m_atomicWrite.load(atomic::memory_order::Relaxed);
+			size_type _read = m_atomicRead.load(atomic::memory_order::Acquire);
+			return make_spans<T>(m_aBuffer, _write & Mask, Capacity - (_write - _read));
+		}
+
+		/**
+		 * @brief Publish count elements, written to the regions of write_spans().
+		 */
+		void commit(size_type count) {
+			size_type _write = m_atomicWrite.load(atomic::memory_order::Relaxed);
+			assert(count <= Capacity - (_write - m_atomicRead.load(atomic::memory_order::Acquire)));
+
+			m_atomicWrite.store(_write + count, atomic::memory_order::Release);
+		}
+
+		/**
+		 * @brief Get the used area of the buffer, for the consumer.
+		 * The read data is freed with consume().
+		 */
+		const_spans_type read_spans() const {
+			size_type _read = m_atomicRead.load(atomic::memory_order::Relaxed);
+			size_type _write = m_atomicWrite.load(atomic::memory_order::Acquire);
+			return make_spans<const T>(m_aBuffer, _read & Mask, _write - _read);
+		}
+
+		/**
+		 * @brief Free count elements, read from the regions of read_spans().
+		 */
+		void consume(size_type count) {
+			size_type _read = m_atomicRead.load(atomic::memory_order::Relaxed);
+			assert(count <= m_atomicWrite.load(atomic::memory_order::Acquire) - _read);
+
+			m_atomicRead.store(_read + count, atomic::memory_order::Release);
+		}
+
+		/**
+		 * @brief Remove all elements, for the consumer.
+		 */
+		void clear() {
+			m_atomicRead.store(m_atomicWrite.load(atomic::memory_order::Acquire), atomic::memory_order::Release);
+		}
+	private:
+		template <typename U>
+		static basic_ring_spans<U> make_spans(U* buffer, size_type start, size_type count) {
+			basic_ring_spans<U> _spans;
+			size_type _first = squads::min(count, Capacity - start);
+
+			_spans.first.data = buffer + start;
+			_spans.first.size = _first;
+			_spans.second.data = buffer;
+			_spans.second.size = count - _first;
+			return _spans;
+		}
+	private:
+		/// The write index, owned by the producer
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) index_type m_atomicWrite;
+		/// The read index, owned by the consumer
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) index_type m_atomicRead;
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) value_type m_aBuffer[N];
+	};
+
+	/**
+	 * @brief A byte ring buffer for driver I/O, with untyped read and write.
+	 */
+	template <size_t N>
+	class basic_byte_ring : public basic_ring_buffer<uint8_t, N> {
+		using base_type = basic_ring_buffer<uint8_t, N>;
+	public:
+		using self_type = basic_byte_ring<N>;
+		using size_type = typename base_type::size_type;
+
+		using base_type::write;
+		using base_type::read;
+
+		/**
+		 * @brief Copy up to size bytes into the buffer.
+		 * @return The number of copied bytes.
+		 */
+		size_type write(const void* data, size_type size) {
+			return base_type::write(static_cast<const uint8_t*>(data), size);
+		}
+
+		/**
+		 * @brief Copy up to size bytes out of the buffer and remove them.
+		 * @return The number of copied bytes.
+		 */
+		size_type read(void* data, size_type size) {
+			return base_type::read(static_cast<uint8_t*>(data), size);
+		}
+	};
+
+	template <typename T, size_t N>
+	using ring_buffer = basic_ring_buffer<T, N>;
+
+	template <size_t N>
+	using byte_ring = basic_byte_ring<N>;
+}
+
+#endif // __SQUADS_RING_BUFFER_H__
@@ -0,0 +1,328 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_SEGMENTED_DEQUE_H__
+#define __SQUADS_SEGMENTED_DEQUE_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "iterator.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief The default number of elements in a chunk, about 512 bytes and at least 4 elements.
+		 */
+		template <typename T>
+		struct deque_chunk_size {
+			enum { value = (sizeof(T) < 128) ? (512 / sizeof(T)) : 4 };
+		};
+	}
+
+	/**
+	 * @brief Random access iterator of the basic_segmented_deque.
+	 * @note The iterators are invalid after a push, references to the elements not.
+	 */
+	template <typename T, typename TChunk, size_t NChunkSize>
+	class basic_segmented_deque_iterator {
+		template <typename U, typename UChunk, size_t M> friend class basic_segmented_deque_iterator;
+	public:
+		using iterator_category = squads::random_access_iterator_tag;
+		using value_type = T;
+		using pointer = value_type*;
+		using reference = value_type&;
+		using difference_type = squads::ptrdiff_t;
+		using size_type = squads::size_t;
+		using self_type = basic_segmented_deque_iterator<T, TChunk, NChunkSize>;
+
+		basic_segmented_deque_iterator() : m_ppMap(nullptr), m_sIndex(0) { }
+		basic_segmented_deque_iterator(TChunk* const* map, size_type index) : m_ppMap(map), m_sIndex(index) { }
+
+		template <typename U>
+		basic_segmented_deque_iterator(const basic_segmented_deque_iterator<U, TChunk, NChunkSize>& other)
+			: m_ppMap(other.m_ppMap), m_sIndex(other.m_sIndex) { }
+
+		reference operator*() const 	{ return m_ppMap[m_sIndex / NChunkSize][m_sIndex % NChunkSize]; }
+		pointer operator->() const 		{ return &(**this); }
+		reference operator[] (difference_type n) const { return *(*this + n); }
+
+		self_type& operator++() 	{ ++m_sIndex; return *this; }
+		self_type& operator--() 	{ --m_sIndex; return *this; }
+		self_type operator++(int) 	{ self_type _copy(*this); ++m_sIndex; return _copy; }
+		self_type operator--(int) 	{ self_type _copy(*this); --m_sIndex; return _copy; }
+
+		self_type& operator += (difference_type n) 	{ m_sIndex += n; return *this; }
+		self_type& operator -= (difference_type n) 	{ m_sIndex -= n; return *this; }
+		self_type operator + (difference_type n) const { return self_type(m_ppMap, m_sIndex + n); }
+		self_type operator - (difference_type n) const { return self_type(m_ppMap, m_sIndex - n); }
+
+		template <typename U>
+		difference_type operator - (const basic_segmented_deque_iterator<U, TChunk, NChunkSize>& rhs) const {
+			return difference_type(m_sIndex) - difference_type(rhs.m_sIndex);
+		}
+		template <typename U>
+		bool operator == (const basic_segmented_deque_iterator<U, TChunk, NChunkSize>& rhs) const { return m_sIndex == rhs.m_sIndex; }
+		template <typename U>
+		bool operator != (const basic_segmented_deque_iterator<U, TChunk, NChunkSize>& rhs) const { return m_sIndex != rhs.m_sIndex; }
+		template <typename U>
+		bool operator < (const basic_segmented_deque_iterator<U, TChunk, NChunkSize>& rhs) const { return m_sIndex < rhs.m_sIndex; }
+	private:
+		TChunk* const* 	m_ppMap;
+		size_type 		m_sIndex;
+	};
+
+	/**
+	 * @brief A double ended queue, that stores the elements in fixed size chunks.
+	 *
+	 * A small map holds the pointers to the chunks. Push and pop at both ends are amortized O(1),
+	 * on growth only the chunk pointers are moved, never the elements, so references to
+	 * the elements stay valid. Empty chunks are given back, one is kept as spare, so a
+	 * sliding window (push_back and pop_front) don't allocate in the steady state.
+	 *
+	 * @tparam T The element type.
+	 * @tparam NChunkSize The number of elements in a chunk.
+	 * @tparam TAllocator The allocator for the chunks and the map.
+	 *
+	 * @note Is not thread-safe.
+	 */
+	template <typename T, size_t NChunkSize = internal::deque_chunk_size<T>::value,
+			  class TAllocator = squads::default_allocator<> >
+	class basic_segmented_deque {
+		static_assert(NChunkSize > 0, "basic_segmented_deque: the chunk size must be greater 0");
+	public:
+		using value_type = T;
+		using pointer = value_type*;
+		using const_pointer = const value_type*;
+		using reference = value_type&;
+		using const_reference = const value_type&;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using allocator_type = TAllocator;
+		using chunk_type = value_type;
+		using iterator = basic_segmented_deque_iterator<T, chunk_type, NChunkSize>;
+		using const_iterator = basic_segmented_deque_iterator<const T, chunk_type, NChunkSize>;
+		using reverse_iterator = squads::reverse_iterator<iterator>;
+		using const_reverse_iterator = squads::reverse_iterator<const_iterator>;
+		using self_type = basic_segmented_deque<T, NChunkSize, TAllocator>;
+
+		static constexpr size_type ChunkSize = NChunkSize;
+		static constexpr size_type MinMapSize = 8;
+
+		basic_segmented_deque()
+			: m_ppMap(nullptr), m_sMapSize(0), m_sStart(0), m_sSize(0), m_pSpare(nullptr), m_aAllocator() { }
+
+		basic_segmented_deque(const self_type& other) : basic_segmented_deque() {
+			for(const_iterator it = other.begin(); it != other.end(); ++it)
+				if(!push_back(*it)) break;
+		}
+
+		basic_segmented_deque(self_type&& other) : basic_segmented_deque() { swap(other); }
+
+		~basic_segmented_deque() {
+			clear();
+			if(m_pSpare != nullptr) deallocate_chunk(m_pSpare);
+			if(m_ppMap != nullptr) m_aAllocator.deallocate(m_ppMap, m_sMapSize, sizeof(chunk_type*), alignof(chunk_type*));
+		}
+
+		self_type& operator = (const self_type& other) {
+			if(this != &other) { self_type _copy(other); swap(_copy); }
+			return *this;
+		}
+		self_type& operator = (self_type&& other) { swap(other); return *this; }
+
+		iterator begin() 				{ return iterator(m_ppMap, m_sStart); }
+		const_iterator begin() const 	{ return const_iterator(m_ppMap, m_sStart); }
+		iterator end() 					{ return iterator(m_ppMap, m_sStart + m_sSize); }
+		const_iterator end() const 		{ return const_iterator(m_ppMap, m_sStart + m_sSize); }
+
+		reverse_iterator rbegin() 				{ return reverse_iterator(end()); }
+		const_reverse_iterator rbegin() const 	{ return const_reverse_iterator(end()); }
+		reverse_iterator rend() 				{ return reverse_iterator(begin()); }
+		const_reverse_iterator rend() const 	{ return const_reverse_iterator(begin()); }
+
+		size_type size() const 	{ return m_sSize; }
+		bool empty() const 		{ return m_sSize == 0; }
+
+		reference operator[] (size_type i) 				{ assert(i < m_sSize); return *slot(m_sStart + i); }
+		const_reference operator[] (size_type i) const 	{ assert(i < m_sSize); return *slot(m_sStart + i); }
+
+		reference front() 				{ assert(!empty()); return *slot(m_sStart); }
+		const_reference front() const 	{ assert(!empty()); return *slot(m_sStart); }
+		reference back() 				{ assert(!empty()); return *slot(m_sStart + m_sSize - 1); }
+		const_reference back() const 	{ assert(!empty()); return *slot(m_sStart + m_sSize - 1); }
+
+		/**
+		 * @brief Append a element.
+		 * @return False on allocation failure.
+		 */
+		bool push_back(const value_type& value) {
+			if((m_sStart + m_sSize) / ChunkSize >= m_sMapSize && !reserve_map(false)) return false;
+
+			size_type _index = m_sStart + m_sSize;
+			if(!ensure_chunk(_index / ChunkSize)) return false;
+
+			::new (static_cast<void*>(slot(_index))) value_type(value);
+			++m_sSize;
+			return true;
+		}
+
+		/**
+		 * @brief Prepend a element.
+		 * @return False on allocation failure.
+		 */
+		bool push_front(const value_type& value) {
+			if(m_sStart == 0 && !reserve_map(true)) return false;
+
+			size_type _index = m_sStart - 1;
+			if(!ensure_chunk(_index / ChunkSize)) return false;
+
+			::new (static_cast<void*>(slot(_index))) value_type(value);
+			--m_sStart;
+			++m_sSize;
+			return true;
+		}
+
+		/**
+		 * @brief Remove the last element.
+		 */
+		void pop_back() {
+			assert(!empty());
+			size_type _index = m_sStart + m_sSize - 1;
+
+			squads::destruct(slot(_index));
+			if(_index % ChunkSize == 0 || m_sSize == 1) release_chunk(_index / ChunkSize);
+			if(--m_sSize == 0) recenter_empty();
+		}
+
+		/**
+		 * @brief Remove the first element.
+		 */
+		void pop_front() {
+			assert(!empty());
+			size_type _index = m_sStart;
+
+			squads::destruct(slot(_index));
+			if((_index + 1) % ChunkSize == 0 || m_sSize == 1) release_chunk(_index / ChunkSize);
+			++m_sStart;
+			if(--m_sSize == 0) recenter_empty();
+		}
+
+		/**
+		 * @brief Remove all elements, the chunks are given back.
+		 */
+		void clear() {
+			while(!empty()) pop_back();
+		}
+
+		void swap(self_type& other) {
+			squads::swap(m_ppMap, other.m_ppMap);
+			squads::swap(m_sMapSize, other.m_sMapSize);
+			squads::swap(m_sStart, other.m_sStart);
+			squads::swap(m_sSize, other.m_sSize);
+			squads::swap(m_pSpare, other.m_pSpare);
+		}
+	private:
+		pointer slot(size_type index) const {
+			return m_ppMap[index / ChunkSize] + (index % ChunkSize);
+		}
+
+		chunk_type* allocate_chunk() {
+			if(m_pSpare != nullptr) {
+				chunk_type* _pChunk = m_pSpare;
+				m_pSpare = nullptr;
+				return _pChunk;
+			}
+			return static_cast<chunk_type*>(m_aAllocator.allocate(ChunkSize, sizeof(value_type), alignof(value_type)));
+		}
+
+		void deallocate_chunk(chunk_type* chunk) {
+			m_aAllocator.deallocate(chunk, ChunkSize, sizeof(value_type), alignof(value_type));
+		}
+
+		bool ensure_chunk(size_type index) {
+			if(m_ppMap[index] == nullptr) m_ppMap[index] = allocate_chunk();
+			return m_ppMap[index] != nullptr;
+		}
+
+		void release_chunk(size_type index) {
+			if(m_pSpare == nullptr) m_pSpare = m_ppMap[index];
+			else deallocate_chunk(m_ppMap[index]);
+			m_ppMap[index] = nullptr;
+		}
+
+		void recenter_empty() {
+			m_sStart = (m_sMapSize / 2) * ChunkSize;
+		}
+
+		/**
+		 * @brief Make room for one more chunk at the front or the back of the map.
+		 * The used chunk pointers are centered, the map is only reallocated when more
+		 * than the half is used.
+		 */
+		bool reserve_map(bool atFront) {
+			size_type _first = m_sStart / ChunkSize;
+			size_type _used = (m_sSize == 0) ? 0 : (m_sStart + m_sSize - 1) / ChunkSize - _first + 1;
+			size_type _newSize = m_sMapSize;
+
+			if(_newSize < MinMapSize || 2 * (_used + 1) > _newSize)
+				_newSize = squads::max<size_type>(MinMapSize, 2 * m_sMapSize);
+
+			size_type _newFirst = (_newSize - _used) / 2;
+			if(atFront && _newFirst == 0) _newFirst = 1;
+
+			if(_newSize == m_sMapSize) {
+				memmove(m_ppMap + _newFirst, m_ppMap + _first, _used * sizeof(chunk_type*));
+			} else {
+				chunk_type** _ppMap = static_cast<chunk_type**>(
+					m_aAllocator.allocate(_newSize, sizeof(chunk_type*), alignof(chunk_type*)));
+				if(_ppMap == nullptr) return false;
+
+				if(m_ppMap != nullptr) {
+					memcpy(_ppMap + _newFirst, m_ppMap + _first, _used * sizeof(chunk_type*));
+					m_aAllocator.deallocate(m_ppMap, m_sMapSize, sizeof(chunk_type*), alignof(chunk_type*));
+				}
+				m_ppMap = _ppMap;
+				m_sMapSize = _newSize;
+			}
+
+			for(size_type i = 0; i < m_sMapSize; i++) {
+				if(i < _newFirst || i >= _newFirst + _used) m_ppMap[i] = nullptr;
+			}
+
+			m_sStart = _newFirst * ChunkSize + ((m_sSize == 0) ? ChunkSize / 2 : m_sStart % ChunkSize);
+			return true;
+		}
+	private:
+		chunk_type** 	m_ppMap;
+		size_type 		m_sMapSize;
+		/// The map wide index of the first element
+		size_type 		m_sStart;
+		size_type 		m_sSize;
+		chunk_type* 	m_pSpare;
+		allocator_type 	m_aAllocator;
+	};
+
+	template <typename T, size_t NChunkSize = internal::deque_chunk_size<T>::value,
+			  class TAllocator = squads::default_allocator<> >
+	using segmented_deque = basic_segmented_deque<T, NChunkSize, TAllocator>;
+}
+
+#endif // __SQUADS_SEGMENTED_DEQUE_H__
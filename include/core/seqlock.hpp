@@ -0,0 +1,126 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_SEQLOCK_H__
+#define __SQUADS_SEQLOCK_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+#include "atomic/atomic.hpp"
+
+namespace squads {
+	/**
+	 * @brief A sequence lock: a version counter that is odd while a writer is active.
+	 *
+	 * Readers never block, they take the version with read_begin(), read the data and
+	 * check with read_retry() that no write overlapped. Writers must be serialized by the caller.
+	 *
+	 * @code
+	 * unsigned int _seq;
+	 * do {
+	 *     _seq = lock.read_begin();
+	 *     copy = data;
+	 * } while(lock.read_retry(_seq));
+	 * @endcode
+	 *
+	 * @note A reader in a ISR must not loop, when it has interrupted the writer.
+	 * Use a single pass and check is_write_pending(seq).
+	 */
+	template <typename T = unsigned int>
+	class basic_seqlock {
+	public:
+		using value_type = T;
+		using self_type = basic_seqlock<T>;
+		using atomic_type = atomic::_atomic<value_type>;
+
+		/**
+		 * @brief RAII helper for a write section.
+		 */
+		class write_guard {
+		public:
+			explicit write_guard(self_type& lock) : m_refLock(lock) { m_refLock.write_begin(); }
+			~write_guard() { m_refLock.write_end(); }
+
+			write_guard(const write_guard&) = delete;
+			write_guard& operator = (const write_guard&) = delete;
+		private:
+			self_type& m_refLock;
+		};
+
+		basic_seqlock() noexcept : m_atomicSeq(0) { }
+
+		/**
+		 * @brief Start a read section.
+		 * @return The version to pass to read_retry().
+		 */
+		value_type read_begin() const noexcept {
+			return m_atomicSeq.load(atomic::memory_order::Acquire);
+		}
+
+		/**
+		 * @brief Is a writer active for the given version?
+		 */
+		static bool is_write_pending(value_type seq) noexcept {
+			return (seq & 1) != 0;
+		}
+
+		/**
+		 * @brief End a read section.
+		 * @param seq The version from read_begin().
+		 * @return True when a write was active or has overlapped and the read must be repeated.
+		 */
+		bool read_retry(value_type seq) const noexcept {
+			atomic::atomic_thread_fence(atomic::memory_order::Acquire);
+			return is_write_pending(seq) || m_atomicSeq.load(atomic::memory_order::Relaxed) != seq;
+		}
+
+		/**
+		 * @brief Start a write section, the version becomes odd.
+		 */
+		void write_begin() noexcept {
+			value_type _seq = m_atomicSeq.load(atomic::memory_order::Relaxed);
+			assert(!is_write_pending(_seq));
+
+			m_atomicSeq.store(_seq + 1, atomic::memory_order::Relaxed);
+			atomic::atomic_thread_fence(atomic::memory_order::Release);
+		}
+
+		/**
+		 * @brief End a write section, the version becomes even again.
+		 */
+		void write_end() noexcept {
+			value_type _seq = m_atomicSeq.load(atomic::memory_order::Relaxed);
+			m_atomicSeq.store(_seq + 1, atomic::memory_order::Release);
+		}
+
+		/**
+		 * @brief Get the current version.
+		 */
+		value_type get_sequence() const noexcept {
+			return m_atomicSeq.load(atomic::memory_order::Relaxed);
+		}
+
+		basic_seqlock(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+	private:
+		atomic_type m_atomicSeq;
+	};
+
+	using seqlock = basic_seqlock<unsigned int>;
+}
+
+#endif // __SQUADS_SEQLOCK_H__
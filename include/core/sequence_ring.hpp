@@ -0,0 +1,335 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_SEQUENCE_RING_H__
+#define __SQUADS_SEQUENCE_RING_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "ring_buffer.hpp"
+#include "atomic/atomic.hpp"
+#include "arch/arch_utils.hpp"
+#include "arch/arch_thread.hpp"
+
+namespace squads {
+	/**
+	 * @brief Wait strategy: spin on the sequence, the lowest latency and the highest cpu load.
+	 */
+	struct sequence_wait_spin {
+		template <class TReady>
+		void wait(TReady ready) { while(!ready()) { } }
+		void notify() { }
+	};
+
+	/**
+	 * @brief Wait strategy: spin a few times, then yield the cpu to other tasks between the checks.
+	 */
+	struct sequence_wait_yield {
+		static constexpr unsigned int SpinCount = 64;
+
+		template <class TReady>
+		void wait(TReady ready) {
+			for(unsigned int i = 0; i < SpinCount; i++) {
+				if(ready()) return;
+			}
+			while(!ready()) arch::arch_yield();
+		}
+		void notify() { }
+	};
+
+	/**
+	 * @brief Wait strategy: spin and yield for a short time, then block on a signal until notify().
+	 * The lowest cpu load, the waiting task is woken by the other side of the ring.
+	 *
+	 * Each waiting side of the ring has a own strategy object, so only one task waits on the signal.
+	 * When the signal can not be created, the wait sleeps a tick between the checks.
+	 */
+	struct sequence_wait_block {
+		static constexpr unsigned int SpinCount = 64;
+		static constexpr unsigned int YieldCount = 16;
+
+		sequence_wait_block() : m_pSignal(arch::arch_signal_create()), m_atomicWaiting(false) { }
+		~sequence_wait_block() { arch::arch_signal_destroy(m_pSignal); }
+
+		sequence_wait_block(const sequence_wait_block&) = delete;
+		sequence_wait_block& operator = (const sequence_wait_block&) = delete;
+
+		template <class TReady>
+		void wait(TReady ready) {
+			for(unsigned int i = 0; i < SpinCount; i++) {
+				if(ready()) return;
+			}
+			for(unsigned int i = 0; i < YieldCount; i++) {
+				if(ready()) return;
+				arch::arch_yield();
+			}
+			while(true) {
+				m_atomicWaiting.store(true, atomic::memory_order::Relaxed);
+				// The flag is set before the check, the pair of notify()
+				atomic::atomic_thread_fence(atomic::memory_order::SeqCst);
+				if(ready()) break;
+
+				if(m_pSignal == nullptr) arch::arch_delay(1);
+				else arch::arch_signal_take(m_pSignal);
+			}
+			m_atomicWaiting.store(false, atomic::memory_order::Relaxed);
+		}
+
+		/**
+		 * @brief Wake the waiting task, called after the state of the ring is changed.
+		 * A give without waiter is only a extra check in the next wait.
+		 */
+		void notify() {
+			// The change of the ring is visible before the flag is read, the pair of wait()
+			atomic::atomic_thread_fence(atomic::memory_order::SeqCst);
+			if(!m_atomicWaiting.load(atomic::memory_order::Relaxed)) return;
+
+			if(m_atomicWaiting.exchange(false, atomic::memory_order::Relaxed) && m_pSignal != nullptr)
+				arch::arch_signal_give(m_pSignal);
+		}
+	private:
+		arch::thread_signal_t* m_pSignal;
+		atomic::_atomic<bool> m_atomicWaiting;
+	};
+
+	/**
+	 * @brief A ring for one producer and more consumers, each consumer sees every event (disruptor).
+	 *
+	 * The producer claims a batch of slots, writes the events in place and publishes them.
+	 * Each consumer has a own cursor and reads the published events in place, so a event is
+	 * written once and read by all consumers without copies. A slot is reused, when the
+	 * slowest consumer has consumed it.
+	 *
+	 * Sequences run free and are masked on access, so N must be a power of two.
+	 *
+	 * @tparam T The type of the events.
+	 * @tparam N The number of slots, a power of two.
+	 * @tparam NConsumers The number of consumers, each one is identified by his index.
+	 * @tparam TWait The wait strategy of claim() and wait_for(), see sequence_wait_spin,
+	 * sequence_wait_yield and sequence_wait_block. Each consumer and the producer have a own
+	 * one: publish() notifies the consumers and the consumed events notify the producer.
+	 *
+	 * @code
+	 * squads::sequence_ring<event, 256, 2> ring;
+	 * // producer
+	 * auto _spans = ring.claim(1);
+	 * _spans.first.data[0] = ev;
+	 * ring.publish(1);
+	 * // consumer 1
+	 * ring.poll(1, [](const event& ev, size_t seq) { ... });
+	 * @endcode
+	 */
+	template <typename T, size_t N, size_t NConsumers, class TWait = sequence_wait_yield>
+	class basic_sequence_ring {
+		static_assert(N >= 2 && (N & (N - 1)) == 0, "basic_sequence_ring: N must be a power of two");
+		static_assert(NConsumers >= 1, "basic_sequence_ring: need at least one consumer");
+	public:
+		using value_type = T;
+		using size_type = squads::size_t;
+		using sequence_type = squads::size_t;
+		using spans_type = basic_ring_spans<T>;
+		using const_spans_type = basic_ring_spans<const T>;
+		using wait_type = TWait;
+		using self_type = basic_sequence_ring<T, N, NConsumers, TWait>;
+
+		static constexpr size_type Capacity = N;
+		static constexpr size_type Mask = N - 1;
+		static constexpr size_type ConsumerCount = NConsumers;
+	private:
+		/// The index of the wait strategy of the producer, behind the ones of the consumers
+		static constexpr size_type ProducerWait = NConsumers;
+
+		struct alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) cursor {
+			atomic::_atomic<sequence_type> Seq;
+			cursor() : Seq(0) { }
+		};
+	public:
+		basic_sequence_ring() : m_sClaimed(0), m_sGating(0), m_atomicPublished(0), m_aWait() { }
+
+		basic_sequence_ring(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		constexpr size_type capacity() const { return Capacity; }
+
+		/**
+		 * @brief Get the sequence of the next event to publish.
+		 */
+		sequence_type get_cursor() const { return m_atomicPublished.load(atomic::memory_order::Acquire); }
+
+		/**
+		 * @brief Get the sequence of the next event for a consumer.
+		 */
+		sequence_type get_consumer_cursor(size_type consumer) const {
+			assert(consumer < ConsumerCount);
+			return m_aConsumers[consumer].Seq.load(atomic::memory_order::Acquire);
+		}
+
+		// Producer side
+
+		/**
+		 * @brief Claim up to count slots, without waiting.
+		 * @return The claimed slots, size() can be less then count or 0 when the ring is full.
+		 */
+		spans_type try_claim(size_type count) {
+			size_type _free = free_slots();
+			if(_free < count) {
+				update_gating();
+				_free = free_slots();
+			}
+			return claim_slots(squads::min(count, _free));
+		}
+
+		/**
+		 * @brief Claim count slots, wait with the wait strategy until the slowest consumer make room.
+		 * @return The claimed slots, the events are written there before publish().
+		 */
+		spans_type claim(size_type count) {
+			assert(count <= Capacity);
+			if(free_slots() < count) {
+				m_aWait[ProducerWait].wait([this, count]() { update_gating(); return free_slots() >= count; });
+			}
+			return claim_slots(count);
+		}
+
+		/**
+		 * @brief Publish the next count claimed events to all consumers.
+		 */
+		void publish(size_type count) {
+			sequence_type _published = m_atomicPublished.load(atomic::memory_order::Relaxed);
+			assert(count <= m_sClaimed - _published);
+
+			m_atomicPublished.store(_published + count, atomic::memory_order::Release);
+			for(size_type i = 0; i < ConsumerCount; i++) m_aWait[i].notify();
+		}
+
+		/**
+		 * @brief Claim, write a copy of value and publish a single event.
+		 * @return False when the ring is full.
+		 */
+		bool try_publish(const value_type& value) {
+			spans_type _spans = try_claim(1);
+			if(_spans.empty()) return false;
+
+			_spans.first.data[0] = value;
+			publish(1);
+			return true;
+		}
+
+		// Consumer side
+
+		/**
+		 * @brief Get the number of published events, that the consumer has not consumed.
+		 */
+		size_type available(size_type consumer) const {
+			return get_cursor() - get_consumer_cursor(consumer);
+		}
+
+		/**
+		 * @brief Get all events, that the consumer can read, without waiting.
+		 */
+		const_spans_type read_spans(size_type consumer) const {
+			sequence_type _seq = m_aConsumers[consumer].Seq.load(atomic::memory_order::Relaxed);
+			return make_spans<const T>(m_aBuffer, _seq, get_cursor() - _seq);
+		}
+
+		/**
+		 * @brief Wait with the wait strategy until count events are available.
+		 * @return All events, that the consumer can read.
+		 */
+		const_spans_type wait_for(size_type consumer, size_type count = 1) {
+			if(available(consumer) < count) {
+				m_aWait[consumer].wait([this, consumer, count]() { return available(consumer) >= count; });
+			}
+			return read_spans(consumer);
+		}
+
+		/**
+		 * @brief Mark the next count events as read by the consumer.
+		 */
+		void consume(size_type consumer, size_type count) {
+			assert(count <= available(consumer));
+			sequence_type _seq = m_aConsumers[consumer].Seq.load(atomic::memory_order::Relaxed);
+			m_aConsumers[consumer].Seq.store(_seq + count, atomic::memory_order::Release);
+			m_aWait[ProducerWait].notify();
+		}
+
+		/**
+		 * @brief Call fn(event, sequence) for all available events and consume them as one batch.
+		 * @return The number of handled events.
+		 */
+		template <class TFn>
+		size_type poll(size_type consumer, TFn fn) {
+			sequence_type _seq = m_aConsumers[consumer].Seq.load(atomic::memory_order::Relaxed);
+			sequence_type _end = get_cursor();
+
+			for(sequence_type i = _seq; i != _end; i++) fn(static_cast<const T&>(m_aBuffer[i & Mask]), i);
+			if(_end != _seq) {
+				m_aConsumers[consumer].Seq.store(_end, atomic::memory_order::Release);
+				m_aWait[ProducerWait].notify();
+			}
+			return _end - _seq;
+		}
+	private:
+		/// The number of free slots, after the cached position of the slowest consumer.
+		size_type free_slots() const { return Capacity - (m_sClaimed - m_sGating); }
+
+		/// Load the position of the slowest consumer.
+		void update_gating() {
+			sequence_type _min = m_aConsumers[0].Seq.load(atomic::memory_order::Acquire);
+			for(size_type i = 1; i < ConsumerCount; i++) {
+				sequence_type _seq = m_aConsumers[i].Seq.load(atomic::memory_order::Acquire);
+				if(sequence_type(m_sClaimed - _seq) > sequence_type(m_sClaimed - _min)) _min = _seq;
+			}
+			m_sGating = _min;
+		}
+
+		spans_type claim_slots(size_type count) {
+			spans_type _spans = make_spans<T>(m_aBuffer, m_sClaimed, count);
+			m_sClaimed += count;
+			return _spans;
+		}
+
+		template <typename U>
+		static basic_ring_spans<U> make_spans(U* buffer, sequence_type start, size_type count) {
+			basic_ring_spans<U> _spans;
+			size_type _index = size_type(start) & Mask;
+			size_type _first = squads::min(count, Capacity - _index);
+
+			_spans.first.data = buffer + _index;
+			_spans.first.size = _first;
+			_spans.second.data = buffer;
+			_spans.second.size = count - _first;
+			return _spans;
+		}
+	private:
+		/// The next sequence to claim and the cached slowest consumer, owned by the producer
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) sequence_type m_sClaimed;
+		sequence_type m_sGating;
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) atomic::_atomic<sequence_type> m_atomicPublished;
+		cursor m_aConsumers[NConsumers];
+		/// The wait strategies of the consumers and the producer at ProducerWait
+		wait_type m_aWait[NConsumers + 1];
+		value_type m_aBuffer[N];
+	};
+
+	template <typename T, size_t N, size_t NConsumers, class TWait = sequence_wait_yield>
+	using sequence_ring = basic_sequence_ring<T, N, NConsumers, TWait>;
+}
+
+#endif // __SQUADS_SEQUENCE_RING_H__
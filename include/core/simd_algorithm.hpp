@@ -0,0 +1,719 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_SIMD_ALGORITHM_H__
+#define __SQUADS_SIMD_ALGORITHM_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "compressed_pair.hpp"
+#include "functional.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+
+#if SQUADS_CONFIG_HAS_AVX2 == SQUADS_CONFIG_YES || SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+	#include <immintrin.h>
+#elif SQUADS_CONFIG_HAS_SSE2 == SQUADS_CONFIG_YES
+	#include <emmintrin.h>
+#elif SQUADS_CONFIG_HAS_NEON == SQUADS_CONFIG_YES
+	#include <arm_neon.h>
+#endif
+
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+	/// A AVX2 function in a build without -mavx2
+	#define SQUADS_SIMD_AVX2_FN 		__attribute__((target("avx2"))) inline
+	/// A AVX2 kernel in a build without -mavx2, all called functions are inlined into it
+	#define SQUADS_SIMD_AVX2_KERNEL 	__attribute__((target("avx2"), flatten)) inline
+#else
+	#define SQUADS_SIMD_AVX2_FN 		inline
+#endif
+
+namespace squads {
+	namespace internal {
+		/// The kind of a element for the simd kernels
+		enum simd_kind {
+			simd_kind_none = 0,
+			simd_kind_sint,
+			simd_kind_uint,
+			simd_kind_real
+		};
+
+		template <typename T>
+		struct simd_kind_of {
+			static constexpr int value = is_floating_point<T>::value ? simd_kind_real
+				: (!is_integral<T>::value || is_same<T, bool>::value) ? simd_kind_none
+				: is_signed<T>::value ? simd_kind_sint
+				: is_unsigned<T>::value ? simd_kind_uint : simd_kind_none;
+		};
+
+		/**
+		 * @brief The operations of a simd instruction set for the element type T.
+		 *
+		 * A specialization provides reg_type, mask_type, Lanes, MaskBits (the bits per element
+		 * in a compare mask), FullMask and load, store, set1, eq, min, max and add. The registers
+		 * are passed by reference, so the AVX2 ops can be called from the runtime dispatched kernels.
+		 * This one has no operations, the algorithms use the scalar loops.
+		 */
+		struct simd_scalar {
+			static constexpr bool Enabled = false;
+			static constexpr bool HasEqual = false;
+			static constexpr bool HasMinMax = false;
+			static constexpr bool HasAdd = false;
+		};
+
+#if SQUADS_CONFIG_HAS_SSE2 == SQUADS_CONFIG_YES
+		/// The integer lanes of SSE2 by element size
+		template <size_t NSize> struct simd_sse2_lane;
+
+		template <> struct simd_sse2_lane<1> {
+			static __m128i set1(int64_t v) 				{ return _mm_set1_epi8(static_cast<char>(v)); }
+			static __m128i eq(__m128i a, __m128i b) 	{ return _mm_cmpeq_epi8(a, b); }
+			static __m128i gt(__m128i a, __m128i b) 	{ return _mm_cmpgt_epi8(a, b); }
+			static __m128i add(__m128i a, __m128i b) 	{ return _mm_add_epi8(a, b); }
+			static __m128i bias() 						{ return _mm_set1_epi8(static_cast<char>(0x80)); }
+		};
+		template <> struct simd_sse2_lane<2> {
+			static __m128i set1(int64_t v) 				{ return _mm_set1_epi16(static_cast<short>(v)); }
+			static __m128i eq(__m128i a, __m128i b) 	{ return _mm_cmpeq_epi16(a, b); }
+			static __m128i gt(__m128i a, __m128i b) 	{ return _mm_cmpgt_epi16(a, b); }
+			static __m128i add(__m128i a, __m128i b) 	{ return _mm_add_epi16(a, b); }
+			static __m128i bias() 						{ return _mm_set1_epi16(static_cast<short>(0x8000)); }
+		};
+		template <> struct simd_sse2_lane<4> {
+			static __m128i set1(int64_t v) 				{ return _mm_set1_epi32(static_cast<int>(v)); }
+			static __m128i eq(__m128i a, __m128i b) 	{ return _mm_cmpeq_epi32(a, b); }
+			static __m128i gt(__m128i a, __m128i b) 	{ return _mm_cmpgt_epi32(a, b); }
+			static __m128i add(__m128i a, __m128i b) 	{ return _mm_add_epi32(a, b); }
+			static __m128i bias() 						{ return _mm_set1_epi32(static_cast<int>(0x80000000u)); }
+		};
+		/// SSE2 has no 64 bit compare, eq is build from the 32 bit halves and there is no gt
+		template <> struct simd_sse2_lane<8> {
+			static __m128i set1(int64_t v) 				{ return _mm_set1_epi64x(static_cast<long long>(v)); }
+			static __m128i eq(__m128i a, __m128i b) {
+				__m128i _half = _mm_cmpeq_epi32(a, b);
+				return _mm_and_si128(_half, _mm_shuffle_epi32(_half, _MM_SHUFFLE(2, 3, 0, 1)));
+			}
+			static __m128i add(__m128i a, __m128i b) 	{ return _mm_add_epi64(a, b); }
+		};
+
+		template <typename T, int NKind = simd_kind_of<T>::value>
+		struct simd_sse2 : simd_scalar { };
+
+		/// SSE2 ops for the signed and unsigned integers
+		template <typename T, int NKind>
+		struct simd_sse2_int {
+			using lane_type = simd_sse2_lane<sizeof(T)>;
+			using reg_type = __m128i;
+			using mask_type = uint32_t;
+
+			static constexpr bool Enabled = true;
+			static constexpr bool HasEqual = true;
+			static constexpr bool HasMinMax = sizeof(T) < 8;
+			static constexpr bool HasAdd = true;
+			static constexpr size_t Lanes = 16 / sizeof(T);
+			static constexpr size_t MaskBits = sizeof(T);
+			static constexpr mask_type FullMask = 0xFFFFu;
+
+			static void load(reg_type& r, const T* p) 	{ r = _mm_loadu_si128(reinterpret_cast<const __m128i*>(p)); }
+			static void store(T* p, const reg_type& r) 	{ _mm_storeu_si128(reinterpret_cast<__m128i*>(p), r); }
+			static void set1(reg_type& r, const T& v) 	{ r = lane_type::set1(static_cast<int64_t>(v)); }
+			static void add(reg_type& a, const reg_type& b) { a = lane_type::add(a, b); }
+
+			static mask_type eq(const reg_type& a, const reg_type& b) {
+				return static_cast<mask_type>(_mm_movemask_epi8(lane_type::eq(a, b)));
+			}
+			/// a = min(a, b), a blend on a signed gt, the unsigned values are biased to signed
+			static void min(reg_type& a, const reg_type& b) {
+				__m128i _gt = greater(a, b);
+				a = _mm_or_si128(_mm_and_si128(_gt, b), _mm_andnot_si128(_gt, a));
+			}
+			static void max(reg_type& a, const reg_type& b) {
+				__m128i _gt = greater(a, b);
+				a = _mm_or_si128(_mm_and_si128(_gt, a), _mm_andnot_si128(_gt, b));
+			}
+		private:
+			static __m128i greater(const reg_type& a, const reg_type& b) {
+				if (NKind == simd_kind_sint) return lane_type::gt(a, b);
+				return lane_type::gt(_mm_xor_si128(a, lane_type::bias()), _mm_xor_si128(b, lane_type::bias()));
+			}
+		};
+		template <typename T>
+		struct simd_sse2<T, simd_kind_sint> : simd_sse2_int<T, simd_kind_sint> { };
+		template <typename T>
+		struct simd_sse2<T, simd_kind_uint> : simd_sse2_int<T, simd_kind_uint> { };
+
+		template <>
+		struct simd_sse2<float, simd_kind_real> {
+			using reg_type = __m128;
+			using mask_type = uint32_t;
+
+			static constexpr bool Enabled = true;
+			static constexpr bool HasEqual = true;
+			static constexpr bool HasMinMax = true;
+			static constexpr bool HasAdd = true;
+			static constexpr size_t Lanes = 4;
+			static constexpr size_t MaskBits = 4;
+			static constexpr mask_type FullMask = 0xFFFFu;
+
+			static void load(reg_type& r, const float* p) 		{ r = _mm_loadu_ps(p); }
+			static void store(float* p, const reg_type& r) 		{ _mm_storeu_ps(p, r); }
+			static void set1(reg_type& r, const float& v) 		{ r = _mm_set1_ps(v); }
+			static void add(reg_type& a, const reg_type& b) 	{ a = _mm_add_ps(a, b); }
+			static void min(reg_type& a, const reg_type& b) 	{ a = _mm_min_ps(a, b); }
+			static void max(reg_type& a, const reg_type& b) 	{ a = _mm_max_ps(a, b); }
+			static mask_type eq(const reg_type& a, const reg_type& b) {
+				return static_cast<mask_type>(_mm_movemask_epi8(_mm_castps_si128(_mm_cmpeq_ps(a, b))));
+			}
+		};
+
+		template <>
+		struct simd_sse2<double, simd_kind_real> {
+			using reg_type = __m128d;
+			using mask_type = uint32_t;
+
+			static constexpr bool Enabled = true;
+			static constexpr bool HasEqual = true;
+			static constexpr bool HasMinMax = true;
+			static constexpr bool HasAdd = true;
+			static constexpr size_t Lanes = 2;
+			static constexpr size_t MaskBits = 8;
+			static constexpr mask_type FullMask = 0xFFFFu;
+
+			static void load(reg_type& r, const double* p) 		{ r = _mm_loadu_pd(p); }
+			static void store(double* p, const reg_type& r) 	{ _mm_storeu_pd(p, r); }
+			static void set1(reg_type& r, const double& v) 		{ r = _mm_set1_pd(v); }
+			static void add(reg_type& a, const reg_type& b) 	{ a = _mm_add_pd(a, b); }
+			static void min(reg_type& a, const reg_type& b) 	{ a = _mm_min_pd(a, b); }
+			static void max(reg_type& a, const reg_type& b) 	{ a = _mm_max_pd(a, b); }
+			static mask_type eq(const reg_type& a, const reg_type& b) {
+				return static_cast<mask_type>(_mm_movemask_epi8(_mm_castpd_si128(_mm_cmpeq_pd(a, b))));
+			}
+		};
+#endif // SQUADS_CONFIG_HAS_SSE2
+
+#if SQUADS_CONFIG_HAS_AVX2 == SQUADS_CONFIG_YES || SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		/// The integer lanes of AVX2 by element size and kind
+		template <size_t NSize, int NKind> struct simd_avx2_lane;
+
+		template <> struct simd_avx2_lane<1, simd_kind_sint> {
+			SQUADS_SIMD_AVX2_FN static __m256i min(__m256i a, __m256i b) 	{ return _mm256_min_epi8(a, b); }
+			SQUADS_SIMD_AVX2_FN static __m256i max(__m256i a, __m256i b) 	{ return _mm256_max_epi8(a, b); }
+		};
+		template <> struct simd_avx2_lane<1, simd_kind_uint> {
+			SQUADS_SIMD_AVX2_FN static __m256i min(__m256i a, __m256i b) 	{ return _mm256_min_epu8(a, b); }
+			SQUADS_SIMD_AVX2_FN static __m256i max(__m256i a, __m256i b) 	{ return _mm256_max_epu8(a, b); }
+		};
+		template <> struct simd_avx2_lane<2, simd_kind_sint> {
+			SQUADS_SIMD_AVX2_FN static __m256i min(__m256i a, __m256i b) 	{ return _mm256_min_epi16(a, b); }
+			SQUADS_SIMD_AVX2_FN static __m256i max(__m256i a, __m256i b) 	{ return _mm256_max_epi16(a, b); }
+		};
+		template <> struct simd_avx2_lane<2, simd_kind_uint> {
+			SQUADS_SIMD_AVX2_FN static __m256i min(__m256i a, __m256i b) 	{ return _mm256_min_epu16(a, b); }
+			SQUADS_SIMD_AVX2_FN static __m256i max(__m256i a, __m256i b) 	{ return _mm256_max_epu16(a, b); }
+		};
+		template <> struct simd_avx2_lane<4, simd_kind_sint> {
+			SQUADS_SIMD_AVX2_FN static __m256i min(__m256i a, __m256i b) 	{ return _mm256_min_epi32(a, b); }
+			SQUADS_SIMD_AVX2_FN static __m256i max(__m256i a, __m256i b) 	{ return _mm256_max_epi32(a, b); }
+		};
+		template <> struct simd_avx2_lane<4, simd_kind_uint> {
+			SQUADS_SIMD_AVX2_FN static __m256i min(__m256i a, __m256i b) 	{ return _mm256_min_epu32(a, b); }
+			SQUADS_SIMD_AVX2_FN static __m256i max(__m256i a, __m256i b) 	{ return _mm256_max_epu32(a, b); }
+		};
+		/// AVX2 has only a signed 64 bit gt, the unsigned values are biased to signed
+		template <int NKind> struct simd_avx2_lane<8, NKind> {
+			SQUADS_SIMD_AVX2_FN static __m256i min(__m256i a, __m256i b) 	{ return _mm256_blendv_epi8(a, b, greater(a, b)); }
+			SQUADS_SIMD_AVX2_FN static __m256i max(__m256i a, __m256i b) 	{ return _mm256_blendv_epi8(b, a, greater(a, b)); }
+		private:
+			SQUADS_SIMD_AVX2_FN static __m256i greater(__m256i a, __m256i b) {
+				if (NKind == simd_kind_sint) return _mm256_cmpgt_epi64(a, b);
+				const __m256i _bias = _mm256_set1_epi64x(static_cast<long long>(0x8000000000000000ull));
+				return _mm256_cmpgt_epi64(_mm256_xor_si256(a, _bias), _mm256_xor_si256(b, _bias));
+			}
+		};
+
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_set1(int64_t v, int_to_type<1>) 	{ return _mm256_set1_epi8(static_cast<char>(v)); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_set1(int64_t v, int_to_type<2>) 	{ return _mm256_set1_epi16(static_cast<short>(v)); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_set1(int64_t v, int_to_type<4>) 	{ return _mm256_set1_epi32(static_cast<int>(v)); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_set1(int64_t v, int_to_type<8>) 	{ return _mm256_set1_epi64x(static_cast<long long>(v)); }
+
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_eq(__m256i a, __m256i b, int_to_type<1>) 	{ return _mm256_cmpeq_epi8(a, b); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_eq(__m256i a, __m256i b, int_to_type<2>) 	{ return _mm256_cmpeq_epi16(a, b); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_eq(__m256i a, __m256i b, int_to_type<4>) 	{ return _mm256_cmpeq_epi32(a, b); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_eq(__m256i a, __m256i b, int_to_type<8>) 	{ return _mm256_cmpeq_epi64(a, b); }
+
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_add(__m256i a, __m256i b, int_to_type<1>) 	{ return _mm256_add_epi8(a, b); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_add(__m256i a, __m256i b, int_to_type<2>) 	{ return _mm256_add_epi16(a, b); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_add(__m256i a, __m256i b, int_to_type<4>) 	{ return _mm256_add_epi32(a, b); }
+		SQUADS_SIMD_AVX2_FN __m256i simd_avx2_add(__m256i a, __m256i b, int_to_type<8>) 	{ return _mm256_add_epi64(a, b); }
+
+		template <typename T, int NKind = simd_kind_of<T>::value>
+		struct simd_avx2 : simd_scalar { };
+
+		/// AVX2 ops for the signed and unsigned integers
+		template <typename T, int NKind>
+		struct simd_avx2_int {
+			using lane_type = simd_avx2_lane<sizeof(T), NKind>;
+			using size_tag = int_to_type<sizeof(T)>;
+			using reg_type = __m256i;
+			using mask_type = uint32_t;
+
+			static constexpr bool Enabled = true;
+			static constexpr bool HasEqual = true;
+			static constexpr bool HasMinMax = true;
+			static constexpr bool HasAdd = true;
+			static constexpr size_t Lanes = 32 / sizeof(T);
+			static constexpr size_t MaskBits = sizeof(T);
+			static constexpr mask_type FullMask = 0xFFFFFFFFu;
+
+			SQUADS_SIMD_AVX2_FN static void load(reg_type& r, const T* p) 	{ r = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(p)); }
+			SQUADS_SIMD_AVX2_FN static void store(T* p, const reg_type& r) 	{ _mm256_storeu_si256(reinterpret_cast<__m256i*>(p), r); }
+			SQUADS_SIMD_AVX2_FN static void set1(reg_type& r, const T& v) 	{ r = simd_avx2_set1(static_cast<int64_t>(v), size_tag()); }
+			SQUADS_SIMD_AVX2_FN static void add(reg_type& a, const reg_type& b) { a = simd_avx2_add(a, b, size_tag()); }
+			SQUADS_SIMD_AVX2_FN static void min(reg_type& a, const reg_type& b) { a = lane_type::min(a, b); }
+			SQUADS_SIMD_AVX2_FN static void max(reg_type& a, const reg_type& b) { a = lane_type::max(a, b); }
+			SQUADS_SIMD_AVX2_FN static mask_type eq(const reg_type& a, const reg_type& b) {
+				return static_cast<mask_type>(_mm256_movemask_epi8(simd_avx2_eq(a, b, size_tag())));
+			}
+		};
+		template <typename T>
+		struct simd_avx2<T, simd_kind_sint> : simd_avx2_int<T, simd_kind_sint> { };
+		template <typename T>
+		struct simd_avx2<T, simd_kind_uint> : simd_avx2_int<T, simd_kind_uint> { };
+
+		template <>
+		struct simd_avx2<float, simd_kind_real> {
+			using reg_type = __m256;
+			using mask_type = uint32_t;
+
+			static constexpr bool Enabled = true;
+			static constexpr bool HasEqual = true;
+			static constexpr bool HasMinMax = true;
+			static constexpr bool HasAdd = true;
+			static constexpr size_t Lanes = 8;
+			static constexpr size_t MaskBits = 4;
+			static constexpr mask_type FullMask = 0xFFFFFFFFu;
+
+			SQUADS_SIMD_AVX2_FN static void load(reg_type& r, const float* p) 		{ r = _mm256_loadu_ps(p); }
+			SQUADS_SIMD_AVX2_FN static void store(float* p, const reg_type& r) 		{ _mm256_storeu_ps(p, r); }
+			SQUADS_SIMD_AVX2_FN static void set1(reg_type& r, const float& v) 		{ r = _mm256_set1_ps(v); }
+			SQUADS_SIMD_AVX2_FN static void add(reg_type& a, const reg_type& b) 	{ a = _mm256_add_ps(a, b); }
+			SQUADS_SIMD_AVX2_FN static void min(reg_type& a, const reg_type& b) 	{ a = _mm256_min_ps(a, b); }
+			SQUADS_SIMD_AVX2_FN static void max(reg_type& a, const reg_type& b) 	{ a = _mm256_max_ps(a, b); }
+			SQUADS_SIMD_AVX2_FN static mask_type eq(const reg_type& a, const reg_type& b) {
+				return static_cast<mask_type>(_mm256_movemask_epi8(_mm256_castps_si256(_mm256_cmp_ps(a, b, _CMP_EQ_OQ))));
+			}
+		};
+
+		template <>
+		struct simd_avx2<double, simd_kind_real> {
+			using reg_type = __m256d;
+			using mask_type = uint32_t;
+
+			static constexpr bool Enabled = true;
+			static constexpr bool HasEqual = true;
+			static constexpr bool HasMinMax = true;
+			static constexpr bool HasAdd = true;
+			static constexpr size_t Lanes = 4;
+			static constexpr size_t MaskBits = 8;
+			static constexpr mask_type FullMask = 0xFFFFFFFFu;
+
+			SQUADS_SIMD_AVX2_FN static void load(reg_type& r, const double* p) 		{ r = _mm256_loadu_pd(p); }
+			SQUADS_SIMD_AVX2_FN static void store(double* p, const reg_type& r) 	{ _mm256_storeu_pd(p, r); }
+			SQUADS_SIMD_AVX2_FN static void set1(reg_type& r, const double& v) 		{ r = _mm256_set1_pd(v); }
+			SQUADS_SIMD_AVX2_FN static void add(reg_type& a, const reg_type& b) 	{ a = _mm256_add_pd(a, b); }
+			SQUADS_SIMD_AVX2_FN static void min(reg_type& a, const reg_type& b) 	{ a = _mm256_min_pd(a, b); }
+			SQUADS_SIMD_AVX2_FN static void max(reg_type& a, const reg_type& b) 	{ a = _mm256_max_pd(a, b); }
+			SQUADS_SIMD_AVX2_FN static mask_type eq(const reg_type& a, const reg_type& b) {
+				return static_cast<mask_type>(_mm256_movemask_epi8(_mm256_castpd_si256(_mm256_cmp_pd(a, b, _CMP_EQ_OQ))));
+			}
+		};
+#endif // SQUADS_CONFIG_HAS_AVX2 || SQUADS_CONFIG_SIMD_DISPATCH
+
+#if SQUADS_CONFIG_HAS_NEON == SQUADS_CONFIG_YES
+		template <typename T>
+		struct simd_neon : simd_scalar { };
+
+		/// The compare result of NEON is narrowed to four bits per byte, see hash_group
+		inline uint64_t simd_neon_mask(uint8x16_t cmp) {
+			uint8x8_t _nibbles = vshrn_n_u16(vreinterpretq_u16_u8(cmp), 4);
+			return vget_lane_u64(vreinterpret_u64_u8(_nibbles), 0);
+		}
+		inline uint8x16_t simd_neon_bytes(uint8x16_t cmp) 	{ return cmp; }
+		inline uint8x16_t simd_neon_bytes(uint16x8_t cmp) 	{ return vreinterpretq_u8_u16(cmp); }
+		inline uint8x16_t simd_neon_bytes(uint32x4_t cmp) 	{ return vreinterpretq_u8_u32(cmp); }
+
+		/// NEON ops for the 8, 16 and 32 bit integers and float, the 64 bit types use the scalar loops
+		#define SQUADS_SIMD_NEON_OPS(T, TReg, Suffix) \
+			template <> \
+			struct simd_neon<T> { \
+				using reg_type = TReg; \
+				using mask_type = uint64_t; \
+				static constexpr bool Enabled = true; \
+				static constexpr bool HasEqual = true; \
+				static constexpr bool HasMinMax = true; \
+				static constexpr bool HasAdd = true; \
+				static constexpr size_t Lanes = 16 / sizeof(T); \
+				static constexpr size_t MaskBits = 4 * sizeof(T); \
+				static constexpr mask_type FullMask = ~0ull; \
+				static void load(reg_type& r, const T* p) 		{ r = vld1q_##Suffix(p); } \
+				static void store(T* p, const reg_type& r) 		{ vst1q_##Suffix(p, r); } \
+				static void set1(reg_type& r, const T& v) 		{ r = vdupq_n_##Suffix(v); } \
+				static void add(reg_type& a, const reg_type& b) { a = vaddq_##Suffix(a, b); } \
+				static void min(reg_type& a, const reg_type& b) { a = vminq_##Suffix(a, b); } \
+				static void max(reg_type& a, const reg_type& b) { a = vmaxq_##Suffix(a, b); } \
+				static mask_type eq(const reg_type& a, const reg_type& b) { \
+					return simd_neon_mask(simd_neon_bytes(vceqq_##Suffix(a, b))); \
+				} \
+			};
+
+		SQUADS_SIMD_NEON_OPS(int8_t, int8x16_t, s8)
+		SQUADS_SIMD_NEON_OPS(uint8_t, uint8x16_t, u8)
+		SQUADS_SIMD_NEON_OPS(int16_t, int16x8_t, s16)
+		SQUADS_SIMD_NEON_OPS(uint16_t, uint16x8_t, u16)
+		SQUADS_SIMD_NEON_OPS(int32_t, int32x4_t, s32)
+		SQUADS_SIMD_NEON_OPS(uint32_t, uint32x4_t, u32)
+		SQUADS_SIMD_NEON_OPS(float, float32x4_t, f32)
+
+		#undef SQUADS_SIMD_NEON_OPS
+#endif // SQUADS_CONFIG_HAS_NEON
+
+		/// The ops of the instruction set, that is selected at compile time
+#if SQUADS_CONFIG_HAS_AVX2 == SQUADS_CONFIG_YES
+		template <typename T> using simd_native = simd_avx2<T>;
+#elif SQUADS_CONFIG_HAS_SSE2 == SQUADS_CONFIG_YES
+		template <typename T> using simd_native = simd_sse2<T>;
+#elif SQUADS_CONFIG_HAS_NEON == SQUADS_CONFIG_YES
+		template <typename T> using simd_native = simd_neon<T>;
+#else
+		template <typename T> using simd_native = simd_scalar;
+#endif
+
+		// The kernels, the int_to_type<false> overloads are the scalar loops
+
+		template <class V, typename T>
+		inline const T* simd_find(const T* first, const T* last, const T& val, int_to_type<false>) {
+			return squads::find(first, last, val);
+		}
+		template <class V, typename T>
+		inline const T* simd_find(const T* first, const T* last, const T& val, int_to_type<true>) {
+			typename V::reg_type _vVal, _vData;
+			V::set1(_vVal, val);
+
+			for (; size_t(last - first) >= V::Lanes; first += V::Lanes) {
+				V::load(_vData, first);
+				typename V::mask_type _mask = V::eq(_vData, _vVal);
+				if (_mask != 0) return first + squads::ctz(_mask) / V::MaskBits;
+			}
+			return squads::find(first, last, val);
+		}
+
+		template <class V, typename T>
+		inline size_t simd_count(const T* first, const T* last, const T& val, int_to_type<false>) {
+			size_t _count = 0;
+			for (; first != last; ++first) if (*first == val) ++_count;
+			return _count;
+		}
+		template <class V, typename T>
+		inline size_t simd_count(const T* first, const T* last, const T& val, int_to_type<true>) {
+			typename V::reg_type _vVal, _vData;
+			size_t _bits = 0;
+			V::set1(_vVal, val);
+
+			for (; size_t(last - first) >= V::Lanes; first += V::Lanes) {
+				V::load(_vData, first);
+				_bits += squads::popcount(V::eq(_vData, _vVal));
+			}
+			return _bits / V::MaskBits + simd_count<V>(first, last, val, int_to_type<false>());
+		}
+
+		template <class V, typename T>
+		inline bool simd_equal(const T* first, const T* last, const T* other, int_to_type<false>) {
+			for (; first != last; ++first, ++other) if (!(*first == *other)) return false;
+			return true;
+		}
+		template <class V, typename T>
+		inline bool simd_equal(const T* first, const T* last, const T* other, int_to_type<true>) {
+			typename V::reg_type _vA, _vB;
+
+			for (; size_t(last - first) >= V::Lanes; first += V::Lanes, other += V::Lanes) {
+				V::load(_vA, first);
+				V::load(_vB, other);
+				if (V::eq(_vA, _vB) != V::FullMask) return false;
+			}
+			return simd_equal<V>(first, last, other, int_to_type<false>());
+		}
+
+		template <class V, typename T>
+		inline void simd_fill(T* first, T* last, const T& val, int_to_type<false>) {
+			squads::fill(first, last, val);
+		}
+		template <class V, typename T>
+		inline void simd_fill(T* first, T* last, const T& val, int_to_type<true>) {
+			typename V::reg_type _vVal;
+			V::set1(_vVal, val);
+
+			for (; size_t(last - first) >= V::Lanes; first += V::Lanes) V::store(first, _vVal);
+			squads::fill(first, last, val);
+		}
+
+		/// a + b, the integers wrap around in the width of T
+		template <typename T>
+		inline T simd_add(const T& a, const T& b, int_to_type<true>) {
+			return T(static_cast<unsigned long long>(a) + static_cast<unsigned long long>(b));
+		}
+		template <typename T>
+		inline T simd_add(const T& a, const T& b, int_to_type<false>) {
+			return T(a + b);
+		}
+
+		template <class V, typename T>
+		inline T simd_sum(const T* first, const T* last, int_to_type<false>) {
+			T _sum = T(0);
+			for (; first != last; ++first) _sum = simd_add(_sum, *first, int_to_type<is_integral<T>::value>());
+			return _sum;
+		}
+		template <class V, typename T>
+		inline T simd_sum(const T* first, const T* last, int_to_type<true>) {
+			typename V::reg_type _vSum, _vData;
+			T _aLanes[V::Lanes];
+			V::set1(_vSum, T(0));
+
+			for (; size_t(last - first) >= V::Lanes; first += V::Lanes) {
+				V::load(_vData, first);
+				V::add(_vSum, _vData);
+			}
+			V::store(_aLanes, _vSum);
+
+			T _sum = simd_sum<V>(_aLanes, _aLanes + V::Lanes, int_to_type<false>());
+			return simd_add(_sum, simd_sum<V>(first, last, int_to_type<false>()), int_to_type<is_integral<T>::value>());
+		}
+
+		/// The first smallest and the first largest element
+		template <typename T>
+		inline void simd_scalar_minmax(const T* first, const T* last, const T*& outMin, const T*& outMax) {
+			outMin = outMax = first;
+			for (++first; first < last; ++first) {
+				if (*first < *outMin) outMin = first;
+				if (*outMax < *first) outMax = first;
+			}
+		}
+
+		/**
+		 * @brief Get the smallest and the largest value of a range with at least V::Lanes elements.
+		 */
+		template <class V, typename T>
+		inline void simd_minmax_value(const T* first, const T* last, T& outMin, T& outMax) {
+			typename V::reg_type _vMin, _vMax, _vData;
+			T _aLanes[V::Lanes];
+			const T* _pMin;
+			const T* _pMax;
+
+			V::load(_vMin, first);
+			_vMax = _vMin;
+			for (first += V::Lanes; size_t(last - first) >= V::Lanes; first += V::Lanes) {
+				V::load(_vData, first);
+				V::min(_vMin, _vData);
+				V::max(_vMax, _vData);
+			}
+
+			V::store(_aLanes, _vMin);
+			simd_scalar_minmax(_aLanes, _aLanes + V::Lanes, _pMin, _pMax);
+			outMin = *_pMin;
+			V::store(_aLanes, _vMax);
+			simd_scalar_minmax(_aLanes, _aLanes + V::Lanes, _pMin, _pMax);
+			outMax = *_pMax;
+
+			for (; first != last; ++first) {
+				if (*first < outMin) outMin = *first;
+				if (outMax < *first) outMax = *first;
+			}
+		}
+
+		template <class V, typename T>
+		inline void simd_minmax(const T* first, const T* last, const T*& outMin, const T*& outMax, int_to_type<false>) {
+			if (first == last) { outMin = outMax = last; return; }
+			simd_scalar_minmax(first, last, outMin, outMax);
+		}
+		/// The positions are found with simd_find after the values, so the first occurrence is returned
+		template <class V, typename T>
+		inline void simd_minmax(const T* first, const T* last, const T*& outMin, const T*& outMax, int_to_type<true>) {
+			if (size_t(last - first) < V::Lanes) {
+				simd_minmax<V>(first, last, outMin, outMax, int_to_type<false>());
+				return;
+			}
+			T _min, _max;
+			simd_minmax_value<V>(first, last, _min, _max);
+			outMin = simd_find<V>(first, last, _min, int_to_type<V::HasEqual>());
+			outMax = simd_find<V>(first, last, _max, int_to_type<V::HasEqual>());
+		}
+
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		/// Ask CPUID for AVX2 once
+		inline bool simd_has_avx2() {
+			static const bool _bHasAvx2 = (__builtin_cpu_init(), __builtin_cpu_supports("avx2") != 0);
+			return _bHasAvx2;
+		}
+
+		// The AVX2 kernels for the runtime dispatch, the ops and kernels are inlined into them
+
+		template <typename T>
+		SQUADS_SIMD_AVX2_KERNEL const T* simd_find_avx2(const T* first, const T* last, const T& val) {
+			return simd_find<simd_avx2<T> >(first, last, val, int_to_type<simd_avx2<T>::HasEqual>());
+		}
+		template <typename T>
+		SQUADS_SIMD_AVX2_KERNEL size_t simd_count_avx2(const T* first, const T* last, const T& val) {
+			return simd_count<simd_avx2<T> >(first, last, val, int_to_type<simd_avx2<T>::HasEqual>());
+		}
+		template <typename T>
+		SQUADS_SIMD_AVX2_KERNEL bool simd_equal_avx2(const T* first, const T* last, const T* other) {
+			return simd_equal<simd_avx2<T> >(first, last, other, int_to_type<simd_avx2<T>::HasEqual>());
+		}
+		template <typename T>
+		SQUADS_SIMD_AVX2_KERNEL void simd_fill_avx2(T* first, T* last, const T& val) {
+			simd_fill<simd_avx2<T> >(first, last, val, int_to_type<simd_avx2<T>::Enabled>());
+		}
+		template <typename T>
+		SQUADS_SIMD_AVX2_KERNEL T simd_sum_avx2(const T* first, const T* last) {
+			return simd_sum<simd_avx2<T> >(first, last, int_to_type<simd_avx2<T>::HasAdd>());
+		}
+		template <typename T>
+		SQUADS_SIMD_AVX2_KERNEL void simd_minmax_avx2(const T* first, const T* last, const T*& outMin, const T*& outMax) {
+			using ops_type = simd_avx2<T>;
+			simd_minmax<ops_type>(first, last, outMin, outMax, int_to_type<ops_type::HasMinMax && ops_type::HasEqual>());
+		}
+
+		/// True, when the AVX2 kernel is used for T
+		#define SQUADS_SIMD_USE_AVX2(T, Has) (internal::simd_avx2<T>::Has && internal::simd_has_avx2())
+#endif // SQUADS_CONFIG_SIMD_DISPATCH
+	}
+
+	/**
+	 * @brief Find val in [first, last) with the simd instructions of the target.
+	 *
+	 * The kernel is selected at compile time (AVX2, SSE2, NEON or the scalar loop). In host builds
+	 * without -mavx2 (SQUADS_CONFIG_SIMD_DISPATCH) the AVX2 kernel is selected at runtime with CPUID.
+	 * The arithmetic types are vectorized, all other types use the scalar loop.
+	 *
+	 * @return The pointer to the first element equal to val or last when not found.
+	 */
+	template <typename T>
+	inline const T* simd_find(const T* first, const T* last, const T& val) {
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		if (SQUADS_SIMD_USE_AVX2(T, HasEqual)) return internal::simd_find_avx2(first, last, val);
+#endif
+		using ops_type = internal::simd_native<T>;
+		return internal::simd_find<ops_type>(first, last, val, int_to_type<ops_type::HasEqual>());
+	}
+
+	/**
+	 * @brief Count the elements equal to val in [first, last).
+	 * @see simd_find
+	 */
+	template <typename T>
+	inline size_t simd_count(const T* first, const T* last, const T& val) {
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		if (SQUADS_SIMD_USE_AVX2(T, HasEqual)) return internal::simd_count_avx2(first, last, val);
+#endif
+		using ops_type = internal::simd_native<T>;
+		return internal::simd_count<ops_type>(first, last, val, int_to_type<ops_type::HasEqual>());
+	}
+
+	/**
+	 * @brief Compare [first, last) with the same number of elements at other.
+	 * @note For floating point values is the compare ==, so 0.0 equal -0.0 and NaN is not equal.
+	 */
+	template <typename T>
+	inline bool simd_equal(const T* first, const T* last, const T* other) {
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		if (SQUADS_SIMD_USE_AVX2(T, HasEqual)) return internal::simd_equal_avx2(first, last, other);
+#endif
+		using ops_type = internal::simd_native<T>;
+		return internal::simd_equal<ops_type>(first, last, other, int_to_type<ops_type::HasEqual>());
+	}
+
+	/**
+	 * @brief Set all elements of [first, last) to val.
+	 */
+	template <typename T>
+	inline void simd_fill(T* first, T* last, const T& val) {
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		if (SQUADS_SIMD_USE_AVX2(T, Enabled)) { internal::simd_fill_avx2(first, last, val); return; }
+#endif
+		using ops_type = internal::simd_native<T>;
+		internal::simd_fill<ops_type>(first, last, val, int_to_type<ops_type::Enabled>());
+	}
+
+	/**
+	 * @brief Sum the elements of [first, last).
+	 *
+	 * The integers wrap around in the width of T. The floating point values are added
+	 * in lanes, so the rounding can differ from a scalar loop.
+	 */
+	template <typename T>
+	inline T simd_sum(const T* first, const T* last) {
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		if (SQUADS_SIMD_USE_AVX2(T, HasAdd)) return internal::simd_sum_avx2(first, last);
+#endif
+		using ops_type = internal::simd_native<T>;
+		return internal::simd_sum<ops_type>(first, last, int_to_type<ops_type::HasAdd>());
+	}
+
+	/**
+	 * @brief Find the first smallest and the first largest element of [first, last).
+	 * @note The floating point values must not be NaN.
+	 * @return The pair (min, max), both last for a empty range.
+	 */
+	template <typename T>
+	inline basic_compressed_pair<const T*, const T*> simd_minmax(const T* first, const T* last) {
+		const T* _pMin;
+		const T* _pMax;
+#if SQUADS_CONFIG_SIMD_DISPATCH == SQUADS_CONFIG_YES
+		if (SQUADS_SIMD_USE_AVX2(T, HasMinMax)) {
+			internal::simd_minmax_avx2(first, last, _pMin, _pMax);
+			return basic_compressed_pair<const T*, const T*>(_pMin, _pMax);
+		}
+#endif
+		using ops_type = internal::simd_native<T>;
+		internal::simd_minmax<ops_type>(first, last, _pMin, _pMax,
+			int_to_type<ops_type::HasMinMax && ops_type::HasEqual>());
+		return basic_compressed_pair<const T*, const T*>(_pMin, _pMax);
+	}
+
+	/**
+	 * @brief Find the first smallest element of [first, last).
+	 * @note The floating point values must not be NaN.
+	 * @return The pointer to the element or last for a empty range.
+	 */
+	template <typename T>
+	inline const T* simd_min_element(const T* first, const T* last) {
+		return simd_minmax(first, last).first();
+	}
+
+	/**
+	 * @brief Find the first largest element of [first, last).
+	 * @note The floating point values must not be NaN.
+	 * @return The pointer to the element or last for a empty range.
+	 */
+	template <typename T>
+	inline const T* simd_max_element(const T* first, const T* last) {
+		return simd_minmax(first, last).second();
+	}
+}
+
+#endif // __SQUADS_SIMD_ALGORITHM_H__
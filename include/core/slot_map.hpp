@@ -0,0 +1,229 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_SLOT_MAP_H__
+#define __SQUADS_SLOT_MAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "flat_map.hpp"
+
+namespace squads {
+	/**
+	 * @brief A handle to a element of a basic_slot_map.
+	 *
+	 * The version is checked on each access, so a handle to a erased
+	 * element is detected and never access a other element.
+	 */
+	struct slot_map_handle {
+		static constexpr uint32_t NoIndex = 0xFFFFFFFFu;
+
+		uint32_t Index;
+		uint32_t Version;
+
+		constexpr slot_map_handle() : Index(NoIndex), Version(0) { }
+		constexpr slot_map_handle(uint32_t index, uint32_t version) : Index(index), Version(version) { }
+
+		/**
+		 * @brief Is this the null handle, that never refers to a element?
+		 */
+		constexpr bool is_null() const { return Index == NoIndex; }
+
+		constexpr bool operator == (const slot_map_handle& rhs) const { return Index == rhs.Index && Version == rhs.Version; }
+		constexpr bool operator != (const slot_map_handle& rhs) const { return !(*this == rhs); }
+	};
+
+	/**
+	 * @brief A container with stable handles and dense storage.
+	 *
+	 * The elements are stored without holes in one contiguous array, so iteration is a linear scan.
+	 * A slot array maps the index of a handle to the position in the dense array, erase moves the
+	 * last element in the hole and fixes his slot. Insert, erase and lookup are O(1).
+	 * Insert and erase increment the version of the slot, so the handles of erased elements are invalid.
+	 *
+	 * @tparam T The type of the elements.
+	 * @tparam TAllocator The allocator for the arrays.
+	 *
+	 * @note Pointers to the elements are invalidated by insert and erase, handles not.
+	 * Is not thread-safe.
+	 */
+	template <typename T, class TAllocator = squads::default_allocator<> >
+	class basic_slot_map {
+		struct slot {
+			/// The position in the dense array, or the next free slot
+			uint32_t Index;
+			/// Odd when the slot is used, even when free
+			uint32_t Version;
+		};
+	public:
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using reference = T&;
+		using const_reference = const T&;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using iterator = T*;
+		using const_iterator = const T*;
+		using handle_type = slot_map_handle;
+		using allocator_type = TAllocator;
+		using self_type = basic_slot_map<T, TAllocator>;
+
+		basic_slot_map() : m_arrValues(), m_arrDense(), m_arrSlots(), m_uFreeHead(handle_type::NoIndex) { }
+
+		basic_slot_map(const self_type& other) = delete;
+		self_type& operator = (const self_type& other) = delete;
+
+		basic_slot_map(self_type&& other) : basic_slot_map() { swap(other); }
+		self_type& operator = (self_type&& other) { swap(other); return *this; }
+
+		iterator begin() 				{ return m_arrValues.data(); }
+		iterator end() 					{ return m_arrValues.data() + size(); }
+		const_iterator begin() const 	{ return m_arrValues.data(); }
+		const_iterator end() const 		{ return m_arrValues.data() + size(); }
+
+		pointer data() 				{ return m_arrValues.data(); }
+		const_pointer data() const 	{ return m_arrValues.data(); }
+
+		size_type size() const 		{ return m_arrValues.size(); }
+		bool empty() const 			{ return size() == 0; }
+		size_type capacity() const 	{ return m_arrValues.capacity(); }
+
+		/**
+		 * @brief Reserve space for count elements.
+		 * @return False on allocation failure.
+		 */
+		bool reserve(size_type count) {
+			return m_arrValues.reserve(count) && m_arrDense.reserve(count) && m_arrSlots.reserve(count);
+		}
+
+		/**
+		 * @brief Insert a copy of value.
+		 * @return The handle to the element, or the null handle on allocation failure.
+		 */
+		handle_type insert(const value_type& value) {
+			if(!m_arrValues.grow() || !m_arrDense.grow()) return handle_type();
+			if(m_uFreeHead == handle_type::NoIndex) {
+				if(size() >= handle_type::NoIndex || !m_arrSlots.grow()) return handle_type();
+				slot _slot = { handle_type::NoIndex, 0 };
+				m_arrSlots.push_back(_slot);
+				m_uFreeHead = uint32_t(m_arrSlots.size() - 1);
+			}
+
+			uint32_t _index = m_uFreeHead;
+			slot& _slot = m_arrSlots[_index];
+			m_uFreeHead = _slot.Index;
+			_slot.Index = uint32_t(size());
+			++_slot.Version;
+
+			m_arrValues.push_back(value);
+			m_arrDense.push_back(_index);
+			return handle_type(_index, _slot.Version);
+		}
+
+		/**
+		 * @brief Erase the element of the handle.
+		 * @return False when the handle is not valid.
+		 */
+		bool erase(const handle_type& handle) {
+			if(!contains(handle)) return false;
+
+			slot& _slot = m_arrSlots[handle.Index];
+			uint32_t _pos = _slot.Index;
+			uint32_t _last = uint32_t(size() - 1);
+
+			if(_pos != _last) {
+				m_arrValues[_pos] = squads::move(m_arrValues[_last]);
+				m_arrDense[_pos] = m_arrDense[_last];
+				m_arrSlots[m_arrDense[_pos]].Index = _pos;
+			}
+			m_arrValues.truncate(_last);
+			m_arrDense.truncate(_last);
+			free_slot(handle.Index);
+			return true;
+		}
+
+		/**
+		 * @brief Is the handle valid?
+		 * A odd version marks a used slot, so a stale or forged handle with a even version never matches a free slot.
+		 */
+		bool contains(const handle_type& handle) const {
+			return (handle.Version & 1) != 0 && handle.Index < m_arrSlots.size()
+				&& m_arrSlots[handle.Index].Version == handle.Version;
+		}
+
+		/**
+		 * @brief Get the element of the handle.
+		 * @return The pointer to the element or nullptr when the handle is not valid.
+		 */
+		pointer get(const handle_type& handle) {
+			return contains(handle) ? &m_arrValues[m_arrSlots[handle.Index].Index] : nullptr;
+		}
+		const_pointer get(const handle_type& handle) const {
+			return const_cast<self_type*>(this)->get(handle);
+		}
+
+		reference operator[](const handle_type& handle) 			 { assert(contains(handle)); return *get(handle); }
+		const_reference operator[](const handle_type& handle) const { assert(contains(handle)); return *get(handle); }
+
+		/**
+		 * @brief Get the handle of the element at pos in the dense array.
+		 */
+		handle_type handle_at(size_type pos) const {
+			assert(pos < size());
+			uint32_t _index = m_arrDense[pos];
+			return handle_type(_index, m_arrSlots[_index].Version);
+		}
+		handle_type handle_of(const_iterator it) const { return handle_at(size_type(it - begin())); }
+
+		/**
+		 * @brief Erase all elements, all handles are invalid after.
+		 */
+		void clear() {
+			for(size_type i = 0; i < size(); i++) free_slot(m_arrDense[i]);
+			m_arrValues.clear();
+			m_arrDense.clear();
+		}
+
+		void swap(self_type& other) {
+			m_arrValues.swap(other.m_arrValues);
+			m_arrDense.swap(other.m_arrDense);
+			m_arrSlots.swap(other.m_arrSlots);
+			squads::swap(m_uFreeHead, other.m_uFreeHead);
+		}
+	private:
+		void free_slot(uint32_t index) {
+			slot& _slot = m_arrSlots[index];
+			++_slot.Version;
+			_slot.Index = m_uFreeHead;
+			m_uFreeHead = index;
+		}
+	private:
+		/// The elements, without holes
+		internal::flat_array<T, TAllocator> m_arrValues;
+		/// The slot of each element in m_arrValues
+		internal::flat_array<uint32_t, TAllocator> m_arrDense;
+		internal::flat_array<slot, TAllocator> m_arrSlots;
+		uint32_t m_uFreeHead;
+	};
+
+	template <typename T, class TAllocator = squads::default_allocator<> >
+	using slot_map = basic_slot_map<T, TAllocator>;
+}
+
+#endif // __SQUADS_SLOT_MAP_H__
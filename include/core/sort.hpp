@@ -22,10 +22,37 @@
 
 #include "defines.hpp"
 #include "utils.hpp"
+#include "algorithm.hpp"
 
 namespace squads {
     namespace internal {
 
+		/**
+		 * @brief The partition of quick_sort around pivot, a copy of a element in [i, j].
+		 *
+		 * After it [low, j] is not after pivot, [i, high] is not before pivot
+		 * and a element between j and i is equal to pivot.
+		 */
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void quick_partition(T* data, long& i, long& j, const T& pivot, TPredicate& pred) {
+			do {
+				while (pred(data[i], pivot)) ++i;
+				while (pred(pivot, data[j])) --j;
+
+				// Anything to swap?
+				if (j >= i) {
+					if (i != j) {
+						// Swap
+						T tmp(data[i]);
+						data[i] = data[j];
+						data[j] = tmp;
+					}
+					++i;
+					--j;
+				}
+			} while (i <= j);
+		}
+
         SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
         void quick_sort(T* data, long low, long high, TPredicate pred) {
 			while (true) {
@@ -33,22 +60,7 @@ namespace squads {
 				long j = high;
 				const T pivot = data[(low + high) >> 1];
 
-				do {
-					while (pred(data[i], pivot)) ++i;
-					while (pred(pivot, data[j])) --j;
-
-					// Anything to swap?
-					if (j >= i) {
-						if (i != j) {
-					    	// Swap
-					    	T tmp(data[i]);
-					    	data[i] = data[j];
-					    	data[j] = tmp;
-						}
-					    ++i;
-					    --j;
-					}
-				} while (i <= j);
+				quick_partition(data, i, j, pivot, pred);
 
                 if (low < j) quick_sort(data, low, j, pred);
                 if (i < high) low = i;
@@ -74,13 +86,13 @@ namespace squads {
 
 		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
 		void shell_sort(T* data, size_t n, TPredicate pred) {
-			size_t temp, j;
+			size_t j;
 
 			for (size_t gap = n/2; gap > 0; gap /= 2) {
 				for (size_t i = gap; i < n; i += 1) {
-					temp = data[i];
+					const T temp = data[i];
 
-					for (j = i; j >= gap && pred(arr[j - gap], temp); j -= gap) {
+					for (j = i; j >= gap && pred(temp, data[j - gap]); j -= gap) {
 						data[j] = data[j - gap];
 					}
 					data[j] = temp;
@@ -117,7 +129,7 @@ namespace squads {
 
 	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
     void shell_sort(T* begin, T* end) {
-		shell_sort(begin, end, squads::greater<T>());
+		shell_sort(begin, end, squads::less<T>());
 	}
 
 
@@ -173,14 +185,188 @@ namespace squads {
 		return is_sorted;
 	}
 
+	namespace internal {
+		/// Below this size the partitions are left for the final insertion sort
+		static constexpr size_t IntroSortThreshold = 16;
+		/// Above this size the pivot is the ninther, else the median of three
+		static constexpr size_t IntroSortNintherThreshold = 128;
+
+		/// Sort the three elements, the median is then in b
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void sort_three(T* a, T* b, T* c, TPredicate pred) {
+			if (pred(*b, *a)) squads::swap(*a, *b);
+			if (pred(*c, *b)) {
+				squads::swap(*b, *c);
+				if (pred(*b, *a)) squads::swap(*a, *b);
+			}
+		}
+
+		/// The depth limit 2 * log2(n), after them the range is heap sorted
+		inline size_t intro_sort_depth(size_t n) {
+			size_t _depth = 0;
+			for (; n > 1; n >>= 1) _depth += 2;
+			return _depth;
+		}
+
+		/**
+		 * @brief Partition the range with quick_partition around a median of three (ninther for large ranges) pivot.
+		 * @param[out] left The size of the left part, [0, left) is not after the pivot.
+		 * @param[out] right The begin of the right part, [right, n) is not before the pivot.
+		 * A element in [left, right) is equal to the pivot and at his sorted place. Both parts are smaller then n.
+		 */
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void intro_partition(T* data, size_t n, size_t& left, size_t& right, TPredicate& pred) {
+			// The pivot index is below n - 1, so the partition is never empty
+			const size_t mid = (n - 1) / 2;
+			if (n > IntroSortNintherThreshold) {
+				const size_t s = n / 8;
+				sort_three(data, data + s, data + 2 * s, pred);
+				sort_three(data + mid - s, data + mid, data + mid + s, pred);
+				sort_three(data + n - 1 - 2 * s, data + n - 1 - s, data + n - 1, pred);
+				sort_three(data + s, data + mid, data + n - 1 - s, pred);
+			} else {
+				sort_three(data, data + mid, data + n - 1, pred);
+			}
+			const T pivot = data[mid];
+
+			long i = 0, j = (long)n - 1;
+			quick_partition(data, i, j, pivot, pred);
+			left = (size_t)(j + 1);
+			right = (size_t)i;
+		}
+
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void intro_sort(T* data, size_t n, size_t depth, TPredicate pred) {
+			while (n > IntroSortThreshold) {
+				if (depth == 0) {
+					squads::heap_sort(data, data + n, pred);
+					return;
+				}
+				--depth;
+
+				size_t left, right;
+				intro_partition(data, n, left, right, pred);
+
+				// Recurse into the smaller part, loop on the larger one
+				if (left < n - right) {
+					intro_sort(data, left, depth, pred);
+					data += right;
+					n -= right;
+				} else {
+					intro_sort(data + right, n - right, depth, pred);
+					n = left;
+				}
+			}
+		}
+
+		/// Move the element at k (1-based) up, until the parent is not before it, the counterpart of down_heap
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void up_heap(T* data, size_t k, TPredicate pred) {
+			const T temp = data[k - 1];
+
+			while (k > 1 && pred(data[k / 2 - 1], temp)) {
+				data[k - 1] = data[k / 2 - 1];
+				k /= 2;
+			}
+			data[k - 1] = temp;
+		}
+	} // internal
+
+	/**
+	 * @brief Sort the range with introsort, in O(n log n) also in the worst case.
+	 *
+	 * Quick sort with a median of three (ninther for large ranges) pivot, a heap sort
+	 * when the recursion is deeper then 2 * log2(n) and a final insertion sort over the
+	 * partitions below 16 elements.
+	 *
+	 * @note Is not stable.
+	 */
 	SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
     void sort(T* begin, T* end, TPredicate pred) {
-		shell_sort(begin, end, pred);
+		const size_t n = (size_t)(end - begin);
+		if (n < 2) return;
+
+		internal::intro_sort(begin, n, internal::intro_sort_depth(n), pred);
+		insertion_sort(begin, end, pred);
 	}
 
 	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
     void sort(T* begin, T* end) {
-		shell_sort(begin, end, squads::greater<T>());
+		sort(begin, end, squads::less<T>());
+	}
+
+	/**
+	 * @brief Sort [begin, middle) with the smallest elements of the range, the rest is unordered.
+	 *
+	 * A heap of middle - begin elements (down_heap) is kept while the range is scanned,
+	 * in O(n log k).
+	 */
+	SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+    void partial_sort(T* begin, T* middle, T* end, TPredicate pred) {
+		size_t k = middle - begin;
+		if (k == 0) return;
+
+		for (size_t i = k / 2; i != 0; --i)
+			internal::down_heap(begin, i, k, pred);
+
+		for (T* it = middle; it < end; ++it) {
+			if (pred(*it, begin[0])) {
+				squads::swap(*it, begin[0]);
+				internal::down_heap(begin, 1, k, pred);
+			}
+		}
+
+		while (k > 1) {
+			squads::swap(begin[0], begin[k - 1]);
+			--k;
+			internal::down_heap(begin, 1, k, pred);
+		}
+	}
+
+	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
+    void partial_sort(T* begin, T* middle, T* end) {
+		partial_sort(begin, middle, end, squads::less<T>());
+	}
+
+	/**
+	 * @brief Reorder the range, so the element at nth is the one, that would be there after sort.
+	 *
+	 * The elements before nth are not after it and the elements behind are not before it.
+	 * Introselect: the quick sort partition, only the part with nth is continued,
+	 * and a heap based partial_sort when the depth limit is reached, in O(n) typical
+	 * and O(n log n) worst case.
+	 */
+	SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+    void nth_element(T* begin, T* nth, T* end, TPredicate pred) {
+		if (nth >= end) return;
+		size_t n = (size_t)(end - begin);
+		size_t depth = internal::intro_sort_depth(n);
+
+		while (n > internal::IntroSortThreshold) {
+			if (depth == 0) {
+				partial_sort(begin, nth + 1, end, pred);
+				return;
+			}
+			--depth;
+
+			size_t left, right;
+			internal::intro_partition(begin, n, left, right, pred);
+			if (nth < begin + left) {
+				n = left;
+			} else if (nth >= begin + right) {
+				begin += right;
+				n -= right;
+			} else {
+				// nth is the pivot between the parts
+				return;
+			}
+		}
+		insertion_sort(begin, begin + n, pred);
+	}
+
+	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
+    void nth_element(T* begin, T* nth, T* end) {
+		nth_element(begin, nth, end, squads::less<T>());
 	}
 }
 
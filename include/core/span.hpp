@@ -0,0 +1,113 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_SPAN_H__
+#define __SQUADS_SPAN_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "functional.hpp"
+
+namespace squads {
+	/**
+	 * @brief A non owning view of count contiguous elements.
+	 *
+	 * A span is a pointer and a size, it is cheap to copy and give large buffers
+	 * to functions without copy. The elements must outlive the span.
+	 *
+	 * @tparam T The type of the elements, const T for a read only view.
+	 */
+	template <typename T>
+	class basic_span {
+	public:
+		using element_type = T;
+		using value_type = type_t<remove_cv<T>>;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using pointer = T*;
+		using reference = T&;
+		using iterator = T*;
+		using const_iterator = const T*;
+		using self_type = basic_span<T>;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+		constexpr basic_span() noexcept : m_pData(nullptr), m_sSize(0) { }
+		constexpr basic_span(pointer data, size_type size) noexcept : m_pData(data), m_sSize(size) { }
+		constexpr basic_span(pointer first, pointer last) noexcept
+			: m_pData(first), m_sSize(size_type(last - first)) { }
+
+		template <size_t N>
+		constexpr basic_span(T (&array)[N]) noexcept : m_pData(array), m_sSize(N) { }
+
+		/**
+		 * @brief Convert a span<U> to a span<const U>.
+		 */
+		template <typename U, typename = enable_if_t<is_same<const U, T>::value> >
+		constexpr basic_span(const basic_span<U>& other) noexcept
+			: m_pData(other.data()), m_sSize(other.size()) { }
+
+		constexpr pointer data() const noexcept 		{ return m_pData; }
+		constexpr size_type size() const noexcept 		{ return m_sSize; }
+		constexpr size_type size_bytes() const noexcept { return m_sSize * sizeof(T); }
+		constexpr bool empty() const noexcept 			{ return m_sSize == 0; }
+
+		constexpr iterator begin() const noexcept 	{ return m_pData; }
+		constexpr iterator end() const noexcept 	{ return m_pData + m_sSize; }
+
+		constexpr reference operator[](size_type index) const noexcept { return m_pData[index]; }
+		constexpr reference front() const noexcept 	{ return m_pData[0]; }
+		constexpr reference back() const noexcept 	{ return m_pData[m_sSize - 1]; }
+
+		/**
+		 * @brief Get the first count elements, count is clamped to size().
+		 */
+		constexpr self_type first(size_type count) const noexcept {
+			return self_type(m_pData, count < m_sSize ? count : m_sSize);
+		}
+		/**
+		 * @brief Get the last count elements, count is clamped to size().
+		 */
+		constexpr self_type last(size_type count) const noexcept {
+			return (count < m_sSize) ? self_type(m_pData + (m_sSize - count), count) : *this;
+		}
+		/**
+		 * @brief Get count elements from offset, both are clamped to the span.
+		 */
+		constexpr self_type subspan(size_type offset, size_type count = npos) const noexcept {
+			return (offset >= m_sSize) ? self_type(m_pData + m_sSize, size_type(0))
+				: self_type(m_pData + offset, (count < m_sSize - offset) ? count : m_sSize - offset);
+		}
+	private:
+		pointer m_pData;
+		size_type m_sSize;
+	};
+
+	/**
+	 * @brief Get a read only byte view of a span.
+	 */
+	template <typename T>
+	inline basic_span<const uint8_t> as_bytes(basic_span<T> s) noexcept {
+		return basic_span<const uint8_t>(reinterpret_cast<const uint8_t*>(s.data()), s.size_bytes());
+	}
+
+	template <typename T>
+	using span = basic_span<T>;
+}
+
+#endif // __SQUADS_SPAN_H__
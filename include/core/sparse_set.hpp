@@ -0,0 +1,250 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_SPARSE_SET_H__
+#define __SQUADS_SPARSE_SET_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "type_traits.hpp"
+
+namespace squads {
+	/**
+	 * @brief A set of the integer ids 0 to N-1, with a dense and a sparse array.
+	 *
+	 * The dense array is a permutation of all ids, the first size() ids are the members
+	 * and the rest are the free ids. The sparse array holds the position of each id in the
+	 * dense array. So insert, erase, contains, acquire of a free id and clear are all O(1),
+	 * and the members can be iterated as one contiguous array.
+	 *
+	 * @tparam TIndex A unsigned integer type for the ids.
+	 * @tparam N The number of ids.
+	 *
+	 * @note The order of the members changes on erase. Is not thread-safe.
+	 */
+	template <typename TIndex, size_t N>
+	class basic_sparse_set {
+		static_assert(squads::is_unsigned<TIndex>::value, "basic_sparse_set: TIndex must be unsigned");
+		static_assert(N >= 1 && (N - 1) <= size_t(TIndex(~TIndex(0))), "basic_sparse_set: N ids do not fit in TIndex");
+	public:
+		using index_type = TIndex;
+		using value_type = TIndex;
+		using size_type = squads::size_t;
+		using const_iterator = const TIndex*;
+		using iterator = const_iterator;
+		using self_type = basic_sparse_set<TIndex, N>;
+
+		static constexpr size_type Capacity = N;
+
+		basic_sparse_set() : m_sSize(0) {
+			for(size_type i = 0; i < Capacity; i++) m_aDense[i] = m_aSparse[i] = index_type(i);
+		}
+
+		const_iterator begin() const 	{ return m_aDense; }
+		const_iterator end() const 		{ return m_aDense + m_sSize; }
+		const index_type* data() const 	{ return m_aDense; }
+
+		size_type size() const 		{ return m_sSize; }
+		bool empty() const 			{ return m_sSize == 0; }
+		bool full() const 			{ return m_sSize == Capacity; }
+		constexpr size_type capacity() const { return Capacity; }
+
+		/**
+		 * @brief Is id a member?
+		 */
+		bool contains(index_type id) const {
+			return size_type(id) < Capacity && size_type(m_aSparse[id]) < m_sSize;
+		}
+
+		/**
+		 * @brief Get the position of a member in the dense array.
+		 */
+		size_type index_of(index_type id) const { assert(contains(id)); return m_aSparse[id]; }
+
+		/**
+		 * @brief Insert id.
+		 * @return False when id is a member or not smaller then N.
+		 */
+		bool insert(index_type id) {
+			if(size_type(id) >= Capacity || contains(id)) return false;
+
+			swap_positions(m_aSparse[id], index_type(m_sSize));
+			++m_sSize;
+			return true;
+		}
+
+		/**
+		 * @brief Insert the first free id.
+		 * @param[out] id The inserted id.
+		 * @return False when the set is full.
+		 */
+		bool acquire(index_type& id) {
+			if(full()) return false;
+
+			id = m_aDense[m_sSize++];
+			return true;
+		}
+
+		/**
+		 * @brief Erase id, the last member is moved to his position.
+		 * @return False when id is not a member.
+		 */
+		bool erase(index_type id) {
+			if(!contains(id)) return false;
+
+			swap_positions(m_aSparse[id], index_type(--m_sSize));
+			return true;
+		}
+
+		/**
+		 * @brief Erase all members, in O(1).
+		 */
+		void clear() { m_sSize = 0; }
+
+		/**
+		 * @brief Call fn(id) for all members.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) const { return squads::foreach(begin(), end(), fn); }
+	private:
+		void swap_positions(index_type a, index_type b) {
+			index_type _idA = m_aDense[a], _idB = m_aDense[b];
+			m_aDense[a] = _idB; m_aSparse[_idB] = a;
+			m_aDense[b] = _idA; m_aSparse[_idA] = b;
+		}
+	private:
+		index_type m_aDense[N];
+		index_type m_aSparse[N];
+		size_type m_sSize;
+	};
+
+	/**
+	 * @brief A basic_sparse_set with a value for each member.
+	 *
+	 * The values are stored in a array parallel to the dense ids,
+	 * so both can be iterated without holes.
+	 *
+	 * @tparam TIndex A unsigned integer type for the ids.
+	 * @tparam T The type of the values.
+	 * @tparam N The number of ids.
+	 */
+	template <typename TIndex, typename T, size_t N>
+	class basic_sparse_map {
+	public:
+		using index_type = TIndex;
+		using value_type = T;
+		using pointer = T*;
+		using const_pointer = const T*;
+		using size_type = squads::size_t;
+		using set_type = basic_sparse_set<TIndex, N>;
+		using self_type = basic_sparse_map<TIndex, T, N>;
+
+		static constexpr size_type Capacity = N;
+
+		basic_sparse_map() : m_setIds() { }
+		~basic_sparse_map() { clear(); }
+
+		basic_sparse_map(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		size_type size() const 		{ return m_setIds.size(); }
+		bool empty() const 			{ return m_setIds.empty(); }
+		bool full() const 			{ return m_setIds.full(); }
+		constexpr size_type capacity() const { return Capacity; }
+
+		/// The ids of the members
+		const set_type& ids() const { return m_setIds; }
+
+		/// The values, parallel to ids()
+		pointer values() 				{ return value_at(0); }
+		const_pointer values() const 	{ return value_at(0); }
+
+		bool contains(index_type id) const { return m_setIds.contains(id); }
+
+		/**
+		 * @brief Get the value of id.
+		 * @return The pointer to the value or nullptr when id is not a member.
+		 */
+		pointer find(index_type id) {
+			return m_setIds.contains(id) ? value_at(m_setIds.index_of(id)) : nullptr;
+		}
+		const_pointer find(index_type id) const { return const_cast<self_type*>(this)->find(id); }
+
+		/**
+		 * @brief Insert id with value.
+		 * @return The pointer to the new value or nullptr when id is a member or not smaller then N.
+		 */
+		pointer insert(index_type id, const value_type& value) {
+			if(!m_setIds.insert(id)) return nullptr;
+			return ::new (static_cast<void*>(value_at(size() - 1))) value_type(value);
+		}
+
+		/**
+		 * @brief Insert value with the first free id.
+		 * @param[out] id The new id.
+		 * @return The pointer to the new value or nullptr when full.
+		 */
+		pointer acquire(const value_type& value, index_type& id) {
+			if(!m_setIds.acquire(id)) return nullptr;
+			return ::new (static_cast<void*>(value_at(size() - 1))) value_type(value);
+		}
+
+		/**
+		 * @brief Erase id and his value.
+		 * @return False when id is not a member.
+		 */
+		bool erase(index_type id) {
+			if(!m_setIds.contains(id)) return false;
+
+			size_type _pos = m_setIds.index_of(id), _last = size() - 1;
+			if(_pos != _last) *value_at(_pos) = squads::move(*value_at(_last));
+			squads::destruct(value_at(_last));
+			m_setIds.erase(id);
+			return true;
+		}
+
+		void clear() {
+			squads::destruct_n(values(), size());
+			m_setIds.clear();
+		}
+
+		/**
+		 * @brief Call fn(id, value) for all members.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) {
+			for(size_type i = 0; i < size(); i++) fn(m_setIds.data()[i], *value_at(i));
+			return fn;
+		}
+	private:
+		pointer value_at(size_type pos) 			{ return reinterpret_cast<pointer>(m_aValues) + pos; }
+		const_pointer value_at(size_type pos) const { return reinterpret_cast<const_pointer>(m_aValues) + pos; }
+	private:
+		set_type m_setIds;
+		alignas(T) unsigned char m_aValues[N * sizeof(T)];
+	};
+
+	template <typename TIndex, size_t N>
+	using sparse_set = basic_sparse_set<TIndex, N>;
+
+	template <typename TIndex, typename T, size_t N>
+	using sparse_map = basic_sparse_map<TIndex, T, N>;
+}
+
+#endif // __SQUADS_SPARSE_SET_H__
@@ -18,7 +18,7 @@
 #ifndef __SQUADS_BASIC_SPINLOCK_H__
 #define __SQUADS_BASIC_SPINLOCK_H__
 
-#include "config.h"
+#include "config.hpp"
 #include "atomic/atomic.hpp"
 #include "copyable.hpp"
 #include "basic_lock.hpp"
@@ -53,18 +53,20 @@ namespace squads {
          *  lock (take) a basic_spinlock 
          *  @param timeout Not use
          */
-        virtual int lock(unsigned int not_use = 0) {
-            while(! m_locked.compare_exchange_t(false, true, atomic::memory_order::Acquire) ) { }
+        virtual int lock(unsigned int not_use = 0) noexcept {
+            while(! m_locked.compare_exchange_t(false, true, atomic::memory_order::Acquire) ) {
+                while(m_locked.load(atomic::memory_order::Relaxed)) { }
+            }
             return 0;
         }
 
-        virtual int time_lock(const struct timespec *timeout) {
+        virtual int time_lock(const struct timespec *timeout) noexcept {
             return lock();
         }
         /**
          *  unlock (give) a basic_spinlock .
          */
-        virtual int unlock() {
+        virtual int unlock() noexcept {
             m_locked.store(false, atomic::memory_order::Release);
             return 0;
         }
@@ -76,12 +78,9 @@ namespace squads {
          *
          * @return true if the Lock was acquired, false when not
          */
-        virtual bool try_lock() {
-            if( m_locked.compare_exchange_t(false, true, atomic::memory_order::Acquire) )
-                return false;
-            else
-                lock();
-            return true;
+        virtual bool try_lock() noexcept {
+            bool _expected = false;
+            return m_locked.compare_exchange_strong(_expected, true, atomic::memory_order::Acquire);
         }
         /**
          * Is the basic_spinlock  created (initialized) ?
@@ -92,6 +91,14 @@ namespace squads {
             return true;
         }
 
+        /**
+         * @brief Is locked?
+         * @return True if locked and false when not.
+         */
+        virtual bool is_locked() const {
+            return m_locked.load(atomic::memory_order::Relaxed);
+        }
+
         /**
 		 * @brief Converts the basic_spinlock  to value_type.
 		 * @return The convertet value
@@ -0,0 +1,390 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_STABLE_SORT_H__
+#define __SQUADS_STABLE_SORT_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "allocator.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/// Below this size a range is sorted with binary insertion sort only
+		static constexpr size_t StableSortMinMerge = 64;
+		/// The number of wins in a row, after them a merge switch to galloping
+		static constexpr size_t StableSortMinGallop = 7;
+		/// The maximal number of pending runs, enough for more then 2^40 elements
+		static constexpr size_t StableSortMaxRuns = 64;
+
+		/**
+		 * @brief Find the first index i in [0, n), with !before(first[i]), searching from the front.
+		 * before must be true for a prefix and then false.
+		 */
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TBefore)
+		size_t gallop_front(const T* first, size_t n, TBefore before) {
+			if (n == 0 || !before(first[0])) return 0;
+
+			size_t lo = 0, hi = 1;
+			while (hi < n && before(first[hi])) { lo = hi; hi = hi * 2 + 1; }
+			if (hi > n) hi = n;
+
+			// before(first[lo]) is true, the answer is in (lo, hi]
+			++lo;
+			while (lo < hi) {
+				size_t mid = lo + (hi - lo) / 2;
+				if (before(first[mid])) lo = mid + 1;
+				else hi = mid;
+			}
+			return lo;
+		}
+
+		/**
+		 * @brief Same as gallop_front, but searching from the back.
+		 */
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TBefore)
+		size_t gallop_back(const T* first, size_t n, TBefore before) {
+			if (n == 0 || before(first[n - 1])) return n;
+
+			size_t hi = n - 1, ofs = 1;
+			while (ofs < n && !before(first[n - 1 - ofs])) { hi = n - 1 - ofs; ofs = ofs * 2 + 1; }
+			size_t lo = (ofs < n) ? n - ofs : 0;
+
+			// !before(first[hi]), the answer is in [lo, hi]
+			while (lo < hi) {
+				size_t mid = lo + (hi - lo) / 2;
+				if (before(first[mid])) lo = mid + 1;
+				else hi = mid;
+			}
+			return lo;
+		}
+
+		/// Reverse [first, last)
+		SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
+		void stable_reverse(T* first, T* last) {
+			while (first < last && first < --last) squads::swap(*first++, *last);
+		}
+
+		/// Swap [first, middle) and [middle, last)
+		SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
+		void stable_rotate(T* first, T* middle, T* last) {
+			stable_reverse(first, middle);
+			stable_reverse(middle, last);
+			stable_reverse(first, last);
+		}
+
+		/// Sort [first, last) with binary insertion sort, [first, sorted) is sorted
+		SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+		void binary_insertion_sort(T* first, T* sorted, T* last, TPredicate& pred) {
+			for (; sorted < last; ++sorted) {
+				T _value = *sorted;
+				size_t _pos = gallop_back(first, size_t(sorted - first),
+					[&](const T& x) { return !pred(_value, x); });
+
+				for (T* p = sorted; p > first + _pos; --p) *p = *(p - 1);
+				first[_pos] = _value;
+			}
+		}
+
+		/// The length of a minimal run, between 32 and 64, so n / minrun is near a power of two
+		inline size_t stable_sort_min_run(size_t n) {
+			size_t r = 0;
+			while (n >= StableSortMinMerge) { r |= n & 1; n >>= 1; }
+			return n + r;
+		}
+
+		/**
+		 * @brief A bottom-up merge sort, that detect the natural runs and merge them with galloping (TimSort).
+		 * Without buffer the runs are merged in place with rotations.
+		 */
+		template <typename T, class TPredicate>
+		class stable_sorter {
+			struct run { T* Base; size_t Length; };
+		public:
+			stable_sorter(TPredicate& pred, T* buffer)
+				: m_fnPred(pred), m_pBuffer(buffer), m_sRuns(0), m_sMinGallop(StableSortMinGallop) { }
+
+			void sort(T* first, size_t n) {
+				if (n < 2) return;
+
+				if (n < StableSortMinMerge) {
+					binary_insertion_sort(first, first + count_run(first, first + n), first + n, m_fnPred);
+					return;
+				}
+
+				const size_t _minRun = stable_sort_min_run(n);
+				T* _pLast = first + n;
+
+				while (first < _pLast) {
+					size_t _length = count_run(first, _pLast);
+
+					// Extend a short run to minrun
+					if (_length < _minRun) {
+						size_t _force = squads::min<size_t>(_minRun, size_t(_pLast - first));
+						binary_insertion_sort(first, first + _length, first + _force, m_fnPred);
+						_length = _force;
+					}
+					assert(m_sRuns < StableSortMaxRuns);
+					m_aRuns[m_sRuns++] = run{ first, _length };
+					merge_collapse();
+					first += _length;
+				}
+				while (m_sRuns > 1) {
+					size_t i = m_sRuns - 2;
+					if (i > 0 && m_aRuns[i - 1].Length < m_aRuns[i + 1].Length) --i;
+					merge_at(i);
+				}
+			}
+		private:
+			/// Get the length of the run at first, a strict descending run is reversed
+			size_t count_run(T* first, T* last) {
+				T* _pIt = first + 1;
+				if (_pIt == last) return 1;
+
+				if (m_fnPred(*_pIt, *first)) {
+					while (++_pIt < last && m_fnPred(*_pIt, *(_pIt - 1))) { }
+					stable_reverse(first, _pIt);
+				} else {
+					while (++_pIt < last && !m_fnPred(*_pIt, *(_pIt - 1))) { }
+				}
+				return size_t(_pIt - first);
+			}
+
+			/// Merge the pending runs, until the lengths decrease faster then the fibonacci numbers
+			void merge_collapse() {
+				while (m_sRuns > 1) {
+					size_t n = m_sRuns - 2;
+					if ((n > 0 && m_aRuns[n - 1].Length <= m_aRuns[n].Length + m_aRuns[n + 1].Length) ||
+						(n > 1 && m_aRuns[n - 2].Length <= m_aRuns[n - 1].Length + m_aRuns[n].Length)) {
+						if (m_aRuns[n - 1].Length < m_aRuns[n + 1].Length) --n;
+					} else if (m_aRuns[n].Length > m_aRuns[n + 1].Length) {
+						break;
+					}
+					merge_at(n);
+				}
+			}
+
+			/// Merge the runs i and i + 1
+			void merge_at(size_t i) {
+				T* _pA = m_aRuns[i].Base;
+				size_t _na = m_aRuns[i].Length;
+				T* _pB = m_aRuns[i + 1].Base;
+				size_t _nb = m_aRuns[i + 1].Length;
+
+				m_aRuns[i].Length = _na + _nb;
+				for (size_t j = i + 1; j + 1 < m_sRuns; j++) m_aRuns[j] = m_aRuns[j + 1];
+				--m_sRuns;
+
+				// The elements of A not after B[0] and of B not before A[na - 1] are in place
+				const T& _b0 = *_pB;
+				size_t _k = gallop_front(_pA, _na, [&](const T& x) { return !m_fnPred(_b0, x); });
+				_pA += _k;
+				_na -= _k;
+				if (_na == 0) return;
+
+				const T& _aLast = _pA[_na - 1];
+				_nb = gallop_back(_pB, _nb, [&](const T& x) { return m_fnPred(x, _aLast); });
+				if (_nb == 0) return;
+
+				if (m_pBuffer == nullptr) merge_inplace(_pA, _pB, _pB + _nb);
+				else if (_na <= _nb) merge_lo(_pA, _na, _pB, _nb);
+				else merge_hi(_pA, _na, _pB, _nb);
+			}
+
+			/// Merge with A in the buffer, from the front
+			void merge_lo(T* a, size_t na, T* b, size_t nb) {
+				for (size_t i = 0; i < na; i++) ::new (static_cast<void*>(m_pBuffer + i)) T(a[i]);
+
+				T* _pDest = a;
+				T* _pA = m_pBuffer;
+				T* _pAEnd = m_pBuffer + na;
+				T* _pB = b;
+				T* _pBEnd = b + nb;
+
+				while (_pA < _pAEnd && _pB < _pBEnd) {
+					size_t _winsA = 0, _winsB = 0;
+
+					// One element at a time, until one run wins often
+					do {
+						if (m_fnPred(*_pB, *_pA)) {
+							*_pDest++ = *_pB++;
+							++_winsB; _winsA = 0;
+						} else {
+							*_pDest++ = *_pA++;
+							++_winsA; _winsB = 0;
+						}
+					} while (_pA < _pAEnd && _pB < _pBEnd && (_winsA | _winsB) < m_sMinGallop);
+
+					// Galloping, copy the blocks of each run at once
+					while (_pA < _pAEnd && _pB < _pBEnd) {
+						const T& _bKey = *_pB;
+						_winsA = gallop_front(_pA, size_t(_pAEnd - _pA), [&](const T& x) { return !m_fnPred(_bKey, x); });
+						for (size_t i = 0; i < _winsA; i++) *_pDest++ = *_pA++;
+						if (_pA == _pAEnd) break;
+						*_pDest++ = *_pB++;
+						if (_pB == _pBEnd) break;
+
+						const T& _aKey = *_pA;
+						_winsB = gallop_front(_pB, size_t(_pBEnd - _pB), [&](const T& x) { return m_fnPred(x, _aKey); });
+						for (size_t i = 0; i < _winsB; i++) *_pDest++ = *_pB++;
+						if (_pB == _pBEnd) break;
+						*_pDest++ = *_pA++;
+
+						if (m_sMinGallop > 1) --m_sMinGallop;
+						if (_winsA < StableSortMinGallop && _winsB < StableSortMinGallop) {
+							++m_sMinGallop;
+							break;
+						}
+					}
+				}
+				// The rest of B is in place
+				while (_pA < _pAEnd) *_pDest++ = *_pA++;
+				for (size_t i = 0; i < na; i++) squads::destruct(m_pBuffer + i);
+			}
+
+			/// Merge with B in the buffer, from the back
+			void merge_hi(T* a, size_t na, T* b, size_t nb) {
+				for (size_t i = 0; i < nb; i++) ::new (static_cast<void*>(m_pBuffer + i)) T(b[i]);
+
+				T* _pDest = b + nb;
+				T* _pA = a + na;
+				T* _pB = m_pBuffer + nb;
+
+				while (_pA > a && _pB > m_pBuffer) {
+					size_t _winsA = 0, _winsB = 0;
+
+					do {
+						if (m_fnPred(*(_pB - 1), *(_pA - 1))) {
+							*--_pDest = *--_pA;
+							++_winsA; _winsB = 0;
+						} else {
+							*--_pDest = *--_pB;
+							++_winsB; _winsA = 0;
+						}
+					} while (_pA > a && _pB > m_pBuffer && (_winsA | _winsB) < m_sMinGallop);
+
+					while (_pA > a && _pB > m_pBuffer) {
+						const T& _bKey = *(_pB - 1);
+						size_t _k = gallop_back(a, size_t(_pA - a), [&](const T& x) { return !m_fnPred(_bKey, x); });
+						_winsA = size_t(_pA - a) - _k;
+						for (size_t i = 0; i < _winsA; i++) *--_pDest = *--_pA;
+						if (_pA == a) break;
+						*--_pDest = *--_pB;
+						if (_pB == m_pBuffer) break;
+
+						const T& _aKey = *(_pA - 1);
+						_k = gallop_back(m_pBuffer, size_t(_pB - m_pBuffer), [&](const T& x) { return m_fnPred(x, _aKey); });
+						_winsB = size_t(_pB - m_pBuffer) - _k;
+						for (size_t i = 0; i < _winsB; i++) *--_pDest = *--_pB;
+						if (_pB == m_pBuffer) break;
+						*--_pDest = *--_pA;
+
+						if (m_sMinGallop > 1) --m_sMinGallop;
+						if (_winsA < StableSortMinGallop && _winsB < StableSortMinGallop) {
+							++m_sMinGallop;
+							break;
+						}
+					}
+				}
+				// The rest of A is in place
+				while (_pB > m_pBuffer) *--_pDest = *--_pB;
+				for (size_t i = 0; i < nb; i++) squads::destruct(m_pBuffer + i);
+			}
+
+			/// Merge without buffer: split the longer run, rotate and merge both halves
+			void merge_inplace(T* first, T* middle, T* last) {
+				size_t _na = size_t(middle - first);
+				size_t _nb = size_t(last - middle);
+				if (_na == 0 || _nb == 0) return;
+
+				if (_na + _nb == 2) {
+					if (m_fnPred(*middle, *first)) squads::swap(*first, *middle);
+					return;
+				}
+
+				T* _pCutA;
+				T* _pCutB;
+				if (_na > _nb) {
+					_pCutA = first + _na / 2;
+					const T& _key = *_pCutA;
+					_pCutB = middle + gallop_front(middle, _nb, [&](const T& x) { return m_fnPred(x, _key); });
+				} else {
+					_pCutB = middle + _nb / 2;
+					const T& _key = *_pCutB;
+					_pCutA = first + gallop_front(first, _na, [&](const T& x) { return !m_fnPred(_key, x); });
+				}
+				stable_rotate(_pCutA, middle, _pCutB);
+
+				T* _pMiddle = _pCutA + (_pCutB - middle);
+				merge_inplace(first, _pCutA, _pMiddle);
+				merge_inplace(_pMiddle, _pCutB, last);
+			}
+		private:
+			TPredicate& m_fnPred;
+			T* m_pBuffer;
+			run m_aRuns[StableSortMaxRuns];
+			size_t m_sRuns;
+			size_t m_sMinGallop;
+		};
+	} // internal
+
+	/**
+	 * @brief Sort the range and keep the order of equal elements.
+	 *
+	 * A TimSort: natural runs are detected (descending runs reversed), short runs are
+	 * extended with binary insertion sort and the runs are merged with galloping,
+	 * so presorted input is sorted in O(n). The merge buffer of n / 2 elements is from
+	 * the allocator, without memory the runs are merged in place with rotations,
+	 * in O(n log^2 n).
+	 *
+	 * @return False when the buffer could not be allocated, the range is sorted anyway.
+	 */
+	template <typename T, class TPredicate, class TAllocator>
+	bool stable_sort(T* begin, T* end, TPredicate pred, TAllocator& allocator) {
+		const size_t n = (size_t)(end - begin);
+		const size_t _bufferSize = n / 2;
+
+		T* _pBuffer = nullptr;
+		if (n >= internal::StableSortMinMerge)
+			_pBuffer = static_cast<T*>(allocator.allocate(_bufferSize, sizeof(T), alignof(T)));
+
+		internal::stable_sorter<T, TPredicate> _sorter(pred, _pBuffer);
+		_sorter.sort(begin, n);
+
+		if (_pBuffer != nullptr) allocator.deallocate(_pBuffer, _bufferSize, sizeof(T), alignof(T));
+		return _pBuffer != nullptr || n < internal::StableSortMinMerge;
+	}
+
+	/**
+	 * @brief Stable sort with the buffer from squads::default_allocator.
+	 */
+	SQUADS_TEMPLATE_FULL_DECL_TWO(typename, T, class, TPredicate)
+	bool stable_sort(T* begin, T* end, TPredicate pred) {
+		squads::default_allocator<> _allocator;
+		return stable_sort(begin, end, pred, _allocator);
+	}
+
+	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
+	bool stable_sort(T* begin, T* end) {
+		return stable_sort(begin, end, squads::less<T>());
+	}
+}
+
+#endif // __SQUADS_STABLE_SORT_H__
@@ -0,0 +1,275 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_STATIC_HASH_MAP_H__
+#define __SQUADS_STATIC_HASH_MAP_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "functional.hpp"
+#include "hash.hpp"
+#include "seqlock.hpp"
+#include "type_traits.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	/**
+	 * @brief A fixed capacity hash map without any heap allocation.
+	 *
+	 * The elements are stored in the object, collisions are solved with Robin Hood
+	 * linear probing and the home slot is selected with a mask, so N must be a power of two.
+	 * Erase shifts the following elements back, there are no tombstones.
+	 *
+	 * Every write is wrapped in a basic_seqlock. Readers (tasks or ISR) never block:
+	 * get() repeats the lookup when a write has overlapped, try_get() makes a single pass
+	 * and reports read_result::Busy instead, for an ISR that has interrupted the writer.
+	 *
+	 * @tparam TKey The type of the keys, must be trivially copyable.
+	 * @tparam TValue The type of the values, must be trivially copyable.
+	 * @tparam N The capacity, a power of two.
+	 * @tparam THash The hasher, default squads::hash<TKey>.
+	 * @tparam TEqual The key compare, default squads::equal_to<TKey>.
+	 *
+	 * @note Writers must be serialized by the caller.
+	 */
+	template <typename TKey, typename TValue, size_t N, class THash = squads::hash<TKey>,
+			  class TEqual = squads::equal_to<TKey> >
+	class basic_static_hash_map {
+		static_assert(N >= 2 && (N & (N - 1)) == 0, "basic_static_hash_map: N must be a power of two");
+		static_assert(squads::is_trivially_copyable<TKey>::value, "basic_static_hash_map: the key must be trivially copyable");
+		static_assert(squads::is_trivially_copyable<TValue>::value, "basic_static_hash_map: the value must be trivially copyable");
+	public:
+		using key_type = TKey;
+		using mapped_type = TValue;
+		using size_type = squads::size_t;
+		using hasher = THash;
+		using key_equal = TEqual;
+		using self_type = basic_static_hash_map<TKey, TValue, N, THash, TEqual>;
+		using lock_type = basic_seqlock<unsigned int>;
+		/// The probe distance + 1 of a slot, 0 is a empty slot.
+		using dist_type = typename squads::conditional<(N < 256), uint8_t,
+							typename squads::conditional<(N < 65536), uint16_t, uint32_t>::type >::type;
+
+		/**
+		 * @brief The result of a single pass lookup.
+		 */
+		enum class read_result {
+			Found,		///< The key was found, the value is copied
+			NotFound,	///< The key is not in the map
+			Busy		///< A write was active, the read must be repeated
+		};
+
+		static constexpr size_type Capacity = N;
+		static constexpr size_type Mask = N - 1;
+		/// The maximal number of elements, 7/8 of the capacity.
+		static constexpr size_type MaxSize = N - N / 8;
+
+		struct entry {
+			key_type key;
+			mapped_type value;
+		};
+
+		basic_static_hash_map() noexcept
+			: m_sSize(0), m_seqLock() { memset(m_aDist, 0, sizeof(m_aDist)); }
+
+		constexpr size_type capacity() const 	{ return Capacity; }
+		constexpr size_type max_size() const 	{ return MaxSize; }
+		size_type size() const 					{ return m_sSize; }
+		bool empty() const 						{ return m_sSize == 0; }
+		bool full() const 						{ return m_sSize >= MaxSize; }
+
+		/**
+		 * @brief Insert a key/value, when the key is not in the map.
+		 * @return False when the key exist or the map is full.
+		 */
+		bool insert(const key_type& key, const mapped_type& value) {
+			if(find_index(key) != npos() || full()) return false;
+
+			typename lock_type::write_guard _guard(m_seqLock);
+			insert_unique(key, value);
+			return true;
+		}
+
+		/**
+		 * @brief Insert a key/value or overwrite the value of an existing key.
+		 * @return False when the map is full.
+		 */
+		bool insert_or_assign(const key_type& key, const mapped_type& value) {
+			size_type _index = find_index(key);
+			if(_index == npos() && full()) return false;
+
+			typename lock_type::write_guard _guard(m_seqLock);
+			if(_index != npos()) m_aSlots[_index].value = value;
+			else insert_unique(key, value);
+			return true;
+		}
+
+		/**
+		 * @brief Erase the element with the given key.
+		 * @return True when the key was erased.
+		 */
+		bool erase(const key_type& key) {
+			size_type _index = find_index(key);
+			if(_index == npos()) return false;
+
+			typename lock_type::write_guard _guard(m_seqLock);
+			size_type _next = (_index + 1) & Mask;
+
+			// Backward shift the chain behind the erased slot.
+			while(m_aDist[_next] > 1) {
+				m_aSlots[_index] = m_aSlots[_next];
+				m_aDist[_index] = dist_type(m_aDist[_next] - 1);
+				_index = _next;
+				_next = (_next + 1) & Mask;
+			}
+			m_aDist[_index] = 0;
+			--m_sSize;
+			return true;
+		}
+
+		/**
+		 * @brief Remove all elements.
+		 */
+		void clear() {
+			typename lock_type::write_guard _guard(m_seqLock);
+			memset(m_aDist, 0, sizeof(m_aDist));
+			m_sSize = 0;
+		}
+
+		/**
+		 * @brief Single pass lookup, never loops and so usable from a ISR.
+		 * @param key The key to find.
+		 * @param value The value of the key is copied to this, when found.
+		 */
+		read_result try_get(const key_type& key, mapped_type& value) const noexcept {
+			unsigned int _seq = m_seqLock.read_begin();
+			if(lock_type::is_write_pending(_seq)) return read_result::Busy;
+
+			size_type _index = find_index(key);
+			mapped_type _value;
+			if(_index != npos()) _value = m_aSlots[_index].value;
+
+			if(m_seqLock.read_retry(_seq)) return read_result::Busy;
+			if(_index == npos()) return read_result::NotFound;
+
+			value = _value;
+			return read_result::Found;
+		}
+
+		/**
+		 * @brief Lookup, repeated until no write has overlapped.
+		 * @param key The key to find.
+		 * @param value The value of the key is copied to this, when found.
+		 * @return True when the key was found.
+		 */
+		bool get(const key_type& key, mapped_type& value) const noexcept {
+			read_result _ret;
+			while( (_ret = try_get(key, value)) == read_result::Busy) { }
+			return _ret == read_result::Found;
+		}
+
+		/**
+		 * @brief Is an element with the given key in the map?
+		 */
+		bool contains(const key_type& key) const noexcept {
+			mapped_type _value;
+			return get(key, _value);
+		}
+
+		/**
+		 * @brief Get a pointer to the value of the key, for the writer side.
+		 * @return The pointer to the value or nullptr when not found.
+		 */
+		mapped_type* find(const key_type& key) {
+			size_type _index = find_index(key);
+			return (_index == npos()) ? nullptr : &m_aSlots[_index].value;
+		}
+
+		/**
+		 * @brief Call fn(key, value) for all elements, for the writer side.
+		 */
+		template <class TFn>
+		TFn foreach(TFn fn) const {
+			for(size_type i = 0; i < Capacity; i++) {
+				if(m_aDist[i] != 0) fn(m_aSlots[i].key, m_aSlots[i].value);
+			}
+			return fn;
+		}
+
+		/**
+		 * @brief Get the seqlock of this map, to group more reads in one read section.
+		 */
+		const lock_type& get_lock() const 	{ return m_seqLock; }
+	private:
+		static constexpr size_type npos() 	{ return size_type(-1); }
+
+		static size_type home_of(const key_type& key) {
+			return internal::hash_mix(hasher()(key)) & Mask;
+		}
+
+		size_type find_index(const key_type& key) const {
+			size_type _index = home_of(key);
+			key_equal _equal;
+
+			for(size_type _dist = 1; _dist <= Capacity; _dist++) {
+				dist_type _slot = m_aDist[_index];
+
+				// A poorer slot or a empty slot: the key can't be behind it.
+				if(_slot < _dist) return npos();
+				if(_slot == _dist && _equal(m_aSlots[_index].key, key)) return _index;
+
+				_index = (_index + 1) & Mask;
+			}
+			return npos();
+		}
+
+		void insert_unique(const key_type& key, const mapped_type& value) {
+			entry _entry = { key, value };
+			dist_type _dist = 1;
+			size_type _index = home_of(key);
+
+			while(true) {
+				if(m_aDist[_index] == 0) {
+					m_aSlots[_index] = _entry;
+					m_aDist[_index] = _dist;
+					++m_sSize;
+					return;
+				}
+				// Robin Hood: take the slot from a richer element.
+				if(m_aDist[_index] < _dist) {
+					squads::swap(_entry, m_aSlots[_index]);
+					squads::swap(_dist, m_aDist[_index]);
+				}
+				_index = (_index + 1) & Mask;
+				++_dist;
+			}
+		}
+	private:
+		dist_type 	m_aDist[N];
+		entry 		m_aSlots[N];
+		size_type 	m_sSize;
+		lock_type 	m_seqLock;
+	};
+
+	template <typename TKey, typename TValue, size_t N, class THash = squads::hash<TKey>,
+			  class TEqual = squads::equal_to<TKey> >
+	using static_hash_map = basic_static_hash_map<TKey, TValue, N, THash, TEqual>;
+}
+
+#endif // __SQUADS_STATIC_HASH_MAP_H__
@@ -0,0 +1,313 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_STRING_H__
+#define __SQUADS_STRING_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "allocator.hpp"
+#include "fixed_string.hpp"
+
+namespace squads {
+	/**
+	 * @brief A growable string with small string optimization.
+	 *
+	 * Strings up to SsoCapacity chars are stored in the object self, longer strings
+	 * on the heap of the given allocator. The length is stored and the hash is
+	 * computed on first use and cached until the string is changed.
+	 * On allocation failure the changing functions return false and the string is unchanged.
+	 *
+	 * @tparam TAllocator The allocator for the heap buffer.
+	 */
+	template <class TAllocator = squads::default_allocator<> >
+	class basic_string {
+	public:
+		using value_type = char;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using iterator = const char*;
+		using const_iterator = const char*;
+		using allocator_type = TAllocator;
+		using self_type = basic_string<TAllocator>;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+		/// The number of chars, that are stored without heap
+		static constexpr size_type SsoCapacity = 15;
+
+		basic_string() noexcept
+			: m_pData(m_aLocal), m_sLength(0), m_sCapacity(SsoCapacity), m_hHash(0), m_aAllocator() {
+			m_aLocal[0] = '\0';
+		}
+
+		basic_string(const char* str) : basic_string() { append(str); }
+		basic_string(const char* str, size_type length) : basic_string() { append(str, length); }
+
+		template <size_t N>
+		basic_string(const basic_fixed_string<N>& str) : basic_string() { append(str.data(), str.size()); }
+
+		explicit basic_string(const string_view& str) : basic_string() { append(str.data(), str.size()); }
+
+		basic_string(const self_type& other) : basic_string() {
+			append(other.m_pData, other.m_sLength);
+			m_hHash = other.m_hHash;
+		}
+
+		basic_string(self_type&& other) noexcept : basic_string() { swap(other); }
+
+		~basic_string() { release(); }
+
+		self_type& operator = (const self_type& other) {
+			if(this != &other) {
+				if(assign(other.m_pData, other.m_sLength)) m_hHash = other.m_hHash;
+			}
+			return *this;
+		}
+		self_type& operator = (self_type&& other) noexcept {
+			if(this != &other) { clear(); swap(other); }
+			return *this;
+		}
+		self_type& operator = (const char* str) { assign(str); return *this; }
+
+		const char* c_str() const noexcept 	{ return m_pData; }
+		const char* data() const noexcept 	{ return m_pData; }
+
+		operator string_view() const noexcept { return string_view(m_pData, m_sLength); }
+
+		size_type size() const noexcept 		{ return m_sLength; }
+		size_type length() const noexcept 		{ return m_sLength; }
+		size_type capacity() const noexcept 	{ return m_sCapacity; }
+		bool empty() const noexcept 			{ return m_sLength == 0; }
+		/// Is the string stored in the object self
+		bool is_local() const noexcept 			{ return m_pData == m_aLocal; }
+
+		const_iterator begin() const noexcept 	{ return m_pData; }
+		const_iterator end() const noexcept 	{ return m_pData + m_sLength; }
+
+		char operator[](size_type pos) const noexcept { assert(pos < m_sLength); return m_pData[pos]; }
+
+		char front() const noexcept 	{ assert(m_sLength > 0); return m_pData[0]; }
+		char back() const noexcept 		{ assert(m_sLength > 0); return m_pData[m_sLength - 1]; }
+
+		/**
+		 * @brief Set the char at pos.
+		 */
+		void set(size_type pos, char ch) noexcept {
+			assert(pos < m_sLength);
+			m_pData[pos] = ch; m_hHash = 0;
+		}
+
+		/**
+		 * @brief Clear the string, the buffer is keeped.
+		 */
+		void clear() noexcept { m_sLength = 0; m_pData[0] = '\0'; m_hHash = 0; }
+
+		/**
+		 * @brief Reserve space for count chars, without the terminating zero.
+		 * @return False on allocation failure.
+		 */
+		bool reserve(size_type count) {
+			if(count <= m_sCapacity) return true;
+
+			char* _pData = static_cast<char*>(m_aAllocator.allocate(count + 1, sizeof(char), alignof(char)));
+			if(_pData == nullptr) return false;
+
+			memcpy(_pData, m_pData, m_sLength + 1);
+			release();
+			m_pData = _pData;
+			m_sCapacity = count;
+			return true;
+		}
+
+		/**
+		 * @brief Move a heap string back into the object, when it fit.
+		 */
+		void shrink_to_fit() {
+			if(is_local() || m_sLength > SsoCapacity) return;
+
+			memcpy(m_aLocal, m_pData, m_sLength + 1);
+			release();
+			m_pData = m_aLocal;
+			m_sCapacity = SsoCapacity;
+		}
+
+		/**
+		 * @brief Replace the content with length chars of str.
+		 * @return False on allocation failure.
+		 */
+		bool assign(const char* str, size_type length) {
+			if(!reserve(length)) return false;
+			m_sLength = 0;
+			return append(str, length);
+		}
+		bool assign(const char* str) {
+			return assign(str, (str == nullptr) ? 0 : strlen(str));
+		}
+
+		/**
+		 * @brief Append length chars of str.
+		 * @return False on allocation failure.
+		 */
+		bool append(const char* str, size_type length) {
+			if(length == 0) return true;
+			if(length > m_sCapacity - m_sLength) {
+				// str can be a part of this string, so remember the offset
+				bool _bSelf = str >= m_pData && str < m_pData + m_sLength;
+				size_type _offset = _bSelf ? size_type(str - m_pData) : 0;
+				size_type _needed = m_sLength + length;
+				size_type _grow = m_sCapacity * 2;
+
+				if(!reserve(_grow > _needed ? _grow : _needed)) return false;
+				if(_bSelf) str = m_pData + _offset;
+			}
+			memmove(m_pData + m_sLength, str, length);
+			m_sLength += length;
+			m_pData[m_sLength] = '\0';
+			m_hHash = 0;
+			return true;
+		}
+		bool append(const char* str) {
+			return (str == nullptr) ? true : append(str, strlen(str));
+		}
+		bool append(const self_type& str) 	{ return append(str.m_pData, str.m_sLength); }
+		bool append(const string_view& str) { return append(str.data(), str.size()); }
+
+		bool push_back(char ch) { return append(&ch, 1); }
+
+		void pop_back() noexcept {
+			assert(m_sLength > 0);
+			m_pData[--m_sLength] = '\0'; m_hHash = 0;
+		}
+
+		/**
+		 * @brief Resize the string to length chars, new chars are set to ch.
+		 * @return False on allocation failure.
+		 */
+		bool resize(size_type length, char ch = '\0') {
+			if(length > m_sLength) {
+				if(!reserve(length)) return false;
+				memset(m_pData + m_sLength, ch, length - m_sLength);
+			}
+			m_sLength = length;
+			m_pData[m_sLength] = '\0';
+			m_hHash = 0;
+			return true;
+		}
+
+		self_type& operator += (const char* str) 		{ append(str); return *this; }
+		self_type& operator += (const self_type& str) 	{ append(str); return *this; }
+		self_type& operator += (char ch) 				{ push_back(ch); return *this; }
+
+		/**
+		 * @brief Get count chars from pos as new string.
+		 */
+		self_type substr(size_type pos, size_type count = npos) const {
+			if(pos > m_sLength) pos = m_sLength;
+			if(count > m_sLength - pos) count = m_sLength - pos;
+			return self_type(m_pData + pos, count);
+		}
+
+		/**
+		 * @brief Compare with length chars of str.
+		 * @return Less then 0, 0 or greater then 0, like memcmp.
+		 */
+		int compare(const char* str, size_type length) const noexcept {
+			return internal::string_compare(m_pData, m_sLength, str, length);
+		}
+		int compare(const char* str) const noexcept 		{ return compare(str, strlen(str)); }
+		int compare(const self_type& str) const noexcept 	{ return compare(str.m_pData, str.m_sLength); }
+
+		/**
+		 * @brief Find the first ch at or after pos.
+		 * @return The position or npos when not found.
+		 */
+		size_type find(char ch, size_type pos = 0) const noexcept {
+			if(pos >= m_sLength) return npos;
+			const void* _pFound = memchr(m_pData + pos, ch, m_sLength - pos);
+			return (_pFound == nullptr) ? npos : size_type(static_cast<const char*>(_pFound) - m_pData);
+		}
+
+		bool starts_with(const char* str, size_type length) const noexcept {
+			return length <= m_sLength && memcmp(m_pData, str, length) == 0;
+		}
+
+		/**
+		 * @brief Get the hash of the string, computed on first use.
+		 */
+		result_type hash() const noexcept {
+			return internal::string_hash(m_hHash, m_pData, m_sLength);
+		}
+
+		bool operator == (const self_type& rhs) const noexcept {
+			if(m_sLength != rhs.m_sLength) return false;
+			if(m_hHash != 0 && rhs.m_hHash != 0 && m_hHash != rhs.m_hHash) return false;
+			return memcmp(m_pData, rhs.m_pData, m_sLength) == 0;
+		}
+		bool operator != (const self_type& rhs) const noexcept { return !(*this == rhs); }
+		bool operator < (const self_type& rhs) const noexcept 	{ return compare(rhs) < 0; }
+		bool operator > (const self_type& rhs) const noexcept 	{ return compare(rhs) > 0; }
+		bool operator <= (const self_type& rhs) const noexcept 	{ return compare(rhs) <= 0; }
+		bool operator >= (const self_type& rhs) const noexcept 	{ return compare(rhs) >= 0; }
+
+		bool operator == (const char* rhs) const noexcept { return compare(rhs) == 0; }
+		bool operator != (const char* rhs) const noexcept { return compare(rhs) != 0; }
+
+		void swap(self_type& other) noexcept {
+			if(this == &other) return;
+
+			char _aLocal[SsoCapacity + 1];
+			bool _bLocal = is_local(), _bOtherLocal = other.is_local();
+
+			if(_bLocal) memcpy(_aLocal, m_aLocal, m_sLength + 1);
+			if(_bOtherLocal) memcpy(m_aLocal, other.m_aLocal, other.m_sLength + 1);
+			if(_bLocal) memcpy(other.m_aLocal, _aLocal, m_sLength + 1);
+
+			char* _pData = _bLocal ? other.m_aLocal : m_pData;
+			m_pData = _bOtherLocal ? m_aLocal : other.m_pData;
+			other.m_pData = _pData;
+
+			squads::swap(m_sLength, other.m_sLength);
+			squads::swap(m_sCapacity, other.m_sCapacity);
+			squads::swap(m_hHash, other.m_hHash);
+			squads::swap(m_aAllocator, other.m_aAllocator);
+		}
+	private:
+		void release() {
+			if(!is_local())
+				m_aAllocator.deallocate(m_pData, m_sCapacity + 1, sizeof(char), alignof(char));
+		}
+	private:
+		char* m_pData;
+		size_type m_sLength;
+		size_type m_sCapacity;
+		char m_aLocal[SsoCapacity + 1];
+		mutable result_type m_hHash;
+		allocator_type m_aAllocator;
+	};
+
+	template <class TAllocator>
+	struct hash< basic_string<TAllocator> > {
+		result_type operator()(const basic_string<TAllocator>& str) const noexcept {
+			return str.hash();
+		}
+	};
+
+	using string = basic_string<>;
+}
+
+#endif // __SQUADS_STRING_H__
@@ -0,0 +1,213 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_STRING_VIEW_H__
+#define __SQUADS_STRING_VIEW_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include <string.h>
+
+#include "hash.hpp"
+
+namespace squads {
+	namespace internal {
+		/**
+		 * @brief Get the length of a zero terminated string, usable in constant expressions.
+		 */
+		template <typename TChar>
+		constexpr size_t string_length(const TChar* str) noexcept {
+			size_t _length = 0;
+			while(str[_length] != TChar(0)) ++_length;
+			return _length;
+		}
+
+		/**
+		 * @brief Compare count chars, like memcmp.
+		 */
+		template <typename TChar>
+		inline int string_compare_n(const TChar* lhs, const TChar* rhs, size_t count) noexcept {
+			if(sizeof(TChar) == 1) return (count == 0) ? 0 : memcmp(lhs, rhs, count);
+			for(size_t i = 0; i < count; i++) {
+				if(lhs[i] != rhs[i]) return (lhs[i] < rhs[i]) ? -1 : 1;
+			}
+			return 0;
+		}
+
+		/**
+		 * @brief Hash the bytes of a string, the one hash of views and owning strings.
+		 * 0 marks a not computed hash in the caches of the strings, so a computed 0 is 1.
+		 */
+		inline result_type string_hash(const void* str, size_t length) noexcept {
+			result_type _hash = hash_bytes(str, length);
+			return (_hash == 0) ? 1 : _hash;
+		}
+
+		/**
+		 * @brief Get the cached hash of a string, and compute it on first use.
+		 */
+		inline result_type string_hash(result_type& cache, const char* str, size_t length) noexcept {
+			if(cache == 0) cache = string_hash(str, length);
+			return cache;
+		}
+	}
+
+	/**
+	 * @brief A non owning, read only view of a string with known length.
+	 *
+	 * The view need no terminating zero, so substr() is free and
+	 * no function scans for the end of the string.
+	 * The hash is the same as of basic_string and basic_fixed_string with the same chars.
+	 *
+	 * @tparam TChar The type of the chars.
+	 */
+	template <typename TChar = char>
+	class basic_string_view {
+	public:
+		using value_type = TChar;
+		using size_type = squads::size_t;
+		using difference_type = squads::ptrdiff_t;
+		using const_pointer = const TChar*;
+		using iterator = const TChar*;
+		using const_iterator = const TChar*;
+		using self_type = basic_string_view<TChar>;
+
+		static constexpr size_type npos = static_cast<size_type>(-1);
+
+		constexpr basic_string_view() noexcept : m_pData(nullptr), m_sLength(0) { }
+		constexpr basic_string_view(const_pointer str, size_type length) noexcept
+			: m_pData(str), m_sLength(length) { }
+		/**
+		 * @brief Construct from a zero terminated string, scan it once for the length.
+		 */
+		constexpr basic_string_view(const_pointer str) noexcept
+			: m_pData(str), m_sLength(str == nullptr ? 0 : internal::string_length(str)) { }
+
+		constexpr const_pointer data() const noexcept 	{ return m_pData; }
+		constexpr size_type size() const noexcept 		{ return m_sLength; }
+		constexpr size_type length() const noexcept 	{ return m_sLength; }
+		constexpr bool empty() const noexcept 			{ return m_sLength == 0; }
+
+		constexpr const_iterator begin() const noexcept { return m_pData; }
+		constexpr const_iterator end() const noexcept 	{ return m_pData + m_sLength; }
+
+		constexpr TChar operator[](size_type pos) const noexcept { return m_pData[pos]; }
+		constexpr TChar front() const noexcept 	{ return m_pData[0]; }
+		constexpr TChar back() const noexcept 	{ return m_pData[m_sLength - 1]; }
+
+		constexpr void remove_prefix(size_type count) noexcept { m_pData += count; m_sLength -= count; }
+		constexpr void remove_suffix(size_type count) noexcept { m_sLength -= count; }
+
+		/**
+		 * @brief Get count chars from pos, both are clamped to the view.
+		 */
+		constexpr self_type substr(size_type pos, size_type count = npos) const noexcept {
+			return (pos >= m_sLength) ? self_type(m_pData + m_sLength, size_type(0))
+				: self_type(m_pData + pos, (count < m_sLength - pos) ? count : m_sLength - pos);
+		}
+
+		/**
+		 * @brief Find the first ch at or after pos.
+		 * @return The position or npos when not found.
+		 */
+		constexpr size_type find(TChar ch, size_type pos = 0) const noexcept {
+			for(; pos < m_sLength; ++pos) {
+				if(m_pData[pos] == ch) return pos;
+			}
+			return npos;
+		}
+
+		/**
+		 * @brief Find the first occurrence of str at or after pos.
+		 * @return The position or npos when not found.
+		 */
+		size_type find(const self_type& str, size_type pos = 0) const noexcept {
+			if(str.m_sLength == 0) return (pos <= m_sLength) ? pos : npos;
+			if(str.m_sLength > m_sLength) return npos;
+
+			for(size_type _last = m_sLength - str.m_sLength; pos <= _last; ++pos) {
+				pos = find(str.m_pData[0], pos);
+				if(pos == npos || pos > _last) return npos;
+				if(internal::string_compare_n(m_pData + pos, str.m_pData, str.m_sLength) == 0) return pos;
+			}
+			return npos;
+		}
+
+		/**
+		 * @brief Find the last ch.
+		 * @return The position or npos when not found.
+		 */
+		constexpr size_type rfind(TChar ch) const noexcept {
+			for(size_type i = m_sLength; i > 0; --i) {
+				if(m_pData[i - 1] == ch) return i - 1;
+			}
+			return npos;
+		}
+
+		bool starts_with(const self_type& str) const noexcept {
+			return str.m_sLength <= m_sLength
+				&& internal::string_compare_n(m_pData, str.m_pData, str.m_sLength) == 0;
+		}
+		bool ends_with(const self_type& str) const noexcept {
+			return str.m_sLength <= m_sLength
+				&& internal::string_compare_n(m_pData + (m_sLength - str.m_sLength), str.m_pData, str.m_sLength) == 0;
+		}
+
+		/**
+		 * @brief Compare with a other view.
+		 * @return Less then 0, 0 or greater then 0, like memcmp.
+		 */
+		int compare(const self_type& str) const noexcept {
+			size_type _length = m_sLength < str.m_sLength ? m_sLength : str.m_sLength;
+			int _ret = internal::string_compare_n(m_pData, str.m_pData, _length);
+			if(_ret != 0) return _ret;
+			return (m_sLength < str.m_sLength) ? -1 : (m_sLength > str.m_sLength ? 1 : 0);
+		}
+
+		/**
+		 * @brief Get the hash of the chars.
+		 */
+		result_type hash() const noexcept {
+			return internal::string_hash(m_pData, m_sLength * sizeof(TChar));
+		}
+
+		bool operator == (const self_type& rhs) const noexcept {
+			return m_sLength == rhs.m_sLength
+				&& internal::string_compare_n(m_pData, rhs.m_pData, m_sLength) == 0;
+		}
+		bool operator != (const self_type& rhs) const noexcept 	{ return !(*this == rhs); }
+		bool operator < (const self_type& rhs) const noexcept 	{ return compare(rhs) < 0; }
+		bool operator > (const self_type& rhs) const noexcept 	{ return compare(rhs) > 0; }
+		bool operator <= (const self_type& rhs) const noexcept 	{ return compare(rhs) <= 0; }
+		bool operator >= (const self_type& rhs) const noexcept 	{ return compare(rhs) >= 0; }
+	private:
+		const_pointer m_pData;
+		size_type m_sLength;
+	};
+
+	template <typename TChar>
+	struct hash< basic_string_view<TChar> > {
+		result_type operator()(const basic_string_view<TChar>& str) const noexcept {
+			return str.hash();
+		}
+	};
+
+	using string_view = basic_string_view<char>;
+}
+
+#endif // __SQUADS_STRING_VIEW_H__
@@ -0,0 +1,130 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_TOP_K_H__
+#define __SQUADS_TOP_K_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "sort.hpp"
+#include "utils.hpp"
+
+namespace squads {
+	namespace internal {
+		/// The order of the heap in basic_top_k, the root is the last kept element
+		template <class TCompare>
+		struct top_k_heap_compare {
+			TCompare Compare;
+
+			template <typename T>
+			bool operator()(const T& a, const T& b) const { return Compare(b, a); }
+		};
+	}
+
+	/**
+	 * @brief A streaming accumulator, that keeps the K greatest elements in the order of TCompare.
+	 *
+	 * The elements are kept in a bounded heap (up_heap / down_heap), the root is the
+	 * smallest kept element, so push() is O(1) for rejected elements and O(log K) else.
+	 * No memory is allocated.
+	 *
+	 * @tparam T The type of the elements.
+	 * @tparam K The number of kept elements.
+	 * @tparam TCompare The order of the elements, squads::less keeps the largest, squads::greater the smallest.
+	 *
+	 * @code
+	 * squads::top_k<int, 10> top;
+	 * for(int i = 0; i < count; i++) top.push(samples[i]);
+	 * int best[10];
+	 * squads::size_t n = top.copy_sorted(best);
+	 * @endcode
+	 */
+	template <typename T, size_t K, class TCompare = squads::less<T> >
+	class basic_top_k {
+		static_assert(K >= 1, "basic_top_k: K must be at least 1");
+		using heap_compare = internal::top_k_heap_compare<TCompare>;
+	public:
+		using value_type = T;
+		using size_type = squads::size_t;
+		using value_compare = TCompare;
+		using const_iterator = const T*;
+		using self_type = basic_top_k<T, K, TCompare>;
+
+		static constexpr size_type Capacity = K;
+
+		basic_top_k() : m_sSize(0), m_cCompare() { }
+
+		size_type size() const 		{ return m_sSize; }
+		bool empty() const 			{ return m_sSize == 0; }
+		bool full() const 			{ return m_sSize == Capacity; }
+		constexpr size_type capacity() const { return Capacity; }
+
+		/**
+		 * @brief The kept elements in heap order.
+		 */
+		const_iterator begin() const 	{ return m_aHeap; }
+		const_iterator end() const 		{ return m_aHeap + m_sSize; }
+
+		/**
+		 * @brief Get the smallest kept element, a new element must be after it to be kept.
+		 */
+		const value_type& threshold() const {
+			assert(!empty());
+			return m_aHeap[0];
+		}
+
+		/**
+		 * @brief Add a element, it is kept when the accumulator is not full or it is after threshold().
+		 * @return True when the element is kept.
+		 */
+		bool push(const value_type& value) {
+			if (m_sSize < Capacity) {
+				m_aHeap[m_sSize++] = value;
+				internal::up_heap(m_aHeap, m_sSize, m_cCompare);
+				return true;
+			}
+			if (!m_cCompare.Compare(m_aHeap[0], value)) return false;
+
+			m_aHeap[0] = value;
+			internal::down_heap(m_aHeap, 1, m_sSize, m_cCompare);
+			return true;
+		}
+
+		/**
+		 * @brief Copy the kept elements, the greatest first.
+		 * @return The number of copied elements.
+		 */
+		size_type copy_sorted(value_type* out) const {
+			for (size_type i = 0; i < m_sSize; i++) out[i] = m_aHeap[i];
+			squads::sort(out, out + m_sSize, m_cCompare);
+			return m_sSize;
+		}
+
+		void clear() { m_sSize = 0; }
+	private:
+		value_type m_aHeap[K];
+		size_type m_sSize;
+		heap_compare m_cCompare;
+	};
+
+	template <typename T, size_t K, class TCompare = squads::less<T> >
+	using top_k = basic_top_k<T, K, TCompare>;
+}
+
+#endif // __SQUADS_TOP_K_H__
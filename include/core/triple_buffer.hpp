@@ -0,0 +1,147 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_TRIPLE_BUFFER_H__
+#define __SQUADS_TRIPLE_BUFFER_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "functional.hpp"
+#include "atomic/atomic.hpp"
+
+namespace squads {
+	/**
+	 * @brief A lock-free latest value mailbox for one writer and one reader.
+	 *
+	 * The writer owns the back buffer, the reader the front buffer and the third buffer is
+	 * in the middle. publish() swaps the back buffer with the middle, update() swaps the
+	 * middle with the front buffer, each with a single atomic exchange. So the writer has
+	 * always a free buffer, the reader gets always the newest complete value and no one blocks.
+	 * Values, that the reader has not picked up, are overwritten (latest value wins).
+	 *
+	 * @tparam T The type of the value.
+	 *
+	 * @code
+	 * squads::triple_buffer<sensor_data> mailbox;
+	 * // writer
+	 * mailbox.write(data);
+	 * // reader
+	 * if(mailbox.update()) control(mailbox.read());
+	 * @endcode
+	 *
+	 * @note Only one writer and one reader task.
+	 */
+	template <typename T>
+	class basic_triple_buffer {
+	public:
+		using value_type = T;
+		using reference = T&;
+		using const_reference = const T&;
+		using self_type = basic_triple_buffer<T>;
+	private:
+		/// The index of the middle buffer in the low bits and the flag for a new value
+		static constexpr unsigned int IndexMask = 0x3;
+		static constexpr unsigned int NewFlag = 0x4;
+	public:
+		basic_triple_buffer() : m_uBack(0), m_atomicMiddle(1), m_uFront(2), m_aBuffer() { }
+
+		/**
+		 * @brief Construct with all three buffers set to value.
+		 */
+		explicit basic_triple_buffer(const value_type& value)
+			: m_uBack(0), m_atomicMiddle(1), m_uFront(2), m_aBuffer{ value, value, value } { }
+
+		basic_triple_buffer(const self_type&) = delete;
+		self_type& operator = (const self_type&) = delete;
+
+		// Writer side
+
+		/**
+		 * @brief Get the back buffer, to write the next value in place before publish().
+		 */
+		reference write_buffer() { return m_aBuffer[m_uBack]; }
+
+		/**
+		 * @brief Make the back buffer the newest value and take the middle buffer as back buffer.
+		 */
+		void publish() {
+			unsigned int _old = m_atomicMiddle.exchange(m_uBack | NewFlag, atomic::memory_order::AcqRel);
+			m_uBack = _old & IndexMask;
+		}
+
+		/**
+		 * @brief Write a value and publish it.
+		 */
+		void write(const value_type& value) {
+			m_aBuffer[m_uBack] = value;
+			publish();
+		}
+		void write(value_type&& value) {
+			m_aBuffer[m_uBack] = squads::move(value);
+			publish();
+		}
+
+		// Reader side
+
+		/**
+		 * @brief Is a newer value published, as the value in the front buffer.
+		 */
+		bool has_new() const {
+			return (m_atomicMiddle.load(atomic::memory_order::Relaxed) & NewFlag) != 0;
+		}
+
+		/**
+		 * @brief Take the newest value as front buffer, when one is published.
+		 * @return True when the front buffer has changed.
+		 */
+		bool update() {
+			if(!has_new()) return false;
+
+			unsigned int _old = m_atomicMiddle.exchange(m_uFront, atomic::memory_order::AcqRel);
+			m_uFront = _old & IndexMask;
+			return true;
+		}
+
+		/**
+		 * @brief Get the front buffer, it is only changed by update().
+		 */
+		const_reference read() const { return m_aBuffer[m_uFront]; }
+
+		/**
+		 * @brief Update and copy the newest value.
+		 * @return True when the value is new since the last read.
+		 */
+		bool read(value_type& value) {
+			bool _new = update();
+			value = m_aBuffer[m_uFront];
+			return _new;
+		}
+	private:
+		/// Owned by the writer
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) unsigned int m_uBack;
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) atomic::_atomic<unsigned int> m_atomicMiddle;
+		/// Owned by the reader
+		alignas(SQUADS_CONFIG_CACHE_LINE_SIZE) unsigned int m_uFront;
+		value_type m_aBuffer[3];
+	};
+
+	template <typename T>
+	using triple_buffer = basic_triple_buffer<T>;
+}
+
+#endif // __SQUADS_TRIPLE_BUFFER_H__
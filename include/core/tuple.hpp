@@ -0,0 +1,165 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#ifndef __SQUADS_TUPLE_H__
+#define __SQUADS_TUPLE_H__
+
+#include "config.hpp"
+#include "defines.hpp"
+
+#include "algorithm.hpp"
+#include "ebo_storage.hpp"
+#include "functional.hpp"
+
+#include <utility>
+
+namespace squads {
+	namespace internal {
+		template <size_t... I>
+		struct tuple_indices { };
+
+		template <size_t N, size_t... I>
+		struct make_tuple_indices : make_tuple_indices<N - 1, N - 1, I...> { };
+		template <size_t... I>
+		struct make_tuple_indices<0, I...> { using type = tuple_indices<I...>; };
+
+		/// The type of the I-th element
+		template <size_t I, typename... Ts>
+		struct tuple_type_at;
+		template <size_t I, typename T, typename... Ts>
+		struct tuple_type_at<I, T, Ts...> : tuple_type_at<I - 1, Ts...> { };
+		template <typename T, typename... Ts>
+		struct tuple_type_at<0, T, Ts...> { using type = T; };
+
+		/// Is the only argument the tuple self, then it is a copy and not a element
+		template <class TSelf, typename... Us>
+		struct tuple_is_self : false_type { };
+		template <class TSelf, typename U>
+		struct tuple_is_self<TSelf, U> : is_same<type_t<remove_cvref<U>>, TSelf> { };
+
+		/// All elements as ebo_storage base, tagged with the index
+		template <class TIndices, typename... Ts>
+		struct tuple_impl;
+
+		template <size_t... I, typename... Ts>
+		struct tuple_impl<tuple_indices<I...>, Ts...> : ebo_storage<Ts, int(I)>... {
+			constexpr tuple_impl() : ebo_storage<Ts, int(I)>()... { }
+
+			template <typename... Us>
+			constexpr explicit tuple_impl(int, Us&&... values)
+				: ebo_storage<Ts, int(I)>(squads::forward<Us>(values))... { }
+		};
+	}
+
+	/**
+	 * @brief A tuple, that use no space for empty elements.
+	 *
+	 * Each element is stored as ebo_storage base, so empty elements like allocators,
+	 * comparators or deleters cost no byte. Supports get<I> and structured bindings.
+	 *
+	 * @tparam Ts The types of the elements.
+	 */
+	template <typename... Ts>
+	class basic_tuple : private internal::tuple_impl<typename internal::make_tuple_indices<sizeof...(Ts)>::type, Ts...> {
+		using base_type = internal::tuple_impl<typename internal::make_tuple_indices<sizeof...(Ts)>::type, Ts...>;
+	public:
+		using self_type = basic_tuple<Ts...>;
+
+		template <size_t I>
+		using element_type = typename internal::tuple_type_at<I, Ts...>::type;
+
+		static constexpr size_t Size = sizeof...(Ts);
+
+		constexpr basic_tuple() : base_type() { }
+
+		template <typename... Us, typename = squads::enable_if_t<sizeof...(Us) == sizeof...(Ts) &&
+			sizeof...(Us) != 0 && !internal::tuple_is_self<self_type, Us...>::value> >
+		constexpr basic_tuple(Us&&... values) : base_type(0, squads::forward<Us>(values)...) { }
+
+		basic_tuple(const self_type& other) = default;
+		basic_tuple(self_type&& other) = default;
+		self_type& operator = (const self_type& other) = default;
+		self_type& operator = (self_type&& other) = default;
+
+		/**
+		 * @brief Get the I-th element.
+		 */
+		template <size_t I>
+		element_type<I>& get() noexcept {
+			return static_cast<ebo_storage<element_type<I>, int(I)>&>(*this).get();
+		}
+		template <size_t I>
+		const element_type<I>& get() const noexcept {
+			return static_cast<const ebo_storage<element_type<I>, int(I)>&>(*this).get();
+		}
+
+		void swap(self_type& other) { swap_from<0>(other); }
+
+		bool operator == (const self_type& rhs) const { return equal_from<0>(rhs); }
+		bool operator != (const self_type& rhs) const { return !(*this == rhs); }
+	private:
+		template <size_t I>
+		squads::enable_if_t<(I < Size)> swap_from(self_type& other) {
+			squads::swap(get<I>(), other.template get<I>());
+			swap_from<I + 1>(other);
+		}
+		template <size_t I>
+		squads::enable_if_t<(I >= Size)> swap_from(self_type&) { }
+
+		template <size_t I>
+		squads::enable_if_t<(I < Size), bool> equal_from(const self_type& rhs) const {
+			return get<I>() == rhs.template get<I>() && equal_from<I + 1>(rhs);
+		}
+		template <size_t I>
+		squads::enable_if_t<(I >= Size), bool> equal_from(const self_type&) const { return true; }
+	};
+
+	template <size_t I, typename... Ts>
+	typename basic_tuple<Ts...>::template element_type<I>& get(basic_tuple<Ts...>& tuple) noexcept {
+		return tuple.template get<I>();
+	}
+	template <size_t I, typename... Ts>
+	const typename basic_tuple<Ts...>::template element_type<I>& get(const basic_tuple<Ts...>& tuple) noexcept {
+		return tuple.template get<I>();
+	}
+	template <size_t I, typename... Ts>
+	typename basic_tuple<Ts...>::template element_type<I>&& get(basic_tuple<Ts...>&& tuple) noexcept {
+		return squads::move(tuple.template get<I>());
+	}
+
+	template <typename... Ts>
+	basic_tuple<Ts...> make_tuple(const Ts&... values) {
+		return basic_tuple<Ts...>(values...);
+	}
+
+	template <typename... Ts>
+	using tuple = basic_tuple<Ts...>;
+}
+
+namespace std {
+	/// Structured bindings for squads::basic_tuple
+	template <typename... Ts>
+	struct tuple_size< squads::basic_tuple<Ts...> >
+		: std::integral_constant<std::size_t, sizeof...(Ts)> { };
+
+	template <std::size_t I, typename... Ts>
+	struct tuple_element<I, squads::basic_tuple<Ts...> > {
+		using type = typename squads::internal::tuple_type_at<I, Ts...>::type;
+	};
+}
+
+#endif // __SQUADS_TUPLE_H__
@@ -143,6 +143,10 @@ namespace squads {
 	template<typename T>
 	struct is_empty : public integral_constant<bool, __is_empty(T)> { };
 
+	/// is_final
+	template<typename T>
+	struct is_final : public integral_constant<bool, __is_final(T)> { };
+
 
     template<typename T>
     struct is_enum : public integral_constant<bool, __is_enum(T)> { };
@@ -374,7 +378,7 @@ namespace squads {
 	/// is_arithmetic
 	template<typename T>
 	struct is_arithmetic
-		: public integral_constant< bool, !(is_integral<T>::value | is_floating_point<T>::value) > { };
+		: public integral_constant< bool, is_integral<T>::value | is_floating_point<T>::value > { };
 
 	/// is_object
 	template<typename T>
@@ -492,6 +496,7 @@ namespace squads {
     struct is_void<T> : public integral_constant<bool, true> { };
 
 	MN_INTEGRAL(char);
+	MN_INTEGRAL(signed char);
 	MN_INTEGRAL(unsigned char);
 	MN_INTEGRAL(short);
 	MN_INTEGRAL(unsigned short);
@@ -499,7 +504,11 @@ namespace squads {
 	MN_INTEGRAL(unsigned int);
 	MN_INTEGRAL(long);
 	MN_INTEGRAL(unsigned long);
+	MN_INTEGRAL(long long);
+	MN_INTEGRAL(unsigned long long);
 	MN_INTEGRAL(wchar_t);
+	MN_INTEGRAL(char16_t);
+	MN_INTEGRAL(char32_t);
     MN_INTEGRAL(bool);
 
     MN_VOIDTYPE(void);
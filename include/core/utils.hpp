@@ -289,6 +289,29 @@ namespace squads {
 	inline size_t nlz(uint64_t x) {
 		return nlz_base(x) - 1;
 	}
+
+	/**
+	 * @brief Count the trailing zero bits of a value.
+	 * @note The result is undefined for x == 0.
+	 * @return The index of the lowest set bit.
+	 */
+	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
+	inline size_t ctz(T x) {
+		return (sizeof(T) <= sizeof(unsigned int)) ? __builtin_ctz(static_cast<unsigned int>(x))
+												   : __builtin_ctzll(static_cast<unsigned long long>(x));
+	}
+
+	/**
+	 * @brief Count the leading zero bits of a value in the width of T.
+	 * @note The result is undefined for x == 0.
+	 * @return The number of zero bits above the highest set bit.
+	 */
+	SQUADS_TEMPLATE_FULL_DECL_ONE(typename, T)
+	inline size_t clz(T x) {
+		return (sizeof(T) <= sizeof(unsigned int))
+			? __builtin_clz(static_cast<unsigned int>(x)) - (sizeof(unsigned int) - sizeof(T)) * CHAR_BIT
+			: __builtin_clzll(static_cast<unsigned long long>(x)) - (sizeof(unsigned long long) - sizeof(T)) * CHAR_BIT;
+	}
 }
 
 #endif
@@ -23,6 +23,8 @@
 #include "core/functional.hpp"
 #include "core/alignment.hpp"
 #include "core/utils.hpp"
+#include "core/algorithm.hpp"
+#include "core/ebo_storage.hpp"
 
 #include "basic_allocator_sized_filter.hpp"
 
@@ -43,9 +45,11 @@ namespace squads {
 
         /**
 		 * The basic allocater for all allocator impl in this library.
+		 * A empty filter is stored as ebo_storage base, so the allocator itself is empty.
 		 */
 		template <class TAllocator, class TFilter = basic_allocator_filter>
-		class basic_storage {
+		class basic_storage : private ebo_storage<TFilter> {
+			using filter_base = ebo_storage<TFilter>;
 		public:
 			using allocator_category = typename TAllocator::allocator_category ;
 			using is_thread_safe = typename TAllocator::is_thread_safe ;
@@ -69,9 +73,9 @@ namespace squads {
 			pointer allocate(size_t size, size_t alignment) {
 				pointer _mem = nullptr;
 
-				if(m_fFilter.on_pre_alloc(size, alignment )) {
+				if(filter_base::get().on_pre_alloc(size, alignment )) {
 					_mem = TAllocator::allocate(size, alignment);
-					m_fFilter.on_alloc(size, alignment);
+					filter_base::get().on_alloc(size, alignment);
 				}
 				return _mem;
 			}
@@ -94,7 +98,7 @@ namespace squads {
 			 * @param alignment
 			 * @return Pointer to new memory, or NULL if allocation fails.
 			 */
-			pointer allocate(size_t count, size_t size, size_t alignment = 0) {
+			pointer allocate(size_t count, size_t size, size_t alignment) {
 				return allocate(count * size, (alignment == 0) ? squads::alignment_for(size) : alignment);
 			}
 
@@ -106,9 +110,9 @@ namespace squads {
 			 * @param size The size of the Type
 			 */
 			void deallocate(pointer address, size_t size, size_t alignment) noexcept {
-				if(m_fFilter.on_pre_dealloc(size, alignment)) {
+				if(filter_base::get().on_pre_dealloc(size, alignment)) {
 					TAllocator::deallocate(address, size, alignment);
-					m_fFilter.on_dealloc(size, alignment);
+					filter_base::get().on_dealloc(size, alignment);
 				}
 			}
 
@@ -130,9 +134,9 @@ namespace squads {
 			 */
 			void deallocate(pointer address, size_t count, size_t size, size_t alignment) noexcept {
 				size = size * count;
-				if(m_fFilter.on_pre_dealloc(size, alignment)) {
+				if(filter_base::get().on_pre_dealloc(size, alignment)) {
 					TAllocator::deallocate(address, size, (alignment == 0) ? squads::alignment_for(size) : alignment);
-					m_fFilter.on_dealloc(size, alignment);
+					filter_base::get().on_dealloc(size, alignment);
 				}
 			}
 
@@ -172,9 +176,6 @@ namespace squads {
 			size_t get_max_alocator_size() const noexcept {
 				return TAllocator::get_max_alocator_size();
 			}
-
-		private:
-			filter_type m_fFilter;
 		};
 
     }
@@ -0,0 +1,103 @@
+#include "config.hpp"
+
+#if SQUADS_CONFIG_ARCH_FREERTOS == 1 && SQUADS_CONFIG_ARCH_PTHREAD != 1
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+
+#include <stdlib.h>
+
+#include "arch/arch_thread.hpp"
+
+SQUADS_EXTERNC_BEGINN
+
+namespace squads {
+    namespace arch {
+
+        typedef struct thread_handle {
+            TaskHandle_t handle;
+            SemaphoreHandle_t done;
+            arch_thread_fn fn;
+            void* arg;
+        } thread_handle_t;
+
+        static void arch_thread_entry(void* param) {
+            thread_handle_t* thread = (thread_handle_t*)param;
+
+            thread->fn(thread->arg);
+            xSemaphoreGive(thread->done);
+            vTaskDelete(NULL);
+        }
+
+        thread_handle_t* arch_thread_start(arch_thread_fn fn, void* arg, int core, unsigned int stack) {
+            thread_handle_t* thread = (thread_handle_t*)malloc(sizeof(thread_handle_t));
+            if(thread == NULL) return NULL;
+
+            thread->fn = fn;
+            thread->arg = arg;
+            thread->done = xSemaphoreCreateBinary();
+            if(thread->done == NULL) {
+                free(thread);
+                return NULL;
+            }
+
+            BaseType_t ret = xTaskCreatePinnedToCore(arch_thread_entry, "squads_worker", stack, thread,
+                uxTaskPriorityGet(NULL), &thread->handle,
+                (core == SQUADS_ARCH_THREAD_ANY_CORE) ? tskNO_AFFINITY : core);
+
+            if(ret != pdPASS) {
+                vSemaphoreDelete(thread->done);
+                free(thread);
+                return NULL;
+            }
+            return thread;
+        }
+
+        int arch_thread_join(thread_handle_t* thread) {
+            if(thread == NULL) return 1;
+
+            xSemaphoreTake(thread->done, portMAX_DELAY);
+            vSemaphoreDelete(thread->done);
+            free(thread);
+            return 0;
+        }
+
+        unsigned int arch_thread_cores() {
+            return portNUM_PROCESSORS;
+        }
+
+        typedef struct thread_signal {
+            SemaphoreHandle_t sem;
+        } thread_signal_t;
+
+        thread_signal_t* arch_signal_create() {
+            thread_signal_t* signal = (thread_signal_t*)malloc(sizeof(thread_signal_t));
+            if(signal == NULL) return NULL;
+
+            signal->sem = xSemaphoreCreateBinary();
+            if(signal->sem == NULL) {
+                free(signal);
+                return NULL;
+            }
+            return signal;
+        }
+
+        void arch_signal_give(thread_signal_t* signal) {
+            xSemaphoreGive(signal->sem);
+        }
+
+        void arch_signal_take(thread_signal_t* signal) {
+            xSemaphoreTake(signal->sem, portMAX_DELAY);
+        }
+
+        void arch_signal_destroy(thread_signal_t* signal) {
+            if(signal == NULL) return;
+            vSemaphoreDelete(signal->sem);
+            free(signal);
+        }
+    }
+}
+
+SQUADS_EXTERNC_END
+
+#endif
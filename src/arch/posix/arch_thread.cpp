@@ -0,0 +1,119 @@
+#include "config.hpp"
+
+#if SQUADS_CONFIG_ARCH_PTHREAD == 1
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE
+#endif
+#include <pthread.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <limits.h>
+
+#include "arch/arch_thread.hpp"
+
+SQUADS_EXTERNC_BEGINN
+
+namespace squads {
+    namespace arch {
+
+        typedef struct thread_handle {
+            pthread_t handle;
+            arch_thread_fn fn;
+            void* arg;
+        } thread_handle_t;
+
+        static void* arch_thread_entry(void* param) {
+            thread_handle_t* thread = (thread_handle_t*)param;
+
+            thread->fn(thread->arg);
+            return NULL;
+        }
+
+        thread_handle_t* arch_thread_start(arch_thread_fn fn, void* arg, int core, unsigned int stack) {
+            thread_handle_t* thread = (thread_handle_t*)malloc(sizeof(thread_handle_t));
+            if(thread == NULL) return NULL;
+
+            thread->fn = fn;
+            thread->arg = arg;
+
+            pthread_attr_t attr;
+            pthread_attr_init(&attr);
+#ifdef PTHREAD_STACK_MIN
+            if(stack < PTHREAD_STACK_MIN) stack = PTHREAD_STACK_MIN;
+#endif
+            pthread_attr_setstacksize(&attr, stack);
+
+#if defined(__linux__)
+            if(core != SQUADS_ARCH_THREAD_ANY_CORE) {
+                cpu_set_t cpus;
+                CPU_ZERO(&cpus);
+                CPU_SET(core, &cpus);
+                pthread_attr_setaffinity_np(&attr, sizeof(cpus), &cpus);
+            }
+#endif
+            int ret = pthread_create(&thread->handle, &attr, arch_thread_entry, thread);
+            pthread_attr_destroy(&attr);
+
+            if(ret != 0) {
+                free(thread);
+                return NULL;
+            }
+            return thread;
+        }
+
+        int arch_thread_join(thread_handle_t* thread) {
+            if(thread == NULL) return 1;
+
+            int ret = pthread_join(thread->handle, NULL);
+            free(thread);
+            return ret;
+        }
+
+        unsigned int arch_thread_cores() {
+            long cores = sysconf(_SC_NPROCESSORS_ONLN);
+            return (cores > 0) ? (unsigned int)cores : 1;
+        }
+
+        typedef struct thread_signal {
+            pthread_mutex_t mutex;
+            pthread_cond_t cond;
+            int set;
+        } thread_signal_t;
+
+        thread_signal_t* arch_signal_create() {
+            thread_signal_t* signal = (thread_signal_t*)malloc(sizeof(thread_signal_t));
+            if(signal == NULL) return NULL;
+
+            pthread_mutex_init(&signal->mutex, NULL);
+            pthread_cond_init(&signal->cond, NULL);
+            signal->set = 0;
+            return signal;
+        }
+
+        void arch_signal_give(thread_signal_t* signal) {
+            pthread_mutex_lock(&signal->mutex);
+            signal->set = 1;
+            pthread_cond_signal(&signal->cond);
+            pthread_mutex_unlock(&signal->mutex);
+        }
+
+        void arch_signal_take(thread_signal_t* signal) {
+            pthread_mutex_lock(&signal->mutex);
+            while(!signal->set) pthread_cond_wait(&signal->cond, &signal->mutex);
+            signal->set = 0;
+            pthread_mutex_unlock(&signal->mutex);
+        }
+
+        void arch_signal_destroy(thread_signal_t* signal) {
+            if(signal == NULL) return;
+            pthread_cond_destroy(&signal->cond);
+            pthread_mutex_destroy(&signal->mutex);
+            free(signal);
+        }
+    }
+}
+
+SQUADS_EXTERNC_END
+
+#endif
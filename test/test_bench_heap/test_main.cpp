@@ -0,0 +1,141 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+#include <stdio.h>
+
+#include "core/sort.hpp"
+#include "core/d_ary_heap.hpp"
+#include "core/pairing_heap.hpp"
+#include "core/random.hpp"
+#include "arch/arch_utils.hpp"
+
+// Benchmark of the priority queues against the binary heap of heap_sort:
+// each sorts the same random values, by push all and pop all.
+static const unsigned int ValueCount = 2000;
+static const int Rounds = 10;
+/// The fixed seed, so each run sorts the same values
+static const unsigned int BenchSeed = 2463534242u;
+
+static int g_aInput[ValueCount];
+static int g_aOutput[ValueCount];
+static long g_lInputSum;
+
+static void bench_report(const char* name, unsigned long micros) {
+	printf("bench_heap: %-18s %8lu us for %d x %u values\n", name, micros, Rounds, ValueCount);
+}
+
+void setUp() {
+	squads::random_xorshift _random(BenchSeed);
+	g_lInputSum = 0;
+	for(unsigned int i = 0; i < ValueCount; i++) {
+		g_aInput[i] = int(_random.rand32() % 100000u);
+		g_lInputSum += g_aInput[i];
+	}
+}
+void tearDown() { }
+
+static void check_output() {
+	long _sum = g_aOutput[0];
+	for(unsigned int i = 1; i < ValueCount; i++) {
+		TEST_ASSERT_TRUE(g_aOutput[i - 1] <= g_aOutput[i]);
+		_sum += g_aOutput[i];
+	}
+	TEST_ASSERT_TRUE(_sum == g_lInputSum);
+}
+
+static void test_bench_heap_sort() {
+	unsigned long _micros = 0;
+
+	for(int r = 0; r < Rounds; r++) {
+		for(unsigned int i = 0; i < ValueCount; i++) g_aOutput[i] = g_aInput[i];
+
+		unsigned long _start = squads::arch::arch_micros();
+		squads::heap_sort(g_aOutput, g_aOutput + ValueCount);
+		_micros += squads::arch::arch_micros() - _start;
+	}
+	check_output();
+	bench_report("heap_sort", _micros);
+}
+
+template <size_t D>
+static void bench_d_ary_heap(const char* name) {
+	squads::d_ary_heap<int, D> _heap;
+	unsigned long _micros = 0;
+	unsigned int _failed = 0;
+
+	TEST_ASSERT_TRUE(_heap.reserve(ValueCount));
+	for(int r = 0; r < Rounds; r++) {
+		unsigned long _start = squads::arch::arch_micros();
+		for(unsigned int i = 0; i < ValueCount; i++) _failed += _heap.push(g_aInput[i]) ? 0 : 1;
+		for(unsigned int i = 0; i < ValueCount; i++) _heap.pop(g_aOutput[i]);
+		_micros += squads::arch::arch_micros() - _start;
+	}
+	TEST_ASSERT_EQUAL_UINT(0, _failed);
+	TEST_ASSERT_TRUE(_heap.empty());
+	check_output();
+	bench_report(name, _micros);
+}
+
+static void test_bench_d_ary_heap_2() { bench_d_ary_heap<2>("d_ary_heap<2>"); }
+static void test_bench_d_ary_heap_4() { bench_d_ary_heap<4>("d_ary_heap<4>"); }
+static void test_bench_d_ary_heap_8() { bench_d_ary_heap<8>("d_ary_heap<8>"); }
+
+static void test_bench_d_ary_heap_assign() {
+	squads::d_ary_heap<int, 4> _heap;
+	unsigned long _micros = 0;
+	unsigned int _failed = 0;
+
+	for(int r = 0; r < Rounds; r++) {
+		unsigned long _start = squads::arch::arch_micros();
+		_failed += _heap.assign(g_aInput, ValueCount) ? 0 : 1;
+		for(unsigned int i = 0; i < ValueCount; i++) _heap.pop(g_aOutput[i]);
+		_micros += squads::arch::arch_micros() - _start;
+	}
+	TEST_ASSERT_EQUAL_UINT(0, _failed);
+	check_output();
+	bench_report("d_ary_heap assign", _micros);
+}
+
+static void test_bench_pairing_heap() {
+	squads::pairing_heap<int> _heap;
+	unsigned long _micros = 0;
+	unsigned int _failed = 0;
+
+	for(int r = 0; r < Rounds; r++) {
+		unsigned long _start = squads::arch::arch_micros();
+		for(unsigned int i = 0; i < ValueCount; i++) _failed += (_heap.push(g_aInput[i]) == nullptr) ? 1 : 0;
+		for(unsigned int i = 0; i < ValueCount; i++) _heap.pop(g_aOutput[i]);
+		_micros += squads::arch::arch_micros() - _start;
+	}
+	// Asserted after the timed loops, so all variants pay the same
+	TEST_ASSERT_EQUAL_UINT(0, _failed);
+	TEST_ASSERT_TRUE(_heap.empty());
+	check_output();
+	bench_report("pairing_heap", _micros);
+}
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_bench_heap_sort);
+	RUN_TEST(test_bench_d_ary_heap_2);
+	RUN_TEST(test_bench_d_ary_heap_4);
+	RUN_TEST(test_bench_d_ary_heap_8);
+	RUN_TEST(test_bench_d_ary_heap_assign);
+	RUN_TEST(test_bench_pairing_heap);
+	UNITY_END();
+}
@@ -0,0 +1,133 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+#include <stdio.h>
+
+#include "core/sort.hpp"
+#include "core/radix_sort.hpp"
+#include "core/random.hpp"
+#include "arch/arch_utils.hpp"
+
+// Benchmark of radix_sort against the introsort of squads::sort and heap_sort,
+// on the same random keys: 32 bit integers, floats and records with a timestamp key,
+// that has about four records per time.
+static const unsigned int ValueCount = 4000;
+static const int Rounds = 10;
+/// The fixed seed, so each run sorts the same values
+static const unsigned int BenchSeed = 2463534242u;
+
+struct bench_record {
+	uint32_t Time;
+	uint16_t Sensor;
+	uint16_t Value;
+};
+
+static uint32_t g_aInput[ValueCount];
+static uint32_t g_aKeys[ValueCount];
+static float g_aFloats[ValueCount];
+static bench_record g_aRecords[ValueCount];
+/// The failed radix sorts, asserted after the timed loops
+static unsigned int g_uFailed;
+
+static void bench_report(const char* name, unsigned long micros) {
+	printf("bench_radix_sort: %-22s %8lu us for %d x %u values\n", name, micros, Rounds, ValueCount);
+}
+
+struct record_time {
+	uint32_t operator () (const bench_record& record) const { return record.Time; }
+};
+struct record_less {
+	bool operator () (const bench_record& a, const bench_record& b) const { return a.Time < b.Time; }
+};
+
+void setUp() {
+	g_uFailed = 0;
+	squads::random_xorshift _random(BenchSeed);
+	for(unsigned int i = 0; i < ValueCount; i++) g_aInput[i] = _random.rand32();
+}
+void tearDown() { }
+
+static void fill_keys() {
+	for(unsigned int i = 0; i < ValueCount; i++) g_aKeys[i] = g_aInput[i];
+}
+static void fill_floats() {
+	for(unsigned int i = 0; i < ValueCount; i++) g_aFloats[i] = (float(g_aInput[i] % 200000u) - 100000.0f) * 0.125f;
+}
+static void fill_records() {
+	for(unsigned int i = 0; i < ValueCount; i++) {
+		g_aRecords[i].Time = g_aInput[i] % 1024u;
+		g_aRecords[i].Sensor = uint16_t(i);
+		g_aRecords[i].Value = uint16_t(g_aInput[i] >> 16);
+	}
+}
+
+template <typename T>
+static void check_sorted(const T* values) {
+	TEST_ASSERT_TRUE(squads::is_sorted(values, values + ValueCount, squads::less<T>()));
+}
+
+/// Each pass fills the input and sorts it, only the sort is timed
+template <class TFill, class TSort>
+static unsigned long bench_run(TFill fill, TSort sort) {
+	unsigned long _micros = 0;
+
+	for(int r = 0; r < Rounds; r++) {
+		fill();
+		unsigned long _start = squads::arch::arch_micros();
+		sort();
+		_micros += squads::arch::arch_micros() - _start;
+	}
+	TEST_ASSERT_EQUAL_UINT(0, g_uFailed);
+	return _micros;
+}
+
+static void test_bench_uint32() {
+	bench_report("sort uint32", bench_run(fill_keys, [] { squads::sort(g_aKeys, g_aKeys + ValueCount); }));
+	check_sorted(g_aKeys);
+	bench_report("heap_sort uint32", bench_run(fill_keys, [] { squads::heap_sort(g_aKeys, g_aKeys + ValueCount); }));
+	check_sorted(g_aKeys);
+	bench_report("radix_sort uint32", bench_run(fill_keys, [] { g_uFailed += squads::radix_sort(g_aKeys, g_aKeys + ValueCount) ? 0 : 1; }));
+	check_sorted(g_aKeys);
+}
+
+static void test_bench_float() {
+	bench_report("sort float", bench_run(fill_floats, [] { squads::sort(g_aFloats, g_aFloats + ValueCount); }));
+	check_sorted(g_aFloats);
+	bench_report("radix_sort float", bench_run(fill_floats, [] { g_uFailed += squads::radix_sort(g_aFloats, g_aFloats + ValueCount) ? 0 : 1; }));
+	check_sorted(g_aFloats);
+}
+
+static void test_bench_records() {
+	bench_report("sort records", bench_run(fill_records, [] { squads::sort(g_aRecords, g_aRecords + ValueCount, record_less()); }));
+	TEST_ASSERT_TRUE(squads::is_sorted(g_aRecords, g_aRecords + ValueCount, record_less()));
+	bench_report("radix_sort records", bench_run(fill_records, [] { g_uFailed += squads::radix_sort(g_aRecords, g_aRecords + ValueCount, record_time()) ? 0 : 1; }));
+	TEST_ASSERT_TRUE(squads::is_sorted(g_aRecords, g_aRecords + ValueCount, record_less()));
+
+	// radix_sort is stable: equal times keep the order of the sensors
+	for(unsigned int i = 1; i < ValueCount; i++) {
+		if(g_aRecords[i - 1].Time == g_aRecords[i].Time) TEST_ASSERT_TRUE(g_aRecords[i - 1].Sensor < g_aRecords[i].Sensor);
+	}
+}
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_bench_uint32);
+	RUN_TEST(test_bench_float);
+	RUN_TEST(test_bench_records);
+	UNITY_END();
+}
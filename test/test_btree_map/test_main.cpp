@@ -0,0 +1,75 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+
+#include "core/btree_map.hpp"
+
+struct test_key {
+	int Value;
+	bool operator < (const test_key& rhs) const { return Value < rhs.Value; }
+};
+
+// The in-node search must be the branchless one for arithmetic keys only
+static_assert(squads::btree_map<int, int>::BranchlessSearch, "int keys: branchless search");
+static_assert(squads::btree_map<unsigned char, int>::BranchlessSearch, "unsigned char keys: branchless search");
+static_assert(squads::btree_map<long long, int>::BranchlessSearch, "long long keys: branchless search");
+static_assert(squads::btree_map<double, int>::BranchlessSearch, "double keys: branchless search");
+static_assert(!squads::btree_map<test_key, int>::BranchlessSearch, "struct keys: binary search");
+static_assert(!squads::btree_map<const char*, int>::BranchlessSearch, "pointer keys: binary search");
+
+void setUp() { }
+void tearDown() { }
+
+template <typename TMap, typename TKey>
+static void check_map(TKey (*make)(int)) {
+	TMap _map;
+	const int Count = 2000;
+
+	for(int i = 0; i < Count; i++) {
+		int _v = (i * 7919) % Count;
+		TEST_ASSERT_TRUE(_map.insert(make(_v), _v).second());
+	}
+	TEST_ASSERT_EQUAL_UINT(Count, _map.size());
+
+	for(int i = 0; i < Count; i++) {
+		typename TMap::iterator _it = _map.find(make(i));
+		TEST_ASSERT_TRUE(_it != _map.end());
+		TEST_ASSERT_EQUAL_INT(i, _it->value);
+		TEST_ASSERT_TRUE(_map.lower_bound(make(i)) == _it);
+	}
+	TEST_ASSERT_TRUE(_map.find(make(Count)) == _map.end());
+
+	for(int i = 0; i < Count; i += 2) TEST_ASSERT_EQUAL_UINT(1, _map.erase(make(i)));
+	for(int i = 0; i < Count; i++) TEST_ASSERT_EQUAL(i % 2 == 1, _map.contains(make(i)));
+}
+
+static int make_int(int v) 				{ return v; }
+static double make_double(int v) 		{ return double(v) * 0.5; }
+static test_key make_test_key(int v) 	{ return test_key{v}; }
+
+static void test_branchless_int_keys() 		{ check_map<squads::btree_map<int, int> >(make_int); }
+static void test_branchless_double_keys() 	{ check_map<squads::btree_map<double, int> >(make_double); }
+static void test_binary_struct_keys() 		{ check_map<squads::btree_map<test_key, int> >(make_test_key); }
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_branchless_int_keys);
+	RUN_TEST(test_branchless_double_keys);
+	RUN_TEST(test_binary_struct_keys);
+	UNITY_END();
+}
@@ -0,0 +1,86 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+
+#include "core/pair.hpp"
+#include "core/hash_map.hpp"
+#include "core/flat_map.hpp"
+
+// A pair with the same types for key and value must compile, the single value
+// constructors of basic_pair had the same signature then.
+template class squads::basic_pair<int, int>;
+
+void setUp() { }
+void tearDown() { }
+
+static void test_pair_same_types() {
+	squads::pair<int, int> _pair(1, 2);
+	squads::pair<int, int> _first(3);
+	squads::pair<int, long> _second(4L);
+
+	TEST_ASSERT_EQUAL_INT(1, _pair.first());
+	TEST_ASSERT_EQUAL_INT(2, _pair.second());
+	TEST_ASSERT_EQUAL_INT(3, _first.first());
+	TEST_ASSERT_EQUAL_INT(4, _second.second());
+}
+
+static void test_hash_map_same_types() {
+	squads::hash_map<int, int> _map;
+
+	for(int i = 0; i < 100; i++) TEST_ASSERT_TRUE(_map.insert(i, i * 2).second());
+	TEST_ASSERT_FALSE(_map.insert(5, 0).second());
+	TEST_ASSERT_EQUAL_UINT(100, _map.size());
+
+	for(int i = 0; i < 100; i++) {
+		squads::hash_map<int, int>::iterator _it = _map.find(i);
+		TEST_ASSERT_TRUE(_it != _map.end());
+		TEST_ASSERT_EQUAL_INT(i * 2, _it->second());
+	}
+	squads::hash_map<int, int> _copy(_map);
+	TEST_ASSERT_EQUAL_UINT(100, _copy.size());
+	TEST_ASSERT_EQUAL_UINT(1, _copy.erase(7));
+	TEST_ASSERT_FALSE(_copy.contains(7));
+	TEST_ASSERT_TRUE(_map.contains(7));
+}
+
+static void test_flat_map_same_types() {
+	squads::pair<int, int> _aPairs[] = {
+		squads::pair<int, int>(3, 30), squads::pair<int, int>(1, 10),
+		squads::pair<int, int>(2, 20), squads::pair<int, int>(1, 11)
+	};
+	squads::flat_map<int, int> _map(_aPairs, _aPairs + 4);
+
+	TEST_ASSERT_EQUAL_UINT(3, _map.size());
+	TEST_ASSERT_EQUAL_INT(10, _map.find(1)->value);
+	TEST_ASSERT_EQUAL_INT(20, _map.find(2)->value);
+	TEST_ASSERT_EQUAL_INT(30, _map.find(3)->value);
+
+	TEST_ASSERT_TRUE(_map.assign(_aPairs, _aPairs + 2));
+	TEST_ASSERT_EQUAL_UINT(2, _map.size());
+	TEST_ASSERT_FALSE(_map.contains(2));
+	TEST_ASSERT_TRUE(_map.insert(2, 22).second());
+	TEST_ASSERT_EQUAL_INT(22, _map[2]);
+}
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_pair_same_types);
+	RUN_TEST(test_hash_map_same_types);
+	RUN_TEST(test_flat_map_same_types);
+	UNITY_END();
+}
@@ -0,0 +1,140 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+
+#include "core/lockfree_stack.hpp"
+#include "atomic/atomic.hpp"
+#include "arch/arch_thread.hpp"
+
+static const int TaskCount = 4;
+static const int TaskStack = 4096;
+
+// ABA: few nodes and many tasks, each task pops two tokens and pushes them back in the same order,
+// so the head is often the same node with a other next.
+static const unsigned int TokenCount = 4;
+static const int AbaRounds = 20000;
+
+static squads::lockfree_stack<unsigned int, TokenCount>* g_pTokens;
+/// One bit for each token, that a task holds
+static squads::atomic::atomic_uint g_atomicOwned(0);
+static squads::atomic::atomic_uint g_atomicErrors(0);
+
+// Multi producer: each task pushes his own values, until the stack is full.
+static const unsigned int ValueCount = 2000;
+
+static squads::lockfree_stack<unsigned int, ValueCount>* g_pValues;
+static squads::atomic::atomic_uint g_atomicNextTask(0);
+
+void setUp() {
+	g_atomicOwned.store(0);
+	g_atomicErrors.store(0);
+	g_atomicNextTask.store(0);
+}
+void tearDown() { }
+
+static bool take_token(unsigned int token) {
+	if(token >= TokenCount) return false;
+	return (g_atomicOwned.fetch_or(1u << token) & (1u << token)) == 0;
+}
+static bool give_token(unsigned int token) {
+	g_atomicOwned.fetch_and(~(1u << token));
+	return g_pTokens->push(token);
+}
+
+static void aba_task(void*) {
+	unsigned int _first, _second;
+
+	for(int i = 0; i < AbaRounds; i++) {
+		if(!g_pTokens->pop(_first)) continue;
+		if(!take_token(_first)) g_atomicErrors.fetch_add(1);
+
+		bool _hasSecond = g_pTokens->pop(_second);
+		if(_hasSecond && !take_token(_second)) g_atomicErrors.fetch_add(1);
+
+		if(!give_token(_first)) g_atomicErrors.fetch_add(1);
+		if(_hasSecond && !give_token(_second)) g_atomicErrors.fetch_add(1);
+	}
+}
+
+static void producer_task(void*) {
+	unsigned int _task = g_atomicNextTask.fetch_add(1);
+	unsigned int _count = ValueCount / TaskCount;
+
+	for(unsigned int i = 0; i < _count; i++) {
+		if(!g_pValues->push(_task * _count + i)) g_atomicErrors.fetch_add(1);
+	}
+}
+
+static void run_tasks(squads::arch::arch_thread_fn fn) {
+	squads::arch::thread_handle_t* _aTasks[TaskCount];
+
+	for(int i = 0; i < TaskCount; i++) {
+		_aTasks[i] = squads::arch::arch_thread_start(fn, nullptr, SQUADS_ARCH_THREAD_ANY_CORE, TaskStack);
+		TEST_ASSERT_NOT_NULL(_aTasks[i]);
+	}
+	for(int i = 0; i < TaskCount; i++) TEST_ASSERT_EQUAL_INT(0, squads::arch::arch_thread_join(_aTasks[i]));
+}
+
+static void test_aba_stress() {
+	static squads::lockfree_stack<unsigned int, TokenCount> _stack;
+	g_pTokens = &_stack;
+
+	for(unsigned int i = 0; i < TokenCount; i++) TEST_ASSERT_TRUE(_stack.push(i));
+	TEST_ASSERT_FALSE(_stack.push(TokenCount));
+
+	run_tasks(aba_task);
+	TEST_ASSERT_EQUAL_UINT(0, g_atomicErrors.load());
+
+	// No token is lost or twice in the stack
+	unsigned int _token, _seen = 0;
+	for(unsigned int i = 0; i < TokenCount; i++) {
+		TEST_ASSERT_TRUE(_stack.pop(_token));
+		TEST_ASSERT_TRUE(_token < TokenCount);
+		TEST_ASSERT_EQUAL_UINT(0, _seen & (1u << _token));
+		_seen |= 1u << _token;
+	}
+	TEST_ASSERT_FALSE(_stack.pop(_token));
+	TEST_ASSERT_TRUE(_stack.empty());
+}
+
+static void test_multi_producer() {
+	static squads::lockfree_stack<unsigned int, ValueCount> _stack;
+	static bool _seen[ValueCount];
+	g_pValues = &_stack;
+
+	run_tasks(producer_task);
+	TEST_ASSERT_EQUAL_UINT(0, g_atomicErrors.load());
+	TEST_ASSERT_FALSE(_stack.push(ValueCount));
+
+	unsigned int _value;
+	for(unsigned int i = 0; i < ValueCount; i++) _seen[i] = false;
+	for(unsigned int i = 0; i < ValueCount; i++) {
+		TEST_ASSERT_TRUE(_stack.pop(_value));
+		TEST_ASSERT_TRUE(_value < ValueCount);
+		TEST_ASSERT_FALSE(_seen[_value]);
+		_seen[_value] = true;
+	}
+	TEST_ASSERT_TRUE(_stack.empty());
+}
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_aba_stress);
+	RUN_TEST(test_multi_producer);
+	UNITY_END();
+}
@@ -0,0 +1,122 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+
+#include "core/mpsc_queue.hpp"
+#include "atomic/atomic.hpp"
+#include "arch/arch_thread.hpp"
+
+static const unsigned int ProducerCount = 4;
+static const unsigned int ItemCount = 1000;
+static const int TaskStack = 4096;
+
+struct test_item {
+	squads::mpsc_queue_node Hook;
+	unsigned int Producer;
+	unsigned int Seq;
+};
+using test_queue = squads::mpsc_queue<test_item, &test_item::Hook>;
+
+static test_queue* g_pQueue;
+static test_item g_aItems[ProducerCount][ItemCount];
+static squads::atomic::atomic_uint g_atomicNextProducer(0);
+
+// Written by the consumer task only, read after the join
+static unsigned int g_uReceived;
+static unsigned int g_uErrors;
+
+void setUp() {
+	g_atomicNextProducer.store(0);
+	g_uReceived = 0;
+	g_uErrors = 0;
+}
+void tearDown() { }
+
+static void producer_task(void*) {
+	unsigned int _producer = g_atomicNextProducer.fetch_add(1);
+
+	for(unsigned int i = 0; i < ItemCount; i++) {
+		test_item& _item = g_aItems[_producer][i];
+		_item.Producer = _producer;
+		_item.Seq = i;
+		g_pQueue->push(_item);
+	}
+}
+
+static void consumer_task(void*) {
+	unsigned int _aNext[ProducerCount] = { 0 };
+
+	while(g_uReceived < ProducerCount * ItemCount) {
+		test_item* _pItem = g_pQueue->pop();
+		if(_pItem == nullptr) continue;
+
+		// Each item once and the items of one producer in his order
+		if(_pItem->Producer >= ProducerCount || _pItem->Seq != _aNext[_pItem->Producer]) g_uErrors++;
+		else _aNext[_pItem->Producer]++;
+		g_uReceived++;
+	}
+}
+
+static void test_mpsc_stress() {
+	static test_queue _queue;
+	squads::arch::thread_handle_t* _aTasks[ProducerCount + 1];
+	g_pQueue = &_queue;
+
+	TEST_ASSERT_TRUE(_queue.empty());
+	TEST_ASSERT_NULL(_queue.pop());
+
+	_aTasks[ProducerCount] = squads::arch::arch_thread_start(consumer_task, nullptr, SQUADS_ARCH_THREAD_ANY_CORE, TaskStack);
+	TEST_ASSERT_NOT_NULL(_aTasks[ProducerCount]);
+	for(unsigned int i = 0; i < ProducerCount; i++) {
+		_aTasks[i] = squads::arch::arch_thread_start(producer_task, nullptr, SQUADS_ARCH_THREAD_ANY_CORE, TaskStack);
+		TEST_ASSERT_NOT_NULL(_aTasks[i]);
+	}
+	for(unsigned int i = 0; i <= ProducerCount; i++) TEST_ASSERT_EQUAL_INT(0, squads::arch::arch_thread_join(_aTasks[i]));
+
+	TEST_ASSERT_EQUAL_UINT(ProducerCount * ItemCount, g_uReceived);
+	TEST_ASSERT_EQUAL_UINT(0, g_uErrors);
+	TEST_ASSERT_NULL(_queue.pop());
+	TEST_ASSERT_TRUE(_queue.empty());
+}
+
+static void test_mpsc_reuse() {
+	static test_queue _queue;
+	test_item _aItems[3];
+
+	// The stub is pushed again, when the last item is popped
+	for(int _round = 0; _round < 3; _round++) {
+		for(unsigned int i = 0; i < 3; i++) {
+			_aItems[i].Seq = i;
+			_queue.push(_aItems[i]);
+		}
+		for(unsigned int i = 0; i < 3; i++) {
+			test_item* _pItem = _queue.pop();
+			TEST_ASSERT_NOT_NULL(_pItem);
+			TEST_ASSERT_EQUAL_UINT(i, _pItem->Seq);
+		}
+		TEST_ASSERT_NULL(_queue.pop());
+		TEST_ASSERT_TRUE(_queue.empty());
+	}
+}
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_mpsc_reuse);
+	RUN_TEST(test_mpsc_stress);
+	UNITY_END();
+}
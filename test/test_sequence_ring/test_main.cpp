@@ -0,0 +1,150 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+
+#include "core/sequence_ring.hpp"
+#include "atomic/atomic.hpp"
+#include "arch/arch_utils.hpp"
+#include "arch/arch_thread.hpp"
+
+static const int TaskStack = 4096;
+/// The ticks the other task is given to block, before it is woken
+static const unsigned long BlockTicks = 20;
+
+using test_ring = squads::sequence_ring<int, 8, 2, squads::sequence_wait_block>;
+
+static test_ring* g_pRing;
+static squads::atomic::atomic_uint g_atomicStarted(0);
+static squads::atomic::atomic_uint g_atomicDone(0);
+static int g_iReceived;
+
+void setUp() {
+	g_atomicStarted.store(0);
+	g_atomicDone.store(0);
+	g_iReceived = 0;
+}
+void tearDown() { }
+
+static squads::arch::thread_handle_t* start_task(squads::arch::arch_thread_fn fn, void* arg) {
+	squads::arch::thread_handle_t* _pTask = squads::arch::arch_thread_start(fn, arg, SQUADS_ARCH_THREAD_ANY_CORE, TaskStack);
+	TEST_ASSERT_NOT_NULL(_pTask);
+	return _pTask;
+}
+
+/// Wait until the task has started and give it the time to block
+static void let_task_block() {
+	while(g_atomicStarted.load() == 0) squads::arch::arch_yield();
+	squads::arch::arch_delay(BlockTicks);
+}
+
+static void consumer_task(void*) {
+	g_atomicStarted.store(1);
+	test_ring::const_spans_type _spans = g_pRing->wait_for(0);
+	g_iReceived = _spans.first.data[0];
+	g_pRing->consume(0, 1);
+	g_atomicDone.store(1);
+}
+
+static void producer_task(void*) {
+	g_atomicStarted.store(1);
+	test_ring::spans_type _spans = g_pRing->claim(1);
+	_spans.first.data[0] = 9;
+	g_pRing->publish(1);
+	g_atomicDone.store(1);
+}
+
+static void test_consumer_woken_by_publish() {
+	static test_ring _ring;
+	g_pRing = &_ring;
+
+	squads::arch::thread_handle_t* _pTask = start_task(consumer_task, nullptr);
+	let_task_block();
+	TEST_ASSERT_EQUAL_UINT(0, g_atomicDone.load());
+
+	TEST_ASSERT_TRUE(_ring.try_publish(42));
+	TEST_ASSERT_EQUAL_INT(0, squads::arch::arch_thread_join(_pTask));
+	TEST_ASSERT_EQUAL_UINT(1, g_atomicDone.load());
+	TEST_ASSERT_EQUAL_INT(42, g_iReceived);
+}
+
+static void test_producer_woken_by_consume() {
+	static test_ring _ring;
+	g_pRing = &_ring;
+
+	for(int i = 0; i < 8; i++) TEST_ASSERT_TRUE(_ring.try_publish(i));
+	TEST_ASSERT_FALSE(_ring.try_publish(8));
+	_ring.consume(1, 8);
+
+	// The ring is full for consumer 0, claim() blocks until it consumes
+	squads::arch::thread_handle_t* _pTask = start_task(producer_task, nullptr);
+	let_task_block();
+	TEST_ASSERT_EQUAL_UINT(0, g_atomicDone.load());
+
+	_ring.consume(0, 1);
+	TEST_ASSERT_EQUAL_INT(0, squads::arch::arch_thread_join(_pTask));
+	TEST_ASSERT_EQUAL_UINT(1, g_atomicDone.load());
+	TEST_ASSERT_EQUAL_UINT(8, _ring.available(0));
+	TEST_ASSERT_EQUAL_UINT(1, _ring.available(1));
+}
+
+// Many small batches, a lost wakeup lets the test hang
+static const int StressCount = 20000;
+static squads::atomic::atomic_uint g_atomicErrors(0);
+
+static void stress_consumer_task(void* arg) {
+	squads::size_t _consumer = *static_cast<squads::size_t*>(arg);
+	int _next = 0;
+
+	while(_next < StressCount) {
+		test_ring::const_spans_type _spans = g_pRing->wait_for(_consumer);
+		squads::size_t _count = _spans.first.size;
+
+		for(squads::size_t i = 0; i < _count; i++) {
+			if(_spans.first.data[i] != _next++) g_atomicErrors.fetch_add(1);
+		}
+		g_pRing->consume(_consumer, _count);
+	}
+}
+
+static void test_blocking_stress() {
+	static test_ring _ring;
+	static squads::size_t _aConsumers[2] = { 0, 1 };
+	g_pRing = &_ring;
+	g_atomicErrors.store(0);
+
+	squads::arch::thread_handle_t* _aTasks[2];
+	for(int i = 0; i < 2; i++) _aTasks[i] = start_task(stress_consumer_task, &_aConsumers[i]);
+
+	for(int i = 0; i < StressCount; i++) {
+		test_ring::spans_type _spans = _ring.claim(1);
+		_spans.first.data[0] = i;
+		_ring.publish(1);
+	}
+	for(int i = 0; i < 2; i++) TEST_ASSERT_EQUAL_INT(0, squads::arch::arch_thread_join(_aTasks[i]));
+	TEST_ASSERT_EQUAL_UINT(0, g_atomicErrors.load());
+	TEST_ASSERT_EQUAL_UINT(0, _ring.available(0));
+	TEST_ASSERT_EQUAL_UINT(0, _ring.available(1));
+}
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_consumer_woken_by_publish);
+	RUN_TEST(test_producer_woken_by_consume);
+	RUN_TEST(test_blocking_stress);
+	UNITY_END();
+}
@@ -0,0 +1,59 @@
+/*
+*This file is part of the SQUADS Library (https://github.com/eotpcomic/squads ).
+*Copyright (c) 2023 Amber-Sophia Schroeck
+*
+*The SQUADS Library is free software; you can redistribute it and/or modify
+*it under the terms of the GNU Lesser General Public License as published by
+*the Free Software Foundation, version 2.1, or (at your option) any later version.
+
+*The SQUADS Library is distributed in the hope that it will be useful, but
+*WITHOUT ANY WARRANTY; without even the implied warranty of
+*MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+*General Public License for more details.
+*
+*You should have received a copy of the GNU Lesser General Public
+*License along with the SQUADS  Library; if not, see
+*<https://www.gnu.org/licenses/>.
+*/
+#include <unity.h>
+
+#include "core/string_view.hpp"
+#include "core/fixed_string.hpp"
+#include "core/string.hpp"
+
+static const char* const TestStrings[] = { "", "a", "abc", "12345678", "a longer string over more words" };
+static const int TestStringCount = sizeof(TestStrings) / sizeof(TestStrings[0]);
+
+void setUp() { }
+void tearDown() { }
+
+static void test_hash_view_fixed_string() {
+	for(int i = 0; i < TestStringCount; i++) {
+		squads::fixed_string<64> _str(TestStrings[i]);
+		TEST_ASSERT_EQUAL_UINT(_str.hash(), squads::string_view(_str).hash());
+		TEST_ASSERT_EQUAL_UINT(_str.hash(), squads::string_view(TestStrings[i]).hash());
+	}
+}
+
+static void test_hash_view_string() {
+	for(int i = 0; i < TestStringCount; i++) {
+		squads::string _str(TestStrings[i]);
+		TEST_ASSERT_EQUAL_UINT(_str.hash(), squads::string_view(_str).hash());
+		TEST_ASSERT_EQUAL_UINT(_str.hash(), squads::fixed_string<64>(TestStrings[i]).hash());
+	}
+}
+
+static void test_hash_never_zero() {
+	// The bytes of the empty string hash to 0, that is the not computed mark of the caches
+	TEST_ASSERT_EQUAL_UINT(0, squads::internal::hash_bytes("", 0));
+	TEST_ASSERT_TRUE(squads::string_view("").hash() != 0);
+	TEST_ASSERT_EQUAL_UINT(squads::string().hash(), squads::string_view().hash());
+}
+
+extern "C" void app_main() {
+	UNITY_BEGIN();
+	RUN_TEST(test_hash_view_fixed_string);
+	RUN_TEST(test_hash_view_string);
+	RUN_TEST(test_hash_never_zero);
+	UNITY_END();
+}